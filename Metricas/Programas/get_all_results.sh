@@ -12,7 +12,7 @@ usage() {
 
 # --- Variables por defecto --- #
 user_directories=()
-DIRECTORIOS_DEFAULT=("AXPY" "DWT_1D" "PCA" "PCA_REIMPL" "DCT")
+DIRECTORIOS_DEFAULT=("AXPY" "BLAS1" "DWT_1D" "PCA" "PCA_REIMPL" "DCT")
 emulate_qemu=false
 
 # --- Procesar argumentos --- #
@@ -83,7 +83,8 @@ else
 fi
 
 # FLAGS comunes para los programas
-SEED_FLAGS="-s 1234"
+# Entradas con rand() de la libc (-l): son las de los CSV de referencia de Metricas/Datos
+SEED_FLAGS="-s 1234 -l"
 case "$ARCH" in
     x86_64|amd64|x64)
         echo -e "\nStarting..."
@@ -12,7 +12,7 @@ usage() {
 
 # --- Variables por defecto --- #
 user_directories=()
-DIRECTORIOS_DEFAULT=("AXPY" "DWT_1D" "PCA" "PCA_REIMPL" "DCT")
+DIRECTORIOS_DEFAULT=("AXPY" "BLAS1" "DWT_1D" "PCA" "PCA_REIMPL" "DCT")
 
 # FLAGS comunes para los programas
 FLAGS="--show_plot false --save_plot false --save_data true"
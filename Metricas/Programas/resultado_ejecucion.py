@@ -5,6 +5,9 @@ import argparse
 from pathlib import Path
 import subprocess
 import platform
+import tempfile
+
+from volcado import leer_volcado, secciones
 
 
 def get_cpu_vendor():
@@ -30,13 +33,60 @@ def get_cpu_vendor():
     
     return "Unknown"
 
-def medir_resultados(programa, n, seed, use_qemu, matrix_mode, is_origin_data):
+def medir_resultados_volcado(programa, n, seed, use_qemu, matrix_mode, is_origin_data, rand_libc=False):
+    """
+    Ejecuta el programa con --dump y lee los datos del volcado binario (ver volcado.py) en
+    lugar de analizar la salida de -v, que con n grandes ocupa varias veces más y es lenta.
+    """
+    script_dir = Path(__file__).resolve().parent
+    with tempfile.TemporaryDirectory(dir=script_dir) as directorio:
+        ruta_volcado = Path(directorio) / "volcado.bin"
+        comando = [programa, str(n), str(seed), "--dump", str(ruta_volcado)]
+        if rand_libc:
+            comando.append("--rand-libc")
+        if use_qemu:
+            comando = ["qemu-aarch64"] + comando
+
+        resultado = subprocess.run(
+            comando,
+            stdout=subprocess.DEVNULL,
+            stderr=subprocess.PIPE,
+            text=True,
+        )
+        if resultado.returncode != 0:
+            print(f"Error al ejecutar {programa}: {resultado.stderr.strip()}")
+            return None
+
+        try:
+            volcado = leer_volcado(ruta_volcado)
+        except (OSError, ValueError) as e:
+            print(f"Error: {e}")
+            return None
+
+        esperados = n * n if matrix_mode else n
+        datos = {}
+        for clave, nombre in (('origin_data', 'entrada'), ('exec_results', 'resultado')):
+            datos[clave] = []
+            if clave == 'origin_data' and not is_origin_data:
+                continue
+            for array in secciones(volcado, nombre):
+                if array.size != esperados:
+                    print(f"Error en la sección {nombre}: {array.size} elementos (esperados: {esperados})")
+                    return None
+                # Copia en double, igual que los valores leídos del texto, antes de borrar el fichero
+                datos[clave].append(array.astype(float).ravel())
+
+        return datos
+
+def medir_resultados(programa, n, seed, use_qemu, matrix_mode, is_origin_data, rand_libc=False):
     try:
         # Determinar el comando a ejecutar
         if use_qemu:
             comando = ["qemu-aarch64", programa, str(n), str(seed), "-v"]
         else:
             comando = [programa, str(n), str(seed), "-v"]
+        if rand_libc:
+            comando.append("--rand-libc")
         
         # Ejecutar el programa
         resultado = subprocess.run(
@@ -166,7 +216,7 @@ def move_generated_files(output_files, is_origin_data):
 
     return moved_files
 
-def save_to_csv(results, programa, n, seed, matrix_mode, is_origin_data, use_qemu):
+def save_to_csv(results, programa, n, seed, matrix_mode, is_origin_data, use_qemu, rand_libc=False):
     """Guarda los resultados de la ejecución en archivos CSV."""
     script_dir = Path(__file__).resolve().parent
     programa_nombre = Path(programa).stem
@@ -174,10 +224,12 @@ def save_to_csv(results, programa, n, seed, matrix_mode, is_origin_data, use_qem
 
     # Añadir sufijo QEMU si se usa emulación
     qemu_suffix = "_QEMU" if use_qemu else ""
+    # Los CSV de referencia (sin sufijo) son de rand() de la libc; los de Philox no los sobrescriben
+    generador_suffix = "" if rand_libc else "_philox"
 
     # 1. Guardar datos de ORIGEN solo si se usa el flag -o y hay datos disponibles
     if is_origin_data and results['origin_data']:
-        origin_file = script_dir / f"source_{programa_nombre}_n{n}_seed{seed}{qemu_suffix}.csv"
+        origin_file = script_dir / f"source_{programa_nombre}_n{n}_seed{seed}{generador_suffix}{qemu_suffix}.csv"
         with open(origin_file, 'w', newline='') as csvfile:
             writer = csv.writer(csvfile)
             if matrix_mode:
@@ -198,7 +250,7 @@ def save_to_csv(results, programa, n, seed, matrix_mode, is_origin_data, use_qem
 
     # 2. Guardar RESULTADOS siempre que existan (comportamiento base)
     if results['exec_results']:
-        results_file = script_dir / f"{programa_nombre}_n{n}_seed{seed}{qemu_suffix}.csv"
+        results_file = script_dir / f"{programa_nombre}_n{n}_seed{seed}{generador_suffix}{qemu_suffix}.csv"
         with open(results_file, 'w', newline='') as csvfile:
             writer = csv.writer(csvfile)
             if matrix_mode:
@@ -228,6 +280,8 @@ def parse_arguments():
     parser.add_argument('-q', '--use_qemu', action='store_true', help="Ejecutar el programa con qemu-aarch64")
     parser.add_argument('-m', '--matrix', action='store_true', help="Modo matriz (n x n)")
     parser.add_argument('-o', '--origin', default=False, action='store_true', help="Se están extraendo resultados previos a la ejecución del programa")
+    parser.add_argument('-t', '--texto', default=False, action='store_true', help="Leer la salida de texto de -v en lugar del volcado binario (--dump)")
+    parser.add_argument('-l', '--rand-libc', default=False, action='store_true', help="Generar los datos con rand() de la libc, como los CSV de referencia anteriores a Philox (--rand-libc)")
     return parser.parse_args()
 
 def main():
@@ -235,13 +289,15 @@ def main():
     args = parse_arguments()
     
     # Capturar resultados (ahora con ambos conjuntos de datos)
-    results = medir_resultados(
+    medir = medir_resultados if args.texto else medir_resultados_volcado
+    results = medir(
         args.programa,
         args.n_value,
         args.seed,
         args.use_qemu,
         args.matrix,
-        args.origin
+        args.origin,
+        args.rand_libc
     )
 
     if results:
@@ -253,7 +309,8 @@ def main():
             args.seed, 
             args.matrix, 
             args.origin,
-            args.use_qemu
+            args.use_qemu,
+            args.rand_libc
         )
         
         # Mover archivos generados
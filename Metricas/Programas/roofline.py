@@ -0,0 +1,320 @@
+# Informe roofline: sitúa las ejecuciones de los benchmarks respecto a los techos de memoria y
+# cómputo medidos con Programas/ROOFLINE (STREAM triad y pico FMA de cada tipo de dato)
+import re
+import csv
+import argparse
+import platform
+import subprocess
+from pathlib import Path
+from datetime import datetime
+
+import matplotlib.pyplot as plt
+
+
+# Intensidad aritmética de cada kernel: por cada línea "Tiempo de ejecucion:" que imprime el
+# programa (en su orden) se registran las operaciones en coma flotante y los elementos que se
+# mueven entre memoria y procesador en función de n. Los bytes son elementos * tamaño del tipo.
+#
+# Los elementos son el tráfico mínimo (leer las entradas una vez y escribir las salidas una vez);
+# las lecturas repetidas que sirve la caché no cuentan, como en el modelo roofline clásico.
+
+def _axpy(n):
+    # y = a*x + y: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+    return [("axpy", 2 * n, 3 * n)]
+
+def _blas1(n):
+    return [
+        ("dot", 2 * n, 2 * n),    # lee x e y
+        ("nrm2", 2 * n, n),       # lee x
+        ("scal", n, 2 * n),       # lee y escribe y
+        ("swap", 0, 4 * n),       # lee x e y y escribe ambos
+        ("copy", 0, 2 * n),       # lee x y escribe y
+    ]
+
+def _dwt_1d(n):
+    # Filtros paso bajo y paso alto aplicados a cada elemento (1 FMA por coeficiente):
+    # LeGall 5/3 con 5 + 3 coeficientes y CDF 9/7 con 9 + 7. Lee la señal y la sobrescribe.
+    return [
+        ("legall53", 2 * (5 + 3) * n, 2 * n),
+        ("cdf97", 2 * (9 + 7) * n, 2 * n),
+    ]
+
+def _dct(n):
+    # Por cada par (k, i): rotación del ángulo por recurrencia (4 productos y 2 sumas) y
+    # acumulación (1 FMA), en los carriles de la suma directa (ver Programas/common/include/fft.h).
+    # Lee la entrada y la tabla de cosenos (2n + 1 valores) y escribe la salida.
+    return [("dct", 8 * n * n, 4 * n + 1)]
+
+def _dct_2d(n):
+    # Imagen n x n en bloques de 8 x 8: dos pasadas de producto por la matriz del bloque
+    # (8 FMA por píxel y pasada). Cada transformada lee una imagen y escribe otra.
+    return [
+        ("dct", 4 * 8 * n * n, 2 * n * n),
+        ("idct", 4 * 8 * n * n, 2 * n * n),
+    ]
+
+def _pca(n):
+    # Matriz n x n: estandarización (~5n^2), covarianza (2n^3), ssyev con vectores propios
+    # (~9n^3: reducción tridiagonal, formación de Q e iteración QR) y proyección con GEMM
+    # (2n^3). Lee la matriz y escribe la proyección.
+    return [("pca", 13 * n**3 + 5 * n**2, 2 * n * n)]
+
+INTENSIDADES = {
+    'axpy': _axpy,
+    'blas1': _blas1,
+    'dwt_1d': _dwt_1d,
+    'dct_2d': _dct_2d,
+    'dct': _dct,
+    'pca_reimpl': _pca,
+    'pca': _pca,
+}
+
+# Bytes por elemento según el formato de almacenamiento (MX: 1 byte por elemento y un byte de
+# escala compartido por cada bloque de 32)
+TAMANHOS = [
+    ('_MXFP8', 1 + 1 / 32),
+    ('_MXINT8', 1 + 1 / 32),
+    ('_FP8', 1),
+    ('_FP16', 2),
+    ('_BF16', 2),
+    ('_FP32', 4),
+]
+
+
+def get_cpu_vendor():
+    """Detecta el fabricante del CPU específicamente para sistemas Linux"""
+    try:
+        with open('/proc/cpuinfo', 'r') as f:
+            for line in f:
+                if line.startswith('vendor_id'):
+                    vendor_str = line.split(':', 1)[1].strip()
+
+                    if any(keyword in vendor_str.lower() for keyword in ['intel', 'genuineintel']):
+                        return "Intel"
+
+                    if any(keyword in vendor_str.lower() for keyword in ['amd', 'authenticamd']):
+                        return "AMD"
+
+                    return vendor_str
+
+    except FileNotFoundError:
+        return "Unknown (File not found)"
+
+    return "Unknown"
+
+def familia_programa(nombre_programa):
+    """Devuelve el prefijo registrado en INTENSIDADES (el más largo que coincida)."""
+    for prefijo in sorted(INTENSIDADES, key=len, reverse=True):
+        if nombre_programa.startswith(prefijo + '_'):
+            return prefijo
+    return None
+
+def tamanho_elemento(nombre_programa):
+    for sufijo, tamanho in TAMANHOS:
+        if sufijo in nombre_programa:
+            return tamanho
+    return 4
+
+def programa_techos(nombre_programa, directorio_techos):
+    """
+    Elige el ejecutable de Programas/ROOFLINE que corresponde al programa: el del mismo tipo
+    (p. ej. dct_FP16 -> roofline_FP16, que escoge la misma variante de ISA en tiempo de
+    ejecución) o, con un sufijo que no tenga equivalente, el del tipo base. FP8 y MX operan en float, por lo que usan roofline_FP32.
+    """
+    directorio = Path(directorio_techos)
+    familia = familia_programa(nombre_programa)
+    resto = nombre_programa[len(familia) + 1:] if familia else nombre_programa
+    extension = '.out' if resto.endswith('.out') else ''
+    resto = resto[:-len(extension)] if extension else resto
+
+    if resto.startswith(('FP8', 'MX')):
+        candidatos = ['FP32']
+    else:
+        tipo = re.match(r'(FP16_ARM|FP16|BF16|FP32)', resto)
+        base = tipo.group(1) if tipo else 'FP32'
+        candidatos = [resto, base] if resto != base else [base]
+
+    for candidato in candidatos:
+        ruta = directorio / f"roofline_{candidato}{extension}"
+        if ruta.is_file():
+            return ruta
+    return None
+
+def ejecutar(comando):
+    resultado = subprocess.run(comando, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    if resultado.returncode != 0:
+        raise RuntimeError(f"{' '.join(comando)} terminó con código {resultado.returncode}: {resultado.stderr.strip()}")
+    return resultado.stdout
+
+def medir_techos(programa_roofline, prefijo, opciones):
+    """Ejecuta el programa de techos y devuelve (GB/s, GFLOP/s)."""
+    salida = ejecutar([*prefijo, str(programa_roofline), *opciones])
+    ancho_banda = re.search(r'Techo memoria \(triad\):\s*([0-9.eE+-]+)', salida)
+    pico = re.search(r'Techo computo \(fma\):\s*([0-9.eE+-]+)', salida)
+    if ancho_banda is None or pico is None:
+        raise RuntimeError(f"No se encontraron los techos en la salida de {programa_roofline}")
+    return float(ancho_banda.group(1)), float(pico.group(1))
+
+def medir_programa(programa, n, seed, prefijo, opciones):
+    """
+    Tiempo mínimo de cada medida, el mismo estadístico con el que Programas/ROOFLINE calcula los
+    techos. La línea "Tiempo de ejecucion:" lleva la mediana; con varias repeticiones la sigue
+    una línea "Estadisticas:" cuyo mínimo la sustituye.
+    """
+    salida = ejecutar([*prefijo, programa, *opciones, str(n), str(seed)])
+    tiempos = []
+    for linea in salida.split('\n'):
+        if 'Tiempo de ejecucion:' in linea:
+            tiempos.append(float(linea.split(':')[1]))
+        elif linea.startswith('Estadisticas:') and tiempos:
+            tiempos[-1] = float(re.search(r'min\s+([0-9.eE+-]+)', linea).group(1))
+    return tiempos
+
+def analizar(programa, n, tiempos, ancho_banda, pico):
+    """Calcula intensidad, rendimiento y distancia al techo de cada medida del programa."""
+    nombre = Path(programa).name
+    familia = familia_programa(nombre)
+    medidas = INTENSIDADES[familia](n)
+    bytes_elemento = tamanho_elemento(nombre)
+
+    if len(tiempos) < len(medidas):
+        raise RuntimeError(f"{nombre}: {len(tiempos)} tiempos para {len(medidas)} medidas")
+
+    filas = []
+    for (medida, flops, elementos), tiempo in zip(medidas, tiempos):
+        bytes_movidos = elementos * bytes_elemento
+        intensidad = flops / bytes_movidos
+        gflops = flops / tiempo / 1e9
+        gbs = bytes_movidos / tiempo / 1e9
+        # Techo alcanzable con esta intensidad: el menor de memoria y cómputo
+        techo = min(pico, intensidad * ancho_banda)
+        limite = "memoria" if intensidad * ancho_banda < pico else "computo"
+        # Fracción del techo: en kernels sin operaciones (swap, copy) se usa el ancho de banda
+        fraccion = gflops / techo if flops > 0 else gbs / ancho_banda
+        filas.append({
+            'programa': nombre, 'medida': medida, 'n': n, 'tiempo': tiempo,
+            'flops': flops, 'bytes': bytes_movidos, 'intensidad': intensidad,
+            'gflops': gflops, 'gbs': gbs, 'techo_gflops': techo, 'limite': limite,
+            'fraccion_techo': fraccion, 'ancho_banda': ancho_banda, 'pico': pico,
+        })
+    return filas
+
+def imprimir_tabla(filas):
+    print(f"{'programa':<34} {'medida':<9} {'n':>10} {'I (F/B)':>9} {'GFLOP/s':>10} {'GB/s':>9} {'techo':>10} {'límite':>8} {'% techo':>8}")
+    for f in filas:
+        print(f"{f['programa']:<34} {f['medida']:<9} {f['n']:>10} {f['intensidad']:>9.3f} {f['gflops']:>10.3f} "
+              f"{f['gbs']:>9.3f} {f['techo_gflops']:>10.3f} {f['limite']:>8} {100 * f['fraccion_techo']:>7.1f}%")
+
+def carpeta_destino():
+    """Carpeta de resultados según la arquitectura, como en el resto de scripts de Metricas."""
+    base_dir = Path(__file__).resolve().parent / ".." / "Datos" / "Roofline"
+    arquitectura = platform.machine()
+    if arquitectura in ["x86_64", "amd64", "AMD64"]:
+        vendor = get_cpu_vendor()
+        return base_dir / vendor if vendor not in ["Unknown", "Unknown (File not found)"] else base_dir / "x86_64"
+    if arquitectura in ["aarch64", "arm64"]:
+        return base_dir / "ARM"
+    return Path(__file__).resolve().parent
+
+def guardar_csv(filas, ruta):
+    ruta.parent.mkdir(parents=True, exist_ok=True)
+    with open(ruta, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=list(filas[0].keys()))
+        writer.writeheader()
+        writer.writerows(filas)
+    print(f"Datos guardados en {ruta}")
+
+def plot_roofline(filas):
+    """Gráfica log-log con los techos de cada tipo y un punto por medida."""
+    fig, ax = plt.subplots(figsize=(12, 7))
+    ax.set_xscale('log')
+    ax.set_yscale('log')
+    ax.grid(True, which='major', linestyle='--', linewidth=0.5, color='gray', alpha=0.7)
+    ax.set_xlabel("Intensidad aritmética (FLOP/byte)", fontsize=12)
+    ax.set_ylabel("Rendimiento (GFLOP/s)", fontsize=12)
+
+    con_flops = [f for f in filas if f['flops'] > 0]
+    if not con_flops:
+        return fig, ax
+    x_min = min(f['intensidad'] for f in con_flops) / 4
+    x_max = max(f['intensidad'] for f in con_flops) * 4
+
+    techos = sorted({(f['ancho_banda'], f['pico']) for f in con_flops})
+    for ancho_banda, pico in techos:
+        codo = pico / ancho_banda
+        xs = [x_min, min(max(codo, x_min), x_max), x_max]
+        ys = [min(pico, x * ancho_banda) for x in xs]
+        ax.plot(xs, ys, linestyle='-', color='gray', alpha=0.8)
+        ax.text(x_max, pico, f' {pico:.1f} GFLOP/s | {ancho_banda:.1f} GB/s', va='bottom', ha='right', fontsize=8)
+
+    for f in con_flops:
+        ax.plot(f['intensidad'], f['gflops'], marker='o', linestyle='')
+        ax.annotate(f"{f['programa']}:{f['medida']}", (f['intensidad'], f['gflops']),
+                    textcoords='offset points', xytext=(4, 4), fontsize=8)
+    return fig, ax
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description="Informe roofline de los benchmarks")
+    parser.add_argument("programas", nargs='+', help="Ejecutables a situar en el roofline")
+    parser.add_argument("-n", "--n_value", type=int, required=True, help="Tamaño con el que se ejecuta cada programa")
+    parser.add_argument("--seed", type=int, default=1234)
+    parser.add_argument("--techos", default=str(Path(__file__).resolve().parent / ".." / ".." / "Programas" / "ROOFLINE"),
+                        help="Directorio con los ejecutables roofline_<tipo> (predeterminado: Programas/ROOFLINE)")
+    parser.add_argument("--calentamiento", type=int, default=1, help="Opción -w de los programas (predeterminado: 1)")
+    parser.add_argument("--repeticiones", type=int, default=10, help="Opción -r de los programas (predeterminado: 10)")
+    parser.add_argument("--hilos", type=int, default=1, help="Hilos de los techos, opción -t (predeterminado: 1, como los benchmarks)")
+    parser.add_argument("-q", "--use_qemu", action='store_true', help="Ejecutar con qemu-aarch64")
+    parser.add_argument("--save_data", default=False, action='store_true', help="Guardar la tabla en CSV")
+    parser.add_argument("--save_plot", default=False, action='store_true', help="Guardar la gráfica en PNG")
+    parser.add_argument("--show_plot", default=False, action='store_true', help="Mostrar la gráfica en pantalla")
+    return parser.parse_args()
+
+def main():
+    args = parse_arguments()
+    prefijo = ["qemu-aarch64"] if args.use_qemu else []
+    opciones = ['-w', str(args.calentamiento), '-r', str(args.repeticiones)]
+
+    techos_medidos = {}
+    filas = []
+    for programa in args.programas:
+        nombre = Path(programa).name
+        if familia_programa(nombre) is None:
+            print(f"{nombre}: kernel sin intensidad registrada, se omite")
+            continue
+
+        ruta_techos = programa_techos(nombre, args.techos)
+        if ruta_techos is None:
+            print(f"{nombre}: no se encontró el programa de techos en {args.techos}, se omite")
+            continue
+        if ruta_techos not in techos_medidos:
+            techos_medidos[ruta_techos] = medir_techos(ruta_techos, prefijo, opciones + ['-t', str(args.hilos)])
+            print(f"{ruta_techos.name}: {techos_medidos[ruta_techos][0]:.3f} GB/s, {techos_medidos[ruta_techos][1]:.3f} GFLOP/s")
+        ancho_banda, pico = techos_medidos[ruta_techos]
+
+        try:
+            tiempos = medir_programa(programa, args.n_value, args.seed, prefijo, opciones)
+            filas.extend(analizar(programa, args.n_value, tiempos, ancho_banda, pico))
+        except RuntimeError as e:
+            print(f"Error: {e}")
+
+    if not filas:
+        print("No hay resultados.")
+        return
+
+    imprimir_tabla(filas)
+
+    nombre_base = f"roofline_n{args.n_value}_{datetime.now().strftime('%Y%m%d_%H%M%S')}"
+    if args.save_data:
+        guardar_csv(filas, carpeta_destino() / f"{nombre_base}.csv")
+    if args.save_plot or args.show_plot:
+        fig, _ = plot_roofline(filas)
+        if args.save_plot:
+            ruta = carpeta_destino() / f"{nombre_base}.png"
+            ruta.parent.mkdir(parents=True, exist_ok=True)
+            fig.savefig(ruta, bbox_inches='tight')
+            print(f"Gráfica guardada en {ruta}")
+        if args.show_plot:
+            plt.show()
+
+if __name__ == "__main__":
+    main()
@@ -81,6 +81,9 @@ def get_cache_info():
 # Obtener límites de memoria dinámicamente
 L1_CACHE_LIMIT, L2_CACHE_LIMIT, L3_CACHE_LIMIT, RAM_LIMITS = get_cache_info()
 
+# Tamaño en bytes de cada elemento según el tipo detectado por detectar_tipo_dato
+BYTES_POR_TIPO = {"byte": 1, "half": 2, "float": 4}
+
 def calcular_n_para_memoria(memoria_bytes, tipo_dato, nombre_programa):
     """
     Calcula el valor de n necesario para alcanzar una cantidad de memoria dada,
@@ -88,18 +91,18 @@ def calcular_n_para_memoria(memoria_bytes, tipo_dato, nombre_programa):
 
     Parámetros:
         memoria_bytes (int): Cantidad de memoria en bytes.
-        tipo_dato (str): Tipo de dato ("half" u otro).
+        tipo_dato (str): Tipo de dato ("byte", "half" u otro).
         nombre_programa (str): Nombre del programa específico.
 
     Retorna:
         int: Valor de n calculado.
     """
     # Determinar el tamaño en bytes de cada elemento según el tipo de dato
-    bytes_por_elemento = 2 if tipo_dato == "half" else 4
+    bytes_por_elemento = BYTES_POR_TIPO.get(tipo_dato, 4)
 
     # Caso especial para matrices cuadradas (PCA)
     if 'pca' in nombre_programa.lower():
-        bytes_por_elemento = 2 if tipo_dato == "half" else 4
+        bytes_por_elemento = BYTES_POR_TIPO.get(tipo_dato, 4)
         
         # Ecuación: 4n² + n = memoria_bytes / bytes_por_elemento
         total_memoria = memoria_bytes / bytes_por_elemento
@@ -118,6 +121,10 @@ def calcular_n_para_memoria(memoria_bytes, tipo_dato, nombre_programa):
         
         return int(n)
 
+    # DCT 2D: imagen n x n de entrada, coeficientes y reconstrucción
+    elif "dct_2d" in nombre_programa.lower():
+        return int(math.sqrt(memoria_bytes / (3 * bytes_por_elemento)))
+
     # Manejo de casos específicos según el programa
     elif "dwt_1d" in nombre_programa.lower():
         # Dos arrays de tamaño n (tipo principal) + kernels (16 doubles)
@@ -133,14 +140,16 @@ def calcular_n_para_memoria(memoria_bytes, tipo_dato, nombre_programa):
 
 def detectar_tipo_dato(nombre_programa):
     """Detecta el tipo de dato basándose en sufijos en el nombre."""
+    if any(sufijo in nombre_programa for sufijo in ('_FP8', '_MX')):
+        return "byte"
     if any(sufijo in nombre_programa for sufijo in ('_FP16', '_FP16_ARM', '_BF16')):
         return "half"
     return "float"  # Por defecto o si contiene _FP32
 
-def detectar_num_tiempos(programa, n_minimo, seed):
+def detectar_num_tiempos(programa, n_minimo, seed, opciones=()):
     try:
         proceso = subprocess.run(
-            [programa, str(n_minimo), str(seed)],
+            [programa, *opciones, str(n_minimo), str(seed)],
             stdout=subprocess.PIPE,
             stderr=subprocess.PIPE,
             text=True,
@@ -151,9 +160,14 @@ def detectar_num_tiempos(programa, n_minimo, seed):
         print(f"Error detectando tiempos: {e}")
         return 1
 
-def medir_tiempos(programa, valores_n, seed, num_ejecuciones=11):
+def medir_tiempos(programa, valores_n, seed, num_ejecuciones=11, opciones=()):
+    """
+    Ejecuta num_ejecuciones procesos por cada n y guarda la mediana de cada tiempo.
+    opciones se pasa al programa antes del tamaño (p. ej. ['-w', '3', '-r', '20'] para que el
+    propio programa repita la medida y escriba su mediana en "Tiempo de ejecucion:").
+    """
     n_minimo = min(valores_n)
-    num_tiempos = detectar_num_tiempos(programa, n_minimo, seed)
+    num_tiempos = detectar_num_tiempos(programa, n_minimo, seed, opciones)
     print(f"Tiempos detectados por ejecución: {num_tiempos}")
     
     tiempos_por_n = []
@@ -165,7 +179,7 @@ def medir_tiempos(programa, valores_n, seed, num_ejecuciones=11):
             try:
                 # Ejecutar el programa con subprocess.run()
                 resultado = subprocess.run(
-                    [programa, str(n), str(seed)],
+                    [programa, *opciones, str(n), str(seed)],
                     stdout=subprocess.PIPE,
                     stderr=subprocess.PIPE,
                     text=True,
@@ -196,6 +210,47 @@ def medir_tiempos(programa, valores_n, seed, num_ejecuciones=11):
     
     return tiempos_por_n, num_tiempos
 
+def medir_tiempos_barrido(programa, valores_n, seed, num_ejecuciones=11, opciones=()):
+    """
+    Igual que medir_tiempos, pero cada ejecución recorre todos los n en un único proceso con
+    --sweep y lee la tabla "barrido,medida,n,mediana,..." que imprime el programa. Cada medida
+    (kernel o rutina) ocupa la misma posición que su "Tiempo de ejecucion:" en medir_tiempos.
+    """
+    lista = ','.join(str(n) for n in valores_n)
+    medidas = []
+    tiempos = {}  # (medida, n) -> tiempos de las ejecuciones
+
+    for _ in range(num_ejecuciones):
+        try:
+            resultado = subprocess.run(
+                [programa, *opciones, '--sweep', lista, str(seed)],
+                stdout=subprocess.PIPE,
+                stderr=subprocess.PIPE,
+                text=True,
+            )
+            for linea in resultado.stdout.split('\n'):
+                campos = linea.strip().split(',')
+                if len(campos) < 4 or campos[0] != 'barrido' or campos[1] == 'medida':
+                    continue
+                medida, n, mediana = campos[1], int(campos[2]), float(campos[3])
+                if medida not in medidas:
+                    medidas.append(medida)
+                tiempos.setdefault((medida, n), []).append(mediana)
+        except Exception as e:
+            print(f"Error en el barrido: {e}")
+            continue
+
+    num_tiempos = max(len(medidas), 1)
+    print(f"Tiempos detectados por ejecución: {num_tiempos}")
+
+    tiempos_por_n = []
+    for n in valores_n:
+        medianas = [statistics.median(tiempos[(m, n)]) if (m, n) in tiempos else None for m in medidas] or [None]
+        tiempos_por_n.append(medianas)
+        print(f"n={n}: {medianas}")
+
+    return tiempos_por_n, num_tiempos
+
 def get_cpu_vendor():
     """Detecta el fabricante del CPU específicamente para sistemas Linux"""
     try:
@@ -300,12 +355,12 @@ def guardar_datos(nombre_programa, valores_n, tiempos_por_n, num_tiempos, fig=No
         png_path = f"grafico_{nombre_archivo_base}.png"
         guardar_datos_grafica(png_path, fig)
 
-def obtener_datos(programa, valores_n, seed, num_ejecuciones=11):
+def obtener_datos(programa, valores_n, seed, num_ejecuciones=11, opciones=()):
     """
     Mide los tiempos de ejecución para los valores de n dados.
     Devuelve una tupla con (tiempos_por_n, num_tiempos).
     """
-    tiempos_por_n, num_tiempos = medir_tiempos(programa, valores_n, seed, num_ejecuciones)
+    tiempos_por_n, num_tiempos = medir_tiempos(programa, valores_n, seed, num_ejecuciones, opciones)
     return tiempos_por_n, num_tiempos
 
 def plot_grafica(valores_n, tiempos_por_n, num_tiempos, tipo_dato, nombre_programa):
@@ -363,6 +418,12 @@ def parse_arguments():
     parser.add_argument("programa", help="Ruta al ejecutable a probar")
     parser.add_argument("--seed", type=int, default=1234)
     parser.add_argument("--num_ejecuciones", type=int, default=11)
+    parser.add_argument("--calentamiento", type=int, default=0,
+                        help="Iteraciones de calentamiento dentro de cada proceso, opción -w (predeterminado: 0)")
+    parser.add_argument("--repeticiones", type=int, default=1,
+                        help="Repeticiones medidas dentro de cada proceso, opción -r (predeterminado: 1)")
+    parser.add_argument("--sweep", default=False, action='store_true',
+                        help="Medir todos los n en un único proceso con --sweep (predeterminado: False)")
     parser.add_argument("--save_data", type=lambda x: x.lower() == 'true', default=False, 
                         help="Guardar datos en CSV (predeterminado: False)")
     parser.add_argument("--save_plot", type=lambda x: x.lower() == 'true', default=False, 
@@ -384,7 +445,8 @@ def main():
     tipo_dato = detectar_tipo_dato(nombre_programa)
     
     # Determinar el tipo de prueba basándose en el nombre del programa
-    tipo_prueba = "matrix" if "pca" in nombre_programa.lower() else "array"
+    # (la DCT 2D recibe el lado de la imagen, igual que PCA el de la matriz)
+    tipo_prueba = "matrix" if any(p in nombre_programa.lower() for p in ("pca", "dct_2d")) else "array"
 
     # Valores predefinidos
     n_float = [
@@ -424,8 +486,16 @@ def main():
     print(f"Configuración detectada: {tipo_prueba.upper()} - {tipo_dato.upper()}")
     print(f"Valores de n: {valores_n}")
 
+    # Repeticiones dentro del proceso (solo se pasan si difieren de una única medida)
+    opciones = []
+    if args.calentamiento != 0 or args.repeticiones != 1:
+        opciones = ['-w', str(args.calentamiento), '-r', str(args.repeticiones)]
+
     # Obtener datos
-    tiempos_por_n, num_tiempos = medir_tiempos(args.programa, valores_n, args.seed, args.num_ejecuciones)
+    if args.sweep:
+        tiempos_por_n, num_tiempos = medir_tiempos_barrido(args.programa, valores_n, args.seed, args.num_ejecuciones, opciones)
+    else:
+        tiempos_por_n, num_tiempos = medir_tiempos(args.programa, valores_n, args.seed, args.num_ejecuciones, opciones)
 
     # Generar la gráfica
     fig, ax = plot_grafica(valores_n, tiempos_por_n, num_tiempos, tipo_dato, nombre_programa)
@@ -0,0 +1,69 @@
+# Lectura de los volcados binarios que generan los programas con --dump <ruta>
+# (formato descrito en Programas/common/include/volcado.h)
+import struct
+from pathlib import Path
+
+import numpy as np
+
+MAGIA = b"BRPFVOL1"
+VERSION = 1
+ALINEAMIENTO = 64
+TAM_CABECERA = 128
+TAM_CABECERA_SECCION = 64
+
+
+def _texto(campo):
+    return campo.split(b"\0", 1)[0].decode("ascii", errors="replace")
+
+
+def leer_volcado(ruta):
+    """
+    Abre un volcado con mmap y devuelve un diccionario con la cabecera y las secciones.
+
+    Cada sección es un par (nombre, array) en el orden en que el programa la escribió; el array
+    es float32 de forma (columnas,) si filas == 1 o (filas, columnas) en otro caso y está
+    respaldado por el fichero, de modo que solo se leen del disco las partes que se usan.
+    """
+    ruta = Path(ruta)
+    tam_fichero = ruta.stat().st_size
+
+    with open(ruta, "rb") as f:
+        cabecera = f.read(TAM_CABECERA)
+    if len(cabecera) != TAM_CABECERA or cabecera[:8] != MAGIA:
+        raise ValueError(f"{ruta} no es un volcado válido")
+
+    version, num_secciones, n, seed = struct.unpack_from("<IIQI", cabecera, 8)
+    if version != VERSION:
+        raise ValueError(f"Versión de volcado no soportada: {version}")
+
+    volcado = {
+        "n": n,
+        "seed": seed,
+        "tipo": _texto(cabecera[32:64]),
+        "kernel": _texto(cabecera[64:96]),
+        "implementacion": _texto(cabecera[96:128]),
+        "secciones": [],
+    }
+
+    desplazamiento = TAM_CABECERA
+    for _ in range(num_secciones):
+        seccion = np.memmap(ruta, dtype=np.uint8, mode="r", offset=desplazamiento, shape=(TAM_CABECERA_SECCION,))
+        nombre = _texto(seccion[:40].tobytes())
+        filas, columnas = struct.unpack_from("<QQ", seccion.tobytes(), 40)
+        desplazamiento += TAM_CABECERA_SECCION
+
+        num_valores = filas * columnas
+        if desplazamiento + 4 * num_valores > tam_fichero:
+            raise ValueError(f"Volcado truncado en la sección {nombre}")
+        forma = (columnas,) if filas == 1 else (filas, columnas)
+        datos = np.memmap(ruta, dtype="<f4", mode="r", offset=desplazamiento, shape=forma)
+        volcado["secciones"].append((nombre, datos))
+
+        desplazamiento += -(-4 * num_valores // ALINEAMIENTO) * ALINEAMIENTO
+
+    return volcado
+
+
+def secciones(volcado, nombre):
+    """Devuelve los arrays de las secciones con ese nombre ("entrada" o "resultado") en orden."""
+    return [datos for nombre_seccion, datos in volcado["secciones"] if nombre_seccion == nombre]
@@ -2,54 +2,757 @@
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifdef __aarch64__
 #include <arm_bf16.h>
 #endif
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/cache_info.h"
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
 
 #define N_SMALL 5
 
-// Función AXPY
-void axpy(int n, __bf16 a, __bf16 *x, __bf16 *y) {
-    for (int i = 0; i < n; i++) {
+// Número de elementos __bf16 que se ensanchan a un registro float de 256 bits
+#define LANES_AVX2 8
+// Número de elementos __bf16 en un registro de 512 bits
+#define LANES_AVX512 32
+
+// Función AXPY (versión escalar, empleada como referencia y como fallback)
+void axpy_escalar(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    for (int64_t i = 0; i < n; i++) {
         y[i] = a * x[i] + y[i];
     }
 }
 
+/*
+    Función AXPY por lotes (versión escalar): y_b = alpha[b] * x_b + y_b para batch vectores
+    independientes de n elementos. Los vectores se guardan intercalados: el elemento i del
+    vector b está en i * stride + b (stride >= batch), de modo que el bucle interno recorre el
+    lote con accesos contiguos y los kernels vectoriales trabajan a lo ancho del lote en lugar
+    de a lo largo de vectores cortos.
+*/
+void axpy_batched_escalar(int batch, int n, const __bf16 *alpha, const __bf16 *x, __bf16 *y, int stride) {
+    for (int i = 0; i < n; i++) {
+        const __bf16 *xi = x + (size_t)i * stride;
+        __bf16 *yi = y + (size_t)i * stride;
+        for (int b = 0; b < batch; b++) {
+            yi[b] = alpha[b] * xi[b] + yi[b];
+        }
+    }
+}
+
+#ifdef __x86_64__
+
+// Ensancha un bfloat16 (sus 16 bits) a float desplazándolo a la mitad alta de la palabra
+static inline float bf16_bits_a_float(uint16_t h) {
+    uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// Estrecha un float a bfloat16 con redondeo al par más cercano (los NaN se mantienen silenciosos)
+static inline uint16_t float_a_bf16_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return (uint16_t)((bits >> 16) | 0x0040u);
+    }
+    return (uint16_t)((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+// Versión vectorial de float_a_bf16_bits: deja los 16 bits del resultado en la mitad baja de cada palabra
+__attribute__((target("avx2,fma")))
+static inline __m256i float_a_bf16_avx2(__m256 v) {
+    __m256i bits = _mm256_castps_si256(v);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i redondeado = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF))), 16);
+    __m256i silencioso = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x0040));
+    __m256i es_nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+    return _mm256_blendv_epi8(redondeado, silencioso, es_nan);
+}
+
+// Ensancha 8 bfloat16 a float (desplazamiento de 16 bits en cada palabra)
+__attribute__((target("avx2,fma")))
+static inline __m256 bf16_a_float_avx2(__m128i h) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+}
+
+/*
+    Función AXPY con ensanchamiento emulado para CPUs x86 sin aritmética BF16 (solo AVX2 y FMA).
+    El ensanchamiento a float es un desplazamiento de 16 bits, el cálculo se hace con vfmadd en
+    float y el estrechamiento redondea al par más cercano con aritmética entera, 16 elementos por iteración.
+*/
+__attribute__((target("avx2,fma")))
+void axpy_avx2(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    uint16_t *yb = (uint16_t *)y;
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX2 <= n; i += 2 * LANES_AVX2) {
+        __m256i x16 = _mm256_loadu_si256((const __m256i *)(xb + i));
+        __m256i y16 = _mm256_loadu_si256((const __m256i *)(yb + i));
+        __m256 vx0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(x16)), 16));
+        __m256 vx1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(x16, 1)), 16));
+        __m256 vy0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(y16)), 16));
+        __m256 vy1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(y16, 1)), 16));
+        __m256i r0 = float_a_bf16_avx2(_mm256_fmadd_ps(va, vx0, vy0));
+        __m256i r1 = float_a_bf16_avx2(_mm256_fmadd_ps(va, vx1, vy1));
+        // packus trabaja por mitades de 128 bits: se reordenan los bloques para recuperar el orden original
+        __m256i r = _mm256_permute4x64_epi64(_mm256_packus_epi32(r0, r1), 0xD8);
+        _mm256_storeu_si256((__m256i *)(yb + i), r);
+    }
+
+    // Cola escalar con el mismo ensanchamiento y redondeo que la parte vectorial
+    float af = (float)a;
+    for (; i < n; i++) {
+        yb[i] = float_a_bf16_bits(__builtin_fmaf(af, bf16_bits_a_float(xb[i]), bf16_bits_a_float(yb[i])));
+    }
+}
+
+// Índices para deshacer el intercalado por bloques de 128 bits de unpacklo/unpackhi
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i indices_intercalado_avx512(void) {
+    uint16_t indices[LANES_AVX512];
+    for (int k = 0; k < LANES_AVX512; k++) {
+        int bloque = k / 8, pos = k % 8;
+        indices[k] = (uint16_t)((pos < 4) ? bloque * 4 + pos : 16 + bloque * 4 + (pos - 4));
+    }
+    return _mm512_loadu_si512(indices);
+}
+
+/*
+    Función AXPY con instrucciones AVX512-BF16 (32 elementos por iteración).
+    Se intercalan x e y en parejas (x_i, y_i) y vdpbf16ps calcula su producto escalar con
+    la pareja (a, 1), es decir a*x_i + y_i acumulado en float. vcvtne2ps2bf16 estrecha los
+    dos registros de resultados y una permutación devuelve los elementos a su orden original.
+*/
+__attribute__((target("avx512f,avx512bw,avx512bf16")))
+void axpy_avx512bf16(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    uint16_t *yb = (uint16_t *)y;
+    uint16_t a_bits;
+    memcpy(&a_bits, &a, sizeof(a_bits));
+
+    // Parejas (a, 1.0) en bfloat16: 1.0 = 0x3F80
+    __m512i va1 = _mm512_set1_epi32((int)(((uint32_t)0x3F80u << 16) | a_bits));
+
+    __m512i vindices = indices_intercalado_avx512();
+
+    int64_t i = 0;
+    while (i < n) {
+        int resto = n - i;
+        __mmask32 mascara = (resto >= LANES_AVX512) ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+        __m512i vx = _mm512_maskz_loadu_epi16(mascara, xb + i);
+        __m512i vy = _mm512_maskz_loadu_epi16(mascara, yb + i);
+
+        __m512 bajo = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpacklo_epi16(vx, vy), (__m512bh)va1);
+        __m512 alto = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpackhi_epi16(vx, vy), (__m512bh)va1);
+
+        __m512i r = (__m512i)_mm512_cvtne2ps_pbh(alto, bajo);
+        r = _mm512_permutexvar_epi16(vindices, r);
+        _mm512_mask_storeu_epi16(yb + i, mascara, r);
+
+        i += LANES_AVX512;
+    }
+}
+
+/*
+    Función AXPY por lotes con ensanchamiento emulado (AVX2 y FMA): cada fila i se recorre de
+    8 en 8 vectores del lote, ensanchando también alpha. El final de cada fila se calcula en
+    escalar con el mismo ensanchamiento y redondeo.
+*/
+__attribute__((target("avx2,fma")))
+void axpy_batched_avx2(int batch, int n, const __bf16 *alpha, const __bf16 *x, __bf16 *y, int stride) {
+    const uint16_t *ab = (const uint16_t *)alpha;
+
+    for (int i = 0; i < n; i++) {
+        const uint16_t *xi = (const uint16_t *)x + (size_t)i * stride;
+        uint16_t *yi = (uint16_t *)y + (size_t)i * stride;
+        int b = 0;
+
+        for (; b + LANES_AVX2 <= batch; b += LANES_AVX2) {
+            __m256 va = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(ab + b)));
+            __m256 vx = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xi + b)));
+            __m256 vy = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(yi + b)));
+            __m256i r = float_a_bf16_avx2(_mm256_fmadd_ps(va, vx, vy));
+            _mm_storeu_si128((__m128i *)(yi + b), _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1)));
+        }
+
+        for (; b < batch; b++) {
+            yi[b] = float_a_bf16_bits(__builtin_fmaf(bf16_bits_a_float(ab[b]), bf16_bits_a_float(xi[b]), bf16_bits_a_float(yi[b])));
+        }
+    }
+}
+
+/*
+    Función AXPY por lotes con AVX512-BF16: como axpy_avx512bf16, pero cada carril tiene su
+    propio alpha, de modo que las parejas (alpha_b, 1) se intercalan igual que (x_b, y_b).
+    El final de cada fila usa una máscara.
+*/
+__attribute__((target("avx512f,avx512bw,avx512bf16")))
+void axpy_batched_avx512bf16(int batch, int n, const __bf16 *alpha, const __bf16 *x, __bf16 *y, int stride) {
+    const uint16_t *ab = (const uint16_t *)alpha;
+    __m512i unos = _mm512_set1_epi16(0x3F80);
+    __m512i vindices = indices_intercalado_avx512();
+
+    for (int i = 0; i < n; i++) {
+        const uint16_t *xi = (const uint16_t *)x + (size_t)i * stride;
+        uint16_t *yi = (uint16_t *)y + (size_t)i * stride;
+
+        for (int b = 0; b < batch; b += LANES_AVX512) {
+            int resto = batch - b;
+            __mmask32 mascara = (resto >= LANES_AVX512) ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+            __m512i va = _mm512_maskz_loadu_epi16(mascara, ab + b);
+            __m512i vx = _mm512_maskz_loadu_epi16(mascara, xi + b);
+            __m512i vy = _mm512_maskz_loadu_epi16(mascara, yi + b);
+
+            __m512 bajo = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpacklo_epi16(vx, vy),
+                                           (__m512bh)_mm512_unpacklo_epi16(va, unos));
+            __m512 alto = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpackhi_epi16(vx, vy),
+                                           (__m512bh)_mm512_unpackhi_epi16(va, unos));
+
+            __m512i r = (__m512i)_mm512_cvtne2ps_pbh(alto, bajo);
+            _mm512_mask_storeu_epi16(yi + b, mascara, _mm512_permutexvar_epi16(vindices, r));
+        }
+    }
+}
+
+// Elementos de y hasta la siguiente frontera de alineamiento bytes (como mucho n)
+static inline int64_t elementos_cabecera(int64_t n, const __bf16 *y, int alineamiento) {
+    int64_t cabecera = (int64_t)(((alineamiento - ((uintptr_t)y & (alineamiento - 1))) & (alineamiento - 1)) / sizeof(__bf16));
+    return cabecera < n ? cabecera : n;
+}
+
+/*
+    Variantes con stores no temporales de axpy_avx512bf16 y axpy_avx2 para conjuntos de trabajo
+    mayores que la LLC: el resultado se escribe en y directamente desde el registro (vmovntdq),
+    sin que las líneas de y se queden en la jerarquía de caché. La cabecera hasta alinear y al
+    ancho del store y la cola usan el kernel normal. Los stores no temporales no están
+    ordenados con el resto: se drenan con sfence al terminar.
+*/
+__attribute__((target("avx512f,avx512bw,avx512bf16")))
+void axpy_streaming_avx512bf16(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    uint16_t *yb = (uint16_t *)y;
+    uint16_t a_bits;
+    memcpy(&a_bits, &a, sizeof(a_bits));
+
+    __m512i va1 = _mm512_set1_epi32((int)(((uint32_t)0x3F80u << 16) | a_bits));
+    __m512i vindices = indices_intercalado_avx512();
+    int64_t i = elementos_cabecera(n, y, 64);
+
+    axpy_avx512bf16(i, a, x, y);
+    for (; i + LANES_AVX512 <= n; i += LANES_AVX512) {
+        __m512i vx = _mm512_loadu_si512(xb + i);
+        __m512i vy = _mm512_load_si512(yb + i);
+
+        __m512 bajo = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpacklo_epi16(vx, vy), (__m512bh)va1);
+        __m512 alto = _mm512_dpbf16_ps(_mm512_setzero_ps(), (__m512bh)_mm512_unpackhi_epi16(vx, vy), (__m512bh)va1);
+
+        __m512i r = (__m512i)_mm512_cvtne2ps_pbh(alto, bajo);
+        _mm512_stream_si512((__m512i *)(yb + i), _mm512_permutexvar_epi16(vindices, r));
+    }
+    axpy_avx512bf16(n - i, a, x + i, y + i);
+    _mm_sfence();
+}
+
+__attribute__((target("avx2,fma")))
+void axpy_streaming_avx2(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    uint16_t *yb = (uint16_t *)y;
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = elementos_cabecera(n, y, 32);
+
+    axpy_avx2(i, a, x, y);
+    for (; i + 2 * LANES_AVX2 <= n; i += 2 * LANES_AVX2) {
+        __m256i x16 = _mm256_loadu_si256((const __m256i *)(xb + i));
+        __m256i y16 = _mm256_load_si256((const __m256i *)(yb + i));
+        __m256 vx0 = bf16_a_float_avx2(_mm256_castsi256_si128(x16));
+        __m256 vx1 = bf16_a_float_avx2(_mm256_extracti128_si256(x16, 1));
+        __m256 vy0 = bf16_a_float_avx2(_mm256_castsi256_si128(y16));
+        __m256 vy1 = bf16_a_float_avx2(_mm256_extracti128_si256(y16, 1));
+        __m256i r0 = float_a_bf16_avx2(_mm256_fmadd_ps(va, vx0, vy0));
+        __m256i r1 = float_a_bf16_avx2(_mm256_fmadd_ps(va, vx1, vy1));
+        _mm256_stream_si256((__m256i *)(yb + i), _mm256_permute4x64_epi64(_mm256_packus_epi32(r0, r1), 0xD8));
+    }
+    axpy_avx2(n - i, a, x + i, y + i);
+    _mm_sfence();
+}
+#endif
+
+// Kernel AXPY seleccionado en tiempo de ejecución
+typedef void (*axpy_kernel_t)(int64_t, __bf16, __bf16 *, __bf16 *);
+
+static axpy_kernel_t axpy_kernel = axpy_escalar;
+static const char *axpy_kernel_nombre = "escalar";
+
+// Kernel AXPY por lotes, escogido junto con el kernel AXPY
+typedef void (*axpy_batched_kernel_t)(int, int, const __bf16 *, const __bf16 *, __bf16 *, int);
+
+static axpy_batched_kernel_t axpy_batched_kernel = axpy_batched_escalar;
+
+// Kernel AXPY con stores no temporales (modo streaming), escogido junto con el kernel AXPY. El
+// escalar no tiene registros vectoriales que escribir sin caché: usa el bucle normal
+static axpy_kernel_t axpy_streaming_kernel = axpy_escalar;
+
+/*
+    Función para escoger el kernel AXPY según las extensiones que la CPU indica mediante cpuid.
+    Con "auto" se usa el kernel más ancho que soporta la CPU: AVX512-BF16, si no AVX2
+    (ensanchamiento emulado) y, si tampoco, el bucle escalar.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_axpy(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx512bf16 = __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512bw");
+    int soporta_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512bf16 ? "avx512bf16" : (soporta_avx2 ? "avx2" : "escalar");
+    }
+    if (strcmp(pedido, "avx512bf16") == 0 && soporta_avx512bf16) {
+        axpy_kernel = axpy_avx512bf16;
+        axpy_batched_kernel = axpy_batched_avx512bf16;
+        axpy_streaming_kernel = axpy_streaming_avx512bf16;
+        axpy_kernel_nombre = "avx512bf16";
+        return 0;
+    }
+    if (strcmp(pedido, "avx2") == 0 && soporta_avx2) {
+        axpy_kernel = axpy_avx2;
+        axpy_batched_kernel = axpy_batched_avx2;
+        axpy_streaming_kernel = axpy_streaming_avx2;
+        axpy_kernel_nombre = "avx2";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        axpy_kernel = axpy_escalar;
+        axpy_batched_kernel = axpy_batched_escalar;
+        axpy_streaming_kernel = axpy_escalar;
+        axpy_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Función AXPY
+void axpy(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    axpy_kernel(n, a, x, y);
+}
+
+// Función AXPY por lotes (ver axpy_batched_escalar), con el kernel escogido junto al de axpy
+void axpy_batched(int batch, int n, const __bf16 *alpha, const __bf16 *x, __bf16 *y, int stride) {
+    axpy_batched_kernel(batch, n, alpha, x, y, stride);
+}
+
+// Función AXPY con stores no temporales (ver axpy_streaming_avx512bf16), con el kernel escogido junto al de axpy
+void axpy_streaming(int64_t n, __bf16 a, __bf16 *x, __bf16 *y) {
+    axpy_streaming_kernel(n, a, x, y);
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(__bf16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Función AXPY multihilo: reparto estático de x e y, cada hilo aplica operacion sobre su bloque
+void axpy_multihilo(int64_t n, __bf16 a, __bf16 *x, __bf16 *y, int hilos, axpy_kernel_t operacion) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            operacion(fin - inicio, a, x + inicio, y + inicio);
+        }
+    }
+}
+
+/*
+    Copia paralela con el mismo reparto que axpy_multihilo. Cada hilo es el primero en escribir
+    (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, __bf16 *destino, const __bf16 *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(__bf16));
+        }
+    }
+}
+
+/*
+    Decide el modo streaming con -s: solo se considera si x e y no caben juntos en la LLC y, en
+    ese caso, se mide el mejor de dos pases de cada kernel con a = 0 (que deja y intacto) y se
+    usa el streaming solo si es más rápido. En AXPY y se lee antes de escribirse, así que los
+    stores no temporales no ahorran lecturas y en muchas máquinas no compensan.
+*/
+int decidir_streaming(int64_t n, __bf16 *x, __bf16 *y, long tamanho_llc) {
+    double normal = 0.0, streaming = 0.0;
+
+    if (2.0 * n * sizeof(__bf16) <= tamanho_llc) {
+        return 0;
+    }
+    for (int pase = 0; pase < 2; pase++) {
+        double inicio = omp_get_wtime();
+        axpy(n, (__bf16)0.0f, x, y);
+        double tiempo = omp_get_wtime() - inicio;
+        normal = (pase == 0 || tiempo < normal) ? tiempo : normal;
+
+        inicio = omp_get_wtime();
+        axpy_streaming(n, (__bf16)0.0f, x, y);
+        tiempo = omp_get_wtime() - inicio;
+        streaming = (pase == 0 || tiempo < streaming) ? tiempo : streaming;
+    }
+    return streaming < normal;
+}
+
+// Elementos procesados en cada medida del modo por lotes (batch * n * repeticiones)
+#define ELEMENTOS_POR_LOTES (1 << 22)
+
+// Elementos de y (todas las copias) que se restauran antes de cada tanda medida
+#define ELEMENTOS_COPIAS_LOTES (1 << 14)
+
+/*
+    Modo por lotes: barrido del número de lotes frente a la longitud de los vectores. En cada
+    combinación se compara un bucle de llamadas a axpy sobre vectores contiguos con una única
+    llamada a axpy_batched sobre los mismos datos intercalados, repitiendo ambas hasta procesar
+    unos ELEMENTOS_POR_LOTES elementos. Cada repetición parte de la y inicial, como las vueltas
+    del cronómetro en el modo normal: se guardan varias copias de y, se restauran fuera de la
+    medida y se mide una tanda de repeticiones seguidas, una por copia, para que el coste del
+    reloj no pese en los vectores cortos. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_por_lotes(void) {
+    static const int lotes[] = {1, 8, 64, 512, 4096};
+    static const int longitudes[] = {5, 8, 16, 32, 64};
+    const int num_lotes = (int)(sizeof(lotes) / sizeof(lotes[0]));
+    const int num_longitudes = (int)(sizeof(longitudes) / sizeof(longitudes[0]));
+
+    printf("Modo por lotes: lotes x longitud\n");
+
+    for (int l = 0; l < num_lotes; l++) {
+        for (int m = 0; m < num_longitudes; m++) {
+            int batch = lotes[l];
+            int n = longitudes[m];
+
+            // Paso entre filas redondeado a líneas de caché de 64 bytes
+            int elementos_linea = 64 / (int)sizeof(__bf16);
+            int stride = (batch + elementos_linea - 1) / elementos_linea * elementos_linea;
+
+            int repeticiones = ELEMENTOS_POR_LOTES / (batch * n);
+            if (repeticiones < 1) {
+                repeticiones = 1;
+            }
+
+            // Copias de y por tanda (al menos una y no más que las repeticiones)
+            int copias = ELEMENTOS_COPIAS_LOTES / (n * stride);
+            copias = copias < 1 ? 1 : (copias > repeticiones ? repeticiones : copias);
+            size_t elementos_contiguo = (size_t)batch * n;
+            size_t elementos_lotes = (size_t)n * stride;
+
+            __bf16 *alpha = (__bf16 *)malloc(batch * sizeof(__bf16));
+            __bf16 *x_contiguo = (__bf16 *)malloc(elementos_contiguo * sizeof(__bf16));
+            __bf16 *y_contiguo = (__bf16 *)malloc(elementos_contiguo * copias * sizeof(__bf16));
+            __bf16 *y_contiguo_inicial = (__bf16 *)malloc(elementos_contiguo * sizeof(__bf16));
+            __bf16 *x_lotes = (__bf16 *)calloc(elementos_lotes, sizeof(__bf16));
+            __bf16 *y_lotes = (__bf16 *)calloc(elementos_lotes * copias, sizeof(__bf16));
+            __bf16 *y_lotes_inicial = (__bf16 *)calloc(elementos_lotes, sizeof(__bf16));
+
+            if (alpha == NULL || x_contiguo == NULL || y_contiguo == NULL || y_contiguo_inicial == NULL ||
+                x_lotes == NULL || y_lotes == NULL || y_lotes_inicial == NULL) {
+                printf("Error al asignar memoria\n");
+                free(alpha);
+                free(x_contiguo);
+                free(y_contiguo);
+                free(y_contiguo_inicial);
+                free(x_lotes);
+                free(y_lotes);
+                free(y_lotes_inicial);
+                return -1;
+            }
+
+            // Mismos datos en ambas disposiciones: alpha en [0, 1], x e y en [-1, 1]
+            for (int b = 0; b < batch; b++) {
+                alpha[b] = (__bf16)aleatorio_siguiente();
+                ALEATORIO_RELLENAR(i, n, u, 2,
+                    x_contiguo[(size_t)b * n + i] = (__bf16)(2.0f * u[0] - 1.0f);
+                    y_contiguo_inicial[(size_t)b * n + i] = (__bf16)(2.0f * u[1] - 1.0f);
+                    x_lotes[(size_t)i * stride + b] = x_contiguo[(size_t)b * n + i];
+                    y_lotes_inicial[(size_t)i * stride + b] = y_contiguo_inicial[(size_t)b * n + i];
+                );
+            }
+
+            double tiempo_axpy = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_contiguo + c * elementos_contiguo, y_contiguo_inicial, elementos_contiguo * sizeof(__bf16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    __bf16 *y = y_contiguo + c * elementos_contiguo;
+                    for (int b = 0; b < batch; b++) {
+                        axpy(n, alpha[b], x_contiguo + (size_t)b * n, y + (size_t)b * n);
+                    }
+                }
+                tiempo_axpy += omp_get_wtime() - inicio;
+            }
+
+            double tiempo_lotes = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_lotes + c * elementos_lotes, y_lotes_inicial, elementos_lotes * sizeof(__bf16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    axpy_batched(batch, n, alpha, x_lotes, y_lotes + c * elementos_lotes, stride);
+                }
+                tiempo_lotes += omp_get_wtime() - inicio;
+            }
+
+            printf("Lotes: %d Longitud: %d Tiempo axpy: %f Tiempo axpy_batched: %f Speedup: %.2f\n",
+                   batch, n, tiempo_axpy, tiempo_lotes, tiempo_axpy / tiempo_lotes);
+
+            free(alpha);
+            free(x_contiguo);
+            free(y_contiguo);
+            free(y_contiguo_inicial);
+            free(x_lotes);
+            free(y_lotes);
+            free(y_lotes_inicial);
+        }
+    }
+    return 0;
+}
+
+/*
+    Modo barrido (--sweep): mide AXPY para cada tamaño de la lista en un único proceso. x e y se
+    reservan e inicializan una vez con el mayor tamaño y cada medida usa sus n primeros elementos,
+    partiendo siempre de la copia inicial de y. Con -s el kernel streaming se decide para cada
+    tamaño. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones, int modo_streaming) {
+    int64_t maximo = barrido->maximo;
+    __bf16 a = 2.3752f16;
+    long tamanho_llc = cache_tamanho_llc();
+
+    __bf16 *x = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *y = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *y_inicial = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+
+    if (x == NULL || y == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
+        x[i] = (__bf16)x_temp;
+        y[i] = (__bf16)y_temp;
+    );
+
+    memcpy(y_inicial, y, maximo * sizeof(__bf16));
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+        axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            memcpy(y, y_inicial, n * sizeof(__bf16));
+
+            cronometro_arrancar(&cronometro);
+            operacion(n, a, x, y);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "axpy", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)y[n-1], (float)y[n-1]);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
 
 int main(int argc, char *argv[]) {
     
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    int modo_streaming = 0;
+    int modo_lotes = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -s, -S, -b, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:sSbw:r:H:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 's':
+                // Streaming si el conjunto de trabajo supera la LLC y es más rápido
+                modo_streaming = 1;
+                break;
+            case 'S':
+                // Streaming forzado
+                modo_streaming = 2;
+                break;
+            case 'b':
+                // Barrido de axpy_batched frente a axpy en bucle
+                modo_lotes = 1;
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-k auto|escalar|avx2|avx512bf16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
         return EXIT_FAILURE;
-    }   
+    }
 
-    int n = -1;
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
 
-    n = atoi(argv[optind]);
+    // El barrido mide un solo hilo y el AXPY sin lotes
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && modo_lotes) {
+        fprintf(stderr, "-b no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-k auto|escalar|avx2|avx512bf16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
 
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (seleccionar_kernel_axpy(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel AXPY no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel AXPY: %s\n", axpy_kernel_nombre);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones, modo_streaming) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     __bf16 a = 2.3752f16;
     __bf16 *x_small = (__bf16 *)malloc(N_SMALL * sizeof(__bf16));
     __bf16 *y_small = (__bf16 *)malloc(N_SMALL * sizeof(__bf16));
@@ -61,15 +764,15 @@ int main(int argc, char *argv[]) {
 
     // Se usa una semilla proporcionada como argumento o una por defecto
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < N_SMALL; i++) {
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0;
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        float x_temp = u[0] * 10.0;
+        float y_temp = u[1] * 10.0;
         x_small[i] = (__bf16)x_temp;
         y_small[i] = (__bf16)y_temp;
-    }
+    );
 
     printf("Array x_small: [ ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -93,48 +796,92 @@ int main(int argc, char *argv[]) {
     free(y_small);
 
 
-    __bf16 *x = (__bf16 *)malloc(n * sizeof(__bf16));
-    __bf16 *y = (__bf16 *)malloc(n * sizeof(__bf16));
+    __bf16 *x = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *y = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
 
     if (x == NULL || y == NULL) {
         printf("Error al asignar memoria\n");
         return EXIT_FAILURE;
     }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
 
     
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < n; i++) {
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
         x[i] = (__bf16)x_temp;
         y[i] = (__bf16)y_temp;
+    );
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "bfloat16", "axpy", axpy_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
     }
 
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)x[i]);
         }
         printf("\n"); 
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)x[i]);
+        }
+    }
 
 
-    //Para medir el tiempo de ejecución
-    
-    clock_t start, end;
-    double cpu_time_used;
+    // Copia de y previa a la operación para las repeticiones y el modo multihilo
+    __bf16 *y_inicial = NULL;
+    if (hilos_max > 0 || calentamiento + repeticiones > 1) {
+        y_inicial = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+        if (y_inicial == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+        memcpy(y_inicial, y, n * sizeof(__bf16));
+    }
 
-    start = clock();
-    
-    ////    Código del programa cuyo tiempo quiero medir
+    // Modo streaming: forzado (-S) o, con -s, solo si compensa (ver decidir_streaming)
+    long tamanho_llc = cache_tamanho_llc();
+    double conjunto_trabajo = 2.0 * n * sizeof(__bf16);
+    int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+    axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+    if (modo_streaming) {
+        printf("Modo streaming: %s (conjunto de trabajo %.0f bytes, LLC %ld bytes)\n",
+               usar_streaming ? "activado" : "desactivado", conjunto_trabajo, tamanho_llc);
+    }
 
-    // Se ejecuta la operación AXPY
-    axpy(n, a, x, y);
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+    double tiempo;
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo y, de modo que el resultado es el de una sola llamada
+        if (y_inicial != NULL) {
+            memcpy(y, y_inicial, n * sizeof(__bf16));
+        }
+
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación AXPY
+        operacion(n, a, x, y);
+        cronometro_parar(&cronometro);
+    }
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    tiempo = cronometro_imprimir(&cronometro);
+    if (modo_streaming) {
+        printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(__bf16)) / tiempo / 1e9);
+    }
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
@@ -142,15 +889,126 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)y[i]);
         }
         printf("\n");    
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)y[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
     
+    /*
+        Modo multihilo: se mide AXPY con 1, 2, 4, ... hasta hilos_max hilos. Para cada número de
+        hilos se crean copias de x e y inicializadas en paralelo con el mismo reparto estático que
+        la operación, de modo que cada hilo trabaja sobre páginas ubicadas en su nodo NUMA.
+        Cada vuelta vuelve a copiar y en paralelo, por lo que solo la primera hace el first-touch.
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            __bf16 *x_hilos = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+            __bf16 *y_hilos = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+
+            if (x_hilos == NULL || y_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                copiar_multihilo(n, y_hilos, y_inicial, hilos);
+
+                cronometro_arrancar(&cronometro);
+                axpy_multihilo(n, a, x_hilos, y_hilos, hilos, operacion);
+                cronometro_parar(&cronometro);
+            }
+            double tiempo_hilos = cronometro_imprimir(&cronometro);
+            printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(__bf16)) / tiempo_hilos / 1e9);
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    if (modo_lotes && modo_por_lotes() != 0) {
+        return EXIT_FAILURE;
+    }
+
     // Liberar memoria asignada
-    free(x);
-    free(y);
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de AXPY en el programa unificado (Programas/BENCH, ver registro.h): x son los n
+    primeros valores del driver e y los n siguientes, en __bf16. y se restaura antes de cada
+    vuelta. El kernel se escoge con cpuid ("auto").
+*/
+REGISTRO_TIPO(axpy_tipo, __bf16, (__bf16), (float))
+
+static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+    seleccionar_kernel_axpy("auto");
+    return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+}
+
+static void axpy_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    axpy(estado->n, 2.3752f16, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+static double axpy_flops(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double axpy_trafico(int64_t n) {
+    return 3.0 * (double)n;
+}
+
+static const registro_kernel_t registro_axpy = {
+    .kernel = "axpy",
+    .medida = "axpy",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &axpy_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = axpy_preparar,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = axpy_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = axpy_flops,
+    .elementos = axpy_trafico,
+};
+REGISTRO_KERNEL(registro_axpy)
+
+#endif /* BENCH_REGISTRO */
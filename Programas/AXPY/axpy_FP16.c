@@ -2,48 +2,679 @@
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/cache_info.h"
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
 
 #define N_SMALL 5
 
-// Función AXPY
-void axpy(int n, _Float16 a, _Float16 *x, _Float16 *y) {
-    for (int i = 0; i < n; i++) {
+// Número de elementos _Float16 en un registro de 512 bits
+#define LANES_AVX512 32
+// Número de elementos _Float16 que se convierten a un registro float de 256 bits
+#define LANES_F16C 8
+
+// Función AXPY (versión escalar, empleada como referencia y como fallback)
+void axpy_escalar(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    for (int64_t i = 0; i < n; i++) {
         y[i] = a * x[i] + y[i];
     }
 }
 
+/*
+    Función AXPY por lotes (versión escalar): y_b = alpha[b] * x_b + y_b para batch vectores
+    independientes de n elementos. Los vectores se guardan intercalados: el elemento i del
+    vector b está en i * stride + b (stride >= batch), de modo que el bucle interno recorre el
+    lote con accesos contiguos y los kernels vectoriales trabajan a lo ancho del lote en lugar
+    de a lo largo de vectores cortos.
+*/
+void axpy_batched_escalar(int batch, int n, const _Float16 *alpha, const _Float16 *x, _Float16 *y, int stride) {
+    for (int i = 0; i < n; i++) {
+        const _Float16 *xi = x + (size_t)i * stride;
+        _Float16 *yi = y + (size_t)i * stride;
+        for (int b = 0; b < batch; b++) {
+            yi[b] = alpha[b] * xi[b] + yi[b];
+        }
+    }
+}
+
+#ifdef __x86_64__
+/*
+    Función AXPY con instrucciones AVX512-FP16 (32 elementos por registro).
+    Se procesa una cabecera enmascarada hasta que y queda alineado a 64 bytes,
+    después el bucle principal con cargas/almacenamientos alineados de y y,
+    por último, la cola restante con una máscara.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+void axpy_avx512fp16(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    __m512h va = _mm512_set1_ph(a);
+    int64_t i = 0;
+
+    // Cabecera: elementos hasta la siguiente frontera de 64 bytes de y
+    int cabecera = (int)(((64 - ((uintptr_t)y & 63)) & 63) / sizeof(_Float16));
+    if (cabecera > n) {
+        cabecera = n;
+    }
+    if (cabecera > 0) {
+        __mmask32 mascara = (__mmask32)((1u << cabecera) - 1);
+        __m512h vx = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, x));
+        __m512h vy = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, y));
+        _mm512_mask_storeu_epi16(y, mascara, _mm512_castph_si512(_mm512_fmadd_ph(va, vx, vy)));
+        i = cabecera;
+    }
+
+    // Bucle principal con y alineado
+    for (; i + LANES_AVX512 <= n; i += LANES_AVX512) {
+        __m512h vx = _mm512_loadu_ph(x + i);
+        __m512h vy = _mm512_load_ph(y + i);
+        _mm512_store_ph(y + i, _mm512_fmadd_ph(va, vx, vy));
+    }
+
+    // Cola enmascarada con los elementos restantes (menos de 32)
+    int resto = n - i;
+    if (resto > 0) {
+        __mmask32 mascara = (__mmask32)((1u << resto) - 1);
+        __m512h vx = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, x + i));
+        __m512h vy = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, y + i));
+        _mm512_mask_storeu_epi16(y + i, mascara, _mm512_castph_si512(_mm512_fmadd_ph(va, vx, vy)));
+    }
+}
+
+/*
+    Función AXPY para CPUs x86 con F16C y FMA pero sin AVX512-FP16.
+    Se mantiene el almacenamiento en _Float16 pero el cálculo se hace en float:
+    vcvtph2ps (ensanchar) -> vfmadd (calcular) -> vcvtps2ph (estrechar), con
+    16 elementos por iteración repartidos en dos registros de 8 floats.
+    El resultado se redondea una sola vez a _Float16 por elemento.
+*/
+__attribute__((target("avx2,fma,f16c")))
+void axpy_f16c(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_F16C <= n; i += 2 * LANES_F16C) {
+        __m256 vx0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m256 vx1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i + LANES_F16C)));
+        __m256 vy0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(y + i)));
+        __m256 vy1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(y + i + LANES_F16C)));
+        vy0 = _mm256_fmadd_ps(va, vx0, vy0);
+        vy1 = _mm256_fmadd_ps(va, vx1, vy1);
+        _mm_storeu_si128((__m128i *)(y + i), _mm256_cvtps_ph(vy0, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i *)(y + i + LANES_F16C), _mm256_cvtps_ph(vy1, _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    for (; i + LANES_F16C <= n; i += LANES_F16C) {
+        __m256 vx = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m256 vy = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(y + i)));
+        _mm_storeu_si128((__m128i *)(y + i), _mm256_cvtps_ph(_mm256_fmadd_ps(va, vx, vy), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    // Cola escalar con el mismo redondeo único que la parte vectorial
+    for (; i < n; i++) {
+        y[i] = (_Float16)__builtin_fmaf((float)a, (float)x[i], (float)y[i]);
+    }
+}
+
+/*
+    Función AXPY por lotes con AVX512-FP16: cada fila i se recorre de 32 en 32 vectores del
+    lote, con un alpha distinto en cada carril. El final de la fila usa una máscara.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+void axpy_batched_avx512fp16(int batch, int n, const _Float16 *alpha, const _Float16 *x, _Float16 *y, int stride) {
+    for (int i = 0; i < n; i++) {
+        const _Float16 *xi = x + (size_t)i * stride;
+        _Float16 *yi = y + (size_t)i * stride;
+
+        for (int b = 0; b < batch; b += LANES_AVX512) {
+            int resto = batch - b;
+            __mmask32 mascara = resto >= LANES_AVX512 ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+            __m512h va = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, alpha + b));
+            __m512h vx = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, xi + b));
+            __m512h vy = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, yi + b));
+            _mm512_mask_storeu_epi16(yi + b, mascara, _mm512_castph_si512(_mm512_fmadd_ph(va, vx, vy)));
+        }
+    }
+}
+
+/*
+    Función AXPY por lotes con F16C y FMA: como axpy_f16c pero de 8 en 8 vectores del lote,
+    ensanchando también alpha. El final de cada fila se calcula en escalar con el mismo
+    redondeo único.
+*/
+__attribute__((target("avx2,fma,f16c")))
+void axpy_batched_f16c(int batch, int n, const _Float16 *alpha, const _Float16 *x, _Float16 *y, int stride) {
+    for (int i = 0; i < n; i++) {
+        const _Float16 *xi = x + (size_t)i * stride;
+        _Float16 *yi = y + (size_t)i * stride;
+        int b = 0;
+
+        for (; b + LANES_F16C <= batch; b += LANES_F16C) {
+            __m256 va = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(alpha + b)));
+            __m256 vx = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(xi + b)));
+            __m256 vy = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(yi + b)));
+            _mm_storeu_si128((__m128i *)(yi + b), _mm256_cvtps_ph(_mm256_fmadd_ps(va, vx, vy), _MM_FROUND_TO_NEAREST_INT));
+        }
+
+        for (; b < batch; b++) {
+            yi[b] = (_Float16)__builtin_fmaf((float)alpha[b], (float)xi[b], (float)yi[b]);
+        }
+    }
+}
+
+// Elementos de y hasta la siguiente frontera de alineamiento bytes (como mucho n)
+static inline int64_t elementos_cabecera(int64_t n, const _Float16 *y, int alineamiento) {
+    int64_t cabecera = (int64_t)(((alineamiento - ((uintptr_t)y & (alineamiento - 1))) & (alineamiento - 1)) / sizeof(_Float16));
+    return cabecera < n ? cabecera : n;
+}
+
+/*
+    Variantes con stores no temporales de axpy_avx512fp16 y axpy_f16c para conjuntos de trabajo
+    mayores que la LLC: el resultado se escribe en y directamente desde el registro (vmovntdq),
+    sin que las líneas de y se queden en la jerarquía de caché. La cabecera hasta alinear y al
+    ancho del store y la cola usan el kernel normal. Los stores no temporales no están
+    ordenados con el resto: se drenan con sfence al terminar.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+void axpy_streaming_avx512fp16(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    __m512h va = _mm512_set1_ph(a);
+    int64_t i = elementos_cabecera(n, y, 64);
+
+    axpy_avx512fp16(i, a, x, y);
+    for (; i + LANES_AVX512 <= n; i += LANES_AVX512) {
+        __m512h vx = _mm512_loadu_ph(x + i);
+        __m512h vy = _mm512_load_ph(y + i);
+        _mm512_stream_si512((__m512i *)(y + i), _mm512_castph_si512(_mm512_fmadd_ph(va, vx, vy)));
+    }
+    axpy_avx512fp16(n - i, a, x + i, y + i);
+    _mm_sfence();
+}
+
+__attribute__((target("avx2,fma,f16c")))
+void axpy_streaming_f16c(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = elementos_cabecera(n, y, 16);
+
+    axpy_f16c(i, a, x, y);
+    for (; i + LANES_F16C <= n; i += LANES_F16C) {
+        __m256 vx = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m256 vy = _mm256_cvtph_ps(_mm_load_si128((const __m128i *)(y + i)));
+        _mm_stream_si128((__m128i *)(y + i), _mm256_cvtps_ph(_mm256_fmadd_ps(va, vx, vy), _MM_FROUND_TO_NEAREST_INT));
+    }
+    axpy_f16c(n - i, a, x + i, y + i);
+    _mm_sfence();
+}
+#endif
+
+// Kernel AXPY seleccionado en tiempo de ejecución
+typedef void (*axpy_kernel_t)(int64_t, _Float16, _Float16 *, _Float16 *);
+
+static axpy_kernel_t axpy_kernel = axpy_escalar;
+static const char *axpy_kernel_nombre = "escalar";
+
+// Kernel AXPY por lotes, escogido junto con el kernel AXPY
+typedef void (*axpy_batched_kernel_t)(int, int, const _Float16 *, const _Float16 *, _Float16 *, int);
+
+static axpy_batched_kernel_t axpy_batched_kernel = axpy_batched_escalar;
+
+// Kernel AXPY con stores no temporales (modo streaming), escogido junto con el kernel AXPY. El
+// escalar no tiene registros vectoriales que escribir sin caché: usa el bucle normal
+static axpy_kernel_t axpy_streaming_kernel = axpy_escalar;
+
+/*
+    Función para escoger el kernel AXPY según las extensiones que la CPU indica mediante cpuid.
+    Con "auto" se usa el kernel más ancho que soporta la CPU: AVX512-FP16, si no F16C (cálculo
+    en float) y, si tampoco, el bucle escalar.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_axpy(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx512fp16 = __builtin_cpu_supports("avx512fp16");
+    int soporta_f16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("avx2");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512fp16 ? "avx512fp16" : (soporta_f16c ? "f16c" : "escalar");
+    }
+    if (strcmp(pedido, "avx512fp16") == 0 && soporta_avx512fp16) {
+        axpy_kernel = axpy_avx512fp16;
+        axpy_batched_kernel = axpy_batched_avx512fp16;
+        axpy_streaming_kernel = axpy_streaming_avx512fp16;
+        axpy_kernel_nombre = "avx512fp16";
+        return 0;
+    }
+    if (strcmp(pedido, "f16c") == 0 && soporta_f16c) {
+        axpy_kernel = axpy_f16c;
+        axpy_batched_kernel = axpy_batched_f16c;
+        axpy_streaming_kernel = axpy_streaming_f16c;
+        axpy_kernel_nombre = "f16c";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        axpy_kernel = axpy_escalar;
+        axpy_batched_kernel = axpy_batched_escalar;
+        axpy_streaming_kernel = axpy_escalar;
+        axpy_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Función AXPY
+void axpy(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    axpy_kernel(n, a, x, y);
+}
+
+// Función AXPY por lotes (ver axpy_batched_escalar), con el kernel escogido junto al de axpy
+void axpy_batched(int batch, int n, const _Float16 *alpha, const _Float16 *x, _Float16 *y, int stride) {
+    axpy_batched_kernel(batch, n, alpha, x, y, stride);
+}
+
+// Función AXPY con stores no temporales (ver axpy_streaming_avx512fp16), con el kernel escogido junto al de axpy
+void axpy_streaming(int64_t n, _Float16 a, _Float16 *x, _Float16 *y) {
+    axpy_streaming_kernel(n, a, x, y);
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(_Float16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Función AXPY multihilo: reparto estático de x e y, cada hilo aplica operacion sobre su bloque
+void axpy_multihilo(int64_t n, _Float16 a, _Float16 *x, _Float16 *y, int hilos, axpy_kernel_t operacion) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            operacion(fin - inicio, a, x + inicio, y + inicio);
+        }
+    }
+}
+
+/*
+    Copia paralela con el mismo reparto que axpy_multihilo. Cada hilo es el primero en escribir
+    (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, _Float16 *destino, const _Float16 *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(_Float16));
+        }
+    }
+}
+
+/*
+    Decide el modo streaming con -s: solo se considera si x e y no caben juntos en la LLC y, en
+    ese caso, se mide el mejor de dos pases de cada kernel con a = 0 (que deja y intacto) y se
+    usa el streaming solo si es más rápido. En AXPY y se lee antes de escribirse, así que los
+    stores no temporales no ahorran lecturas y en muchas máquinas no compensan.
+*/
+int decidir_streaming(int64_t n, _Float16 *x, _Float16 *y, long tamanho_llc) {
+    double normal = 0.0, streaming = 0.0;
+
+    if (2.0 * n * sizeof(_Float16) <= tamanho_llc) {
+        return 0;
+    }
+    for (int pase = 0; pase < 2; pase++) {
+        double inicio = omp_get_wtime();
+        axpy(n, (_Float16)0.0f, x, y);
+        double tiempo = omp_get_wtime() - inicio;
+        normal = (pase == 0 || tiempo < normal) ? tiempo : normal;
+
+        inicio = omp_get_wtime();
+        axpy_streaming(n, (_Float16)0.0f, x, y);
+        tiempo = omp_get_wtime() - inicio;
+        streaming = (pase == 0 || tiempo < streaming) ? tiempo : streaming;
+    }
+    return streaming < normal;
+}
+
+// Elementos procesados en cada medida del modo por lotes (batch * n * repeticiones)
+#define ELEMENTOS_POR_LOTES (1 << 22)
+
+// Elementos de y (todas las copias) que se restauran antes de cada tanda medida
+#define ELEMENTOS_COPIAS_LOTES (1 << 14)
+
+/*
+    Modo por lotes: barrido del número de lotes frente a la longitud de los vectores. En cada
+    combinación se compara un bucle de llamadas a axpy sobre vectores contiguos con una única
+    llamada a axpy_batched sobre los mismos datos intercalados, repitiendo ambas hasta procesar
+    unos ELEMENTOS_POR_LOTES elementos. Cada repetición parte de la y inicial, como las vueltas
+    del cronómetro en el modo normal: se guardan varias copias de y, se restauran fuera de la
+    medida y se mide una tanda de repeticiones seguidas, una por copia, para que el coste del
+    reloj no pese en los vectores cortos. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_por_lotes(void) {
+    static const int lotes[] = {1, 8, 64, 512, 4096};
+    static const int longitudes[] = {5, 8, 16, 32, 64};
+    const int num_lotes = (int)(sizeof(lotes) / sizeof(lotes[0]));
+    const int num_longitudes = (int)(sizeof(longitudes) / sizeof(longitudes[0]));
+
+    printf("Modo por lotes: lotes x longitud\n");
+
+    for (int l = 0; l < num_lotes; l++) {
+        for (int m = 0; m < num_longitudes; m++) {
+            int batch = lotes[l];
+            int n = longitudes[m];
+
+            // Paso entre filas redondeado a líneas de caché de 64 bytes
+            int elementos_linea = 64 / (int)sizeof(_Float16);
+            int stride = (batch + elementos_linea - 1) / elementos_linea * elementos_linea;
+
+            int repeticiones = ELEMENTOS_POR_LOTES / (batch * n);
+            if (repeticiones < 1) {
+                repeticiones = 1;
+            }
+
+            // Copias de y por tanda (al menos una y no más que las repeticiones)
+            int copias = ELEMENTOS_COPIAS_LOTES / (n * stride);
+            copias = copias < 1 ? 1 : (copias > repeticiones ? repeticiones : copias);
+            size_t elementos_contiguo = (size_t)batch * n;
+            size_t elementos_lotes = (size_t)n * stride;
+
+            _Float16 *alpha = (_Float16 *)malloc(batch * sizeof(_Float16));
+            _Float16 *x_contiguo = (_Float16 *)malloc(elementos_contiguo * sizeof(_Float16));
+            _Float16 *y_contiguo = (_Float16 *)malloc(elementos_contiguo * copias * sizeof(_Float16));
+            _Float16 *y_contiguo_inicial = (_Float16 *)malloc(elementos_contiguo * sizeof(_Float16));
+            _Float16 *x_lotes = (_Float16 *)calloc(elementos_lotes, sizeof(_Float16));
+            _Float16 *y_lotes = (_Float16 *)calloc(elementos_lotes * copias, sizeof(_Float16));
+            _Float16 *y_lotes_inicial = (_Float16 *)calloc(elementos_lotes, sizeof(_Float16));
+
+            if (alpha == NULL || x_contiguo == NULL || y_contiguo == NULL || y_contiguo_inicial == NULL ||
+                x_lotes == NULL || y_lotes == NULL || y_lotes_inicial == NULL) {
+                printf("Error al asignar memoria\n");
+                free(alpha);
+                free(x_contiguo);
+                free(y_contiguo);
+                free(y_contiguo_inicial);
+                free(x_lotes);
+                free(y_lotes);
+                free(y_lotes_inicial);
+                return -1;
+            }
+
+            // Mismos datos en ambas disposiciones: alpha en [0, 1], x e y en [-1, 1]
+            for (int b = 0; b < batch; b++) {
+                alpha[b] = (_Float16)aleatorio_siguiente();
+                ALEATORIO_RELLENAR(i, n, u, 2,
+                    x_contiguo[(size_t)b * n + i] = (_Float16)(2.0f * u[0] - 1.0f);
+                    y_contiguo_inicial[(size_t)b * n + i] = (_Float16)(2.0f * u[1] - 1.0f);
+                    x_lotes[(size_t)i * stride + b] = x_contiguo[(size_t)b * n + i];
+                    y_lotes_inicial[(size_t)i * stride + b] = y_contiguo_inicial[(size_t)b * n + i];
+                );
+            }
+
+            double tiempo_axpy = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_contiguo + c * elementos_contiguo, y_contiguo_inicial, elementos_contiguo * sizeof(_Float16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    _Float16 *y = y_contiguo + c * elementos_contiguo;
+                    for (int b = 0; b < batch; b++) {
+                        axpy(n, alpha[b], x_contiguo + (size_t)b * n, y + (size_t)b * n);
+                    }
+                }
+                tiempo_axpy += omp_get_wtime() - inicio;
+            }
+
+            double tiempo_lotes = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_lotes + c * elementos_lotes, y_lotes_inicial, elementos_lotes * sizeof(_Float16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    axpy_batched(batch, n, alpha, x_lotes, y_lotes + c * elementos_lotes, stride);
+                }
+                tiempo_lotes += omp_get_wtime() - inicio;
+            }
+
+            printf("Lotes: %d Longitud: %d Tiempo axpy: %f Tiempo axpy_batched: %f Speedup: %.2f\n",
+                   batch, n, tiempo_axpy, tiempo_lotes, tiempo_axpy / tiempo_lotes);
+
+            free(alpha);
+            free(x_contiguo);
+            free(y_contiguo);
+            free(y_contiguo_inicial);
+            free(x_lotes);
+            free(y_lotes);
+            free(y_lotes_inicial);
+        }
+    }
+    return 0;
+}
+
+/*
+    Modo barrido (--sweep): mide AXPY para cada tamaño de la lista en un único proceso. x e y se
+    reservan e inicializan una vez con el mayor tamaño y cada medida usa sus n primeros elementos,
+    partiendo siempre de la copia inicial de y. Con -s el kernel streaming se decide para cada
+    tamaño. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones, int modo_streaming) {
+    int64_t maximo = barrido->maximo;
+    _Float16 a = 2.3752f16;
+    long tamanho_llc = cache_tamanho_llc();
+
+    _Float16 *x = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *y = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *y_inicial = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+
+    if (x == NULL || y == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
+        x[i] = (_Float16)x_temp;
+        y[i] = (_Float16)y_temp;
+    );
+
+    memcpy(y_inicial, y, maximo * sizeof(_Float16));
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+        axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            memcpy(y, y_inicial, n * sizeof(_Float16));
+
+            cronometro_arrancar(&cronometro);
+            operacion(n, a, x, y);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "axpy", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)y[n-1], (float)y[n-1]);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
 int main(int argc, char *argv[]) {
     
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    int modo_streaming = 0;
+    int modo_lotes = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -s, -S, -b, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:sSbw:r:H:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 's':
+                // Streaming si el conjunto de trabajo supera la LLC y es más rápido
+                modo_streaming = 1;
+                break;
+            case 'S':
+                // Streaming forzado
+                modo_streaming = 2;
+                break;
+            case 'b':
+                // Barrido de axpy_batched frente a axpy en bucle
+                modo_lotes = 1;
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-k auto|escalar|f16c|avx512fp16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
         return EXIT_FAILURE;
-    }   
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo y el AXPY sin lotes
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
 
-    int n = -1;
+    if (barrido.num > 0 && modo_lotes) {
+        fprintf(stderr, "-b no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-k auto|escalar|f16c|avx512fp16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
 
-    n = atoi(argv[optind]);
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (seleccionar_kernel_axpy(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel AXPY no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel AXPY: %s\n", axpy_kernel_nombre);
     
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones, modo_streaming) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     _Float16 a = 2.3752f16;
     _Float16 *x_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
     _Float16 *y_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
@@ -56,17 +687,17 @@ int main(int argc, char *argv[]) {
 
     // Se usa una semilla proporcionada como argumento o una por defecto
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < N_SMALL; i++) {
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
 
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
         x_small[i] = (_Float16)x_temp;
         y_small[i] = (_Float16)y_temp;
 
-    }
+    );
 
     printf("Array x_small: [ ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -89,48 +720,93 @@ int main(int argc, char *argv[]) {
     free(x_small);
     free(y_small);
 
-    _Float16 *x = (_Float16 *)malloc(n * sizeof(_Float16));
-    _Float16 *y = (_Float16 *)malloc(n * sizeof(_Float16));
+    _Float16 *x = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *y = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
 
     if (x == NULL || y == NULL) {
         printf("Error al asignar memoria\n");
         return EXIT_FAILURE;
     }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
 
     
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < n; i++) {
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
         x[i] = (_Float16)x_temp;
         y[i] = (_Float16)y_temp;
-    }
+    );
+
 
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "axpy", axpy_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
 
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)x[i]);
         }
         printf("\n"); 
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)x[i]);
+        }
+    }
 
 
-    //Para medir el tiempo de ejecución
-    
-    clock_t start, end;
-    double cpu_time_used;
+    // Copia de y previa a la operación para las repeticiones y el modo multihilo
+    _Float16 *y_inicial = NULL;
+    if (hilos_max > 0 || calentamiento + repeticiones > 1) {
+        y_inicial = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+        if (y_inicial == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+        memcpy(y_inicial, y, n * sizeof(_Float16));
+    }
 
-    start = clock();
-    
-    ////    Código del programa cuyo tiempo quiero medir
-    
-    axpy(n, a, x, y);
+    // Modo streaming: forzado (-S) o, con -s, solo si compensa (ver decidir_streaming)
+    long tamanho_llc = cache_tamanho_llc();
+    double conjunto_trabajo = 2.0 * n * sizeof(_Float16);
+    int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+    axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+    if (modo_streaming) {
+        printf("Modo streaming: %s (conjunto de trabajo %.0f bytes, LLC %ld bytes)\n",
+               usar_streaming ? "activado" : "desactivado", conjunto_trabajo, tamanho_llc);
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+    double tiempo;
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo y, de modo que el resultado es el de una sola llamada
+        if (y_inicial != NULL) {
+            memcpy(y, y_inicial, n * sizeof(_Float16));
+        }
+
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación AXPY
+        operacion(n, a, x, y);
+        cronometro_parar(&cronometro);
+    }
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    tiempo = cronometro_imprimir(&cronometro);
+    if (modo_streaming) {
+        printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(_Float16)) / tiempo / 1e9);
+    }
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
@@ -138,15 +814,126 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)y[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)y[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se mide AXPY con 1, 2, 4, ... hasta hilos_max hilos. Para cada número de
+        hilos se crean copias de x e y inicializadas en paralelo con el mismo reparto estático que
+        la operación, de modo que cada hilo trabaja sobre páginas ubicadas en su nodo NUMA.
+        Cada vuelta vuelve a copiar y en paralelo, por lo que solo la primera hace el first-touch.
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            _Float16 *x_hilos = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+            _Float16 *y_hilos = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+
+            if (x_hilos == NULL || y_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                copiar_multihilo(n, y_hilos, y_inicial, hilos);
+
+                cronometro_arrancar(&cronometro);
+                axpy_multihilo(n, a, x_hilos, y_hilos, hilos, operacion);
+                cronometro_parar(&cronometro);
+            }
+            double tiempo_hilos = cronometro_imprimir(&cronometro);
+            printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(_Float16)) / tiempo_hilos / 1e9);
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    if (modo_lotes && modo_por_lotes() != 0) {
+        return EXIT_FAILURE;
+    }
 
     // Liberar memoria asignada
-    free(x);
-    free(y);
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de AXPY en el programa unificado (Programas/BENCH, ver registro.h): x son los n
+    primeros valores del driver e y los n siguientes, en _Float16. y se restaura antes de cada
+    vuelta. El kernel se escoge con cpuid ("auto").
+*/
+REGISTRO_TIPO(axpy_tipo, _Float16, (_Float16), (float))
+
+static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+    seleccionar_kernel_axpy("auto");
+    return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+}
+
+static void axpy_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    axpy(estado->n, 2.3752f16, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+static double axpy_flops(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double axpy_trafico(int64_t n) {
+    return 3.0 * (double)n;
+}
+
+static const registro_kernel_t registro_axpy = {
+    .kernel = "axpy",
+    .medida = "axpy",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &axpy_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = axpy_preparar,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = axpy_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = axpy_flops,
+    .elementos = axpy_trafico,
+};
+REGISTRO_KERNEL(registro_axpy)
+
+#endif /* BENCH_REGISTRO */
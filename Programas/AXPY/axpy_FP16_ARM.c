@@ -2,49 +2,421 @@
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
 #include <arm_fp16.h>
 
+#include "../common/include/cache_info.h"
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
 #define N_SMALL 5
 
 // Función AXPY
-void axpy(int n, __fp16 a, __fp16 *x, __fp16 *y) {
-    for (int i = 0; i < n; i++) {
+void axpy(int64_t n, __fp16 a, __fp16 *x, __fp16 *y) {
+    for (int64_t i = 0; i < n; i++) {
         y[i] = a * x[i] + y[i];
     }
 }
 
+/*
+    Función AXPY por lotes: y_b = alpha[b] * x_b + y_b para batch vectores independientes de n
+    elementos. Los vectores se guardan intercalados: el elemento i del vector b está en
+    i * stride + b (stride >= batch), de modo que el bucle interno recorre el lote con accesos
+    contiguos y se vectoriza a lo ancho del lote en lugar de a lo largo de vectores cortos.
+*/
+void axpy_batched(int batch, int n, const __fp16 *alpha, const __fp16 *x, __fp16 *y, int stride) {
+    for (int i = 0; i < n; i++) {
+        const __fp16 *xi = x + (size_t)i * stride;
+        __fp16 *yi = y + (size_t)i * stride;
+        #pragma omp simd
+        for (int b = 0; b < batch; b++) {
+            yi[b] = alpha[b] * xi[b] + yi[b];
+        }
+    }
+}
+
+// Tipo de las funciones AXPY (normal o streaming) que puede aplicar cada hilo
+typedef void (*axpy_kernel_t)(int64_t, __fp16, __fp16 *, __fp16 *);
+
+/*
+    Función AXPY del modo streaming. En x86 el resultado se escribe con stores no temporales
+    desde el registro; en ARM GCC no genera STNP (que además es solo una pista) desde C, así
+    que se usa el kernel normal y -s/-S solo cambian el informe de ancho de banda.
+*/
+void axpy_streaming(int64_t n, __fp16 a, __fp16 *x, __fp16 *y) {
+    axpy(n, a, x, y);
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(__fp16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Función AXPY multihilo: reparto estático de x e y, cada hilo aplica operacion sobre su bloque
+void axpy_multihilo(int64_t n, __fp16 a, __fp16 *x, __fp16 *y, int hilos, axpy_kernel_t operacion) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            operacion(fin - inicio, a, x + inicio, y + inicio);
+        }
+    }
+}
+
+/*
+    Copia paralela con el mismo reparto que axpy_multihilo. Cada hilo es el primero en escribir
+    (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, __fp16 *destino, const __fp16 *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(__fp16));
+        }
+    }
+}
+
+/*
+    Decide el modo streaming con -s. En x86 se mide cada kernel cuando x e y no caben en la LLC;
+    aquí axpy_streaming es el kernel normal, así que con -s no se activa nunca.
+*/
+int decidir_streaming(int64_t n, __fp16 *x, __fp16 *y, long tamanho_llc) {
+    (void)n;
+    (void)x;
+    (void)y;
+    (void)tamanho_llc;
+    return 0;
+}
+
+// Elementos procesados en cada medida del modo por lotes (batch * n * repeticiones)
+#define ELEMENTOS_POR_LOTES (1 << 22)
+
+// Elementos de y (todas las copias) que se restauran antes de cada tanda medida
+#define ELEMENTOS_COPIAS_LOTES (1 << 14)
+
+/*
+    Modo por lotes: barrido del número de lotes frente a la longitud de los vectores. En cada
+    combinación se compara un bucle de llamadas a axpy sobre vectores contiguos con una única
+    llamada a axpy_batched sobre los mismos datos intercalados, repitiendo ambas hasta procesar
+    unos ELEMENTOS_POR_LOTES elementos. Cada repetición parte de la y inicial, como las vueltas
+    del cronómetro en el modo normal: se guardan varias copias de y, se restauran fuera de la
+    medida y se mide una tanda de repeticiones seguidas, una por copia, para que el coste del
+    reloj no pese en los vectores cortos. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_por_lotes(void) {
+    static const int lotes[] = {1, 8, 64, 512, 4096};
+    static const int longitudes[] = {5, 8, 16, 32, 64};
+    const int num_lotes = (int)(sizeof(lotes) / sizeof(lotes[0]));
+    const int num_longitudes = (int)(sizeof(longitudes) / sizeof(longitudes[0]));
+
+    printf("Modo por lotes: lotes x longitud\n");
+
+    for (int l = 0; l < num_lotes; l++) {
+        for (int m = 0; m < num_longitudes; m++) {
+            int batch = lotes[l];
+            int n = longitudes[m];
+
+            // Paso entre filas redondeado a líneas de caché de 64 bytes
+            int elementos_linea = 64 / (int)sizeof(__fp16);
+            int stride = (batch + elementos_linea - 1) / elementos_linea * elementos_linea;
+
+            int repeticiones = ELEMENTOS_POR_LOTES / (batch * n);
+            if (repeticiones < 1) {
+                repeticiones = 1;
+            }
+
+            // Copias de y por tanda (al menos una y no más que las repeticiones)
+            int copias = ELEMENTOS_COPIAS_LOTES / (n * stride);
+            copias = copias < 1 ? 1 : (copias > repeticiones ? repeticiones : copias);
+            size_t elementos_contiguo = (size_t)batch * n;
+            size_t elementos_lotes = (size_t)n * stride;
+
+            __fp16 *alpha = (__fp16 *)malloc(batch * sizeof(__fp16));
+            __fp16 *x_contiguo = (__fp16 *)malloc(elementos_contiguo * sizeof(__fp16));
+            __fp16 *y_contiguo = (__fp16 *)malloc(elementos_contiguo * copias * sizeof(__fp16));
+            __fp16 *y_contiguo_inicial = (__fp16 *)malloc(elementos_contiguo * sizeof(__fp16));
+            __fp16 *x_lotes = (__fp16 *)calloc(elementos_lotes, sizeof(__fp16));
+            __fp16 *y_lotes = (__fp16 *)calloc(elementos_lotes * copias, sizeof(__fp16));
+            __fp16 *y_lotes_inicial = (__fp16 *)calloc(elementos_lotes, sizeof(__fp16));
+
+            if (alpha == NULL || x_contiguo == NULL || y_contiguo == NULL || y_contiguo_inicial == NULL ||
+                x_lotes == NULL || y_lotes == NULL || y_lotes_inicial == NULL) {
+                printf("Error al asignar memoria\n");
+                free(alpha);
+                free(x_contiguo);
+                free(y_contiguo);
+                free(y_contiguo_inicial);
+                free(x_lotes);
+                free(y_lotes);
+                free(y_lotes_inicial);
+                return -1;
+            }
+
+            // Mismos datos en ambas disposiciones: alpha en [0, 1], x e y en [-1, 1]
+            for (int b = 0; b < batch; b++) {
+                alpha[b] = (__fp16)aleatorio_siguiente();
+                ALEATORIO_RELLENAR(i, n, u, 2,
+                    x_contiguo[(size_t)b * n + i] = (__fp16)(2.0f * u[0] - 1.0f);
+                    y_contiguo_inicial[(size_t)b * n + i] = (__fp16)(2.0f * u[1] - 1.0f);
+                    x_lotes[(size_t)i * stride + b] = x_contiguo[(size_t)b * n + i];
+                    y_lotes_inicial[(size_t)i * stride + b] = y_contiguo_inicial[(size_t)b * n + i];
+                );
+            }
+
+            double tiempo_axpy = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_contiguo + c * elementos_contiguo, y_contiguo_inicial, elementos_contiguo * sizeof(__fp16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    __fp16 *y = y_contiguo + c * elementos_contiguo;
+                    for (int b = 0; b < batch; b++) {
+                        axpy(n, alpha[b], x_contiguo + (size_t)b * n, y + (size_t)b * n);
+                    }
+                }
+                tiempo_axpy += omp_get_wtime() - inicio;
+            }
+
+            double tiempo_lotes = 0.0;
+            for (int r = 0; r < repeticiones; r += copias) {
+                int tanda = (repeticiones - r < copias) ? repeticiones - r : copias;
+                for (int c = 0; c < tanda; c++) {
+                    memcpy(y_lotes + c * elementos_lotes, y_lotes_inicial, elementos_lotes * sizeof(__fp16));
+                }
+                double inicio = omp_get_wtime();
+                for (int c = 0; c < tanda; c++) {
+                    axpy_batched(batch, n, alpha, x_lotes, y_lotes + c * elementos_lotes, stride);
+                }
+                tiempo_lotes += omp_get_wtime() - inicio;
+            }
+
+            printf("Lotes: %d Longitud: %d Tiempo axpy: %f Tiempo axpy_batched: %f Speedup: %.2f\n",
+                   batch, n, tiempo_axpy, tiempo_lotes, tiempo_axpy / tiempo_lotes);
+
+            free(alpha);
+            free(x_contiguo);
+            free(y_contiguo);
+            free(y_contiguo_inicial);
+            free(x_lotes);
+            free(y_lotes);
+            free(y_lotes_inicial);
+        }
+    }
+    return 0;
+}
+
+/*
+    Modo barrido (--sweep): mide AXPY para cada tamaño de la lista en un único proceso. x e y se
+    reservan e inicializan una vez con el mayor tamaño y cada medida usa sus n primeros elementos,
+    partiendo siempre de la copia inicial de y. Con -s el kernel streaming se decide para cada
+    tamaño. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones, int modo_streaming) {
+    int64_t maximo = barrido->maximo;
+    __fp16 a = 2.3752f16;
+    long tamanho_llc = cache_tamanho_llc();
+
+    __fp16 *x = (__fp16 *)memoria_reservar(maximo * sizeof(__fp16));
+    __fp16 *y = (__fp16 *)memoria_reservar(maximo * sizeof(__fp16));
+    __fp16 *y_inicial = (__fp16 *)memoria_reservar(maximo * sizeof(__fp16));
+
+    if (x == NULL || y == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
+        x[i] = (__fp16)x_temp;
+        y[i] = (__fp16)y_temp;
+    );
+
+    memcpy(y_inicial, y, maximo * sizeof(__fp16));
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+        axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            memcpy(y, y_inicial, n * sizeof(__fp16));
+
+            cronometro_arrancar(&cronometro);
+            operacion(n, a, x, y);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "axpy", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)y[n-1], (float)y[n-1]);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
 int main(int argc, char *argv[]) {
         
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    int hilos_max = 0;
+    int modo_streaming = 0;
+    int modo_lotes = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -t <hilos>, -s, -S, -b, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpt:sSbw:r:H:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 's':
+                // Streaming si el conjunto de trabajo supera la LLC y es más rápido
+                modo_streaming = 1;
+                break;
+            case 'S':
+                // Streaming forzado
+                modo_streaming = 2;
+                break;
+            case 'b':
+                // Barrido de axpy_batched frente a axpy en bucle
+                modo_lotes = 1;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
         return EXIT_FAILURE;
-    }   
+    }
 
-    int n = -1;
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo y el AXPY sin lotes
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
 
-    n = atoi(argv[optind]);
+    if (barrido.num > 0 && modo_lotes) {
+        fprintf(stderr, "-b no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-b] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
 
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones, modo_streaming) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     __fp16 a = 2.3752f16;
     __fp16 *x_small = (__fp16 *)malloc(N_SMALL * sizeof(__fp16));
     __fp16 *y_small = (__fp16 *)malloc(N_SMALL * sizeof(__fp16));
@@ -56,15 +428,15 @@ int main(int argc, char *argv[]) {
 
     // Se usa una semilla proporcionada como argumento o una por defecto
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < N_SMALL; i++) {
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0;
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        float x_temp = u[0] * 10.0;
+        float y_temp = u[1] * 10.0;
         x_small[i] = (__fp16)x_temp;
         y_small[i] = (__fp16)y_temp;
-    }
+    );
 
     printf("Array x_small: [ ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -88,48 +460,92 @@ int main(int argc, char *argv[]) {
     free(y_small);
 
 
-    __fp16 *x = (__fp16 *)malloc(n * sizeof(__fp16));
-    __fp16 *y = (__fp16 *)malloc(n * sizeof(__fp16));
+    __fp16 *x = (__fp16 *)memoria_reservar(n * sizeof(__fp16));
+    __fp16 *y = (__fp16 *)memoria_reservar(n * sizeof(__fp16));
 
     if (x == NULL || y == NULL) {
         printf("Error al asignar memoria\n");
         return EXIT_FAILURE;
     }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
 
     
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < n; i++) {
-        float x_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
-        float y_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
         x[i] = (__fp16)x_temp;
         y[i] = (__fp16)y_temp;
+    );
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "axpy", NULL, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
     }
 
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)x[i]);
         }
         printf("\n"); 
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)x[i]);
+        }
+    }
 
 
-    //Para medir el tiempo de ejecución
-    
-    clock_t start, end;
-    double cpu_time_used;
+    // Copia de y previa a la operación para las repeticiones y el modo multihilo
+    __fp16 *y_inicial = NULL;
+    if (hilos_max > 0 || calentamiento + repeticiones > 1) {
+        y_inicial = (__fp16 *)memoria_reservar(n * sizeof(__fp16));
+        if (y_inicial == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+        memcpy(y_inicial, y, n * sizeof(__fp16));
+    }
 
-    start = clock();
-    
-    ////    Código del programa cuyo tiempo quiero medir
-    
-    // Se ejecuta la operación AXPY
-    axpy(n, a, x, y);
+    // Modo streaming: forzado (-S) o, con -s, solo si compensa (ver decidir_streaming)
+    long tamanho_llc = cache_tamanho_llc();
+    double conjunto_trabajo = 2.0 * n * sizeof(__fp16);
+    int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && decidir_streaming(n, x, y, tamanho_llc));
+    axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+    if (modo_streaming) {
+        printf("Modo streaming: %s (conjunto de trabajo %.0f bytes, LLC %ld bytes)\n",
+               usar_streaming ? "activado" : "desactivado", conjunto_trabajo, tamanho_llc);
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    cronometro_t cronometro;
+    double tiempo;
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo y, de modo que el resultado es el de una sola llamada
+        if (y_inicial != NULL) {
+            memcpy(y, y_inicial, n * sizeof(__fp16));
+        }
+
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación AXPY
+        operacion(n, a, x, y);
+        cronometro_parar(&cronometro);
+    }
+
+    tiempo = cronometro_imprimir(&cronometro);
+    if (modo_streaming) {
+        printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(__fp16)) / tiempo / 1e9);
+    }
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
@@ -137,15 +553,125 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)y[i]);
         }
         printf("\n");    
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)y[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se mide AXPY con 1, 2, 4, ... hasta hilos_max hilos. Para cada número de
+        hilos se crean copias de x e y inicializadas en paralelo con el mismo reparto estático que
+        la operación, de modo que cada hilo trabaja sobre páginas ubicadas en su nodo NUMA.
+        Cada vuelta vuelve a copiar y en paralelo, por lo que solo la primera hace el first-touch.
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            __fp16 *x_hilos = (__fp16 *)memoria_reservar(n * sizeof(__fp16));
+            __fp16 *y_hilos = (__fp16 *)memoria_reservar(n * sizeof(__fp16));
+
+            if (x_hilos == NULL || y_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                copiar_multihilo(n, y_hilos, y_inicial, hilos);
+
+                cronometro_arrancar(&cronometro);
+                axpy_multihilo(n, a, x_hilos, y_hilos, hilos, operacion);
+                cronometro_parar(&cronometro);
+            }
+            double tiempo_hilos = cronometro_imprimir(&cronometro);
+            printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(__fp16)) / tiempo_hilos / 1e9);
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    if (modo_lotes && modo_por_lotes() != 0) {
+        return EXIT_FAILURE;
+    }
 
     // Liberar memoria asignada
-    free(x);
-    free(y);
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de AXPY en el programa unificado (Programas/BENCH, ver registro.h): x son los n
+    primeros valores del driver e y los n siguientes, en __fp16. y se restaura antes de cada
+    vuelta.
+*/
+REGISTRO_TIPO(axpy_tipo, __fp16, (__fp16), (float))
+
+static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+    return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+}
+
+static void axpy_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    axpy(estado->n, 2.3752f16, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+static double axpy_flops(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double axpy_trafico(int64_t n) {
+    return 3.0 * (double)n;
+}
+
+static const registro_kernel_t registro_axpy = {
+    .kernel = "axpy",
+    .medida = "axpy",
+    .tipo = "FP16_ARM",
+    .bytes_elemento = sizeof(__fp16),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = axpy_preparar,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = axpy_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = axpy_flops,
+    .elementos = axpy_trafico,
+};
+REGISTRO_KERNEL(registro_axpy)
+
+#endif /* BENCH_REGISTRO */
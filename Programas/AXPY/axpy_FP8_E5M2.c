@@ -0,0 +1,684 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/cache_info.h"
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+#include "../common/include/fp8.h"
+
+
+#define N_SMALL 5
+
+// Bytes de y que se calculan en un buffer en L1 antes de escribirlos con stores no temporales
+#define BLOQUE_STREAMING 1024
+
+// Número de elementos FP8 que se ensanchan a un registro float de 256 bits
+#define LANES_AVX2 8
+// Número de elementos FP8 que se ensanchan a un registro float de 512 bits
+#define LANES_AVX512 16
+
+/*
+    Función AXPY (versión escalar, empleada como referencia y como fallback).
+    Se decodifica con la tabla de 256 entradas, se calcula en float y el resultado
+    se redondea una sola vez a E5M2.
+*/
+void axpy_escalar(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y) {
+    float af = fp8_e5m2_a_float(a);
+    for (int64_t i = 0; i < n; i++) {
+        y[i] = float_a_fp8_e5m2(__builtin_fmaf(af, fp8_e5m2_a_float(x[i]), fp8_e5m2_a_float(y[i])));
+    }
+}
+
+#ifdef __x86_64__
+/*
+    Función AXPY vectorial con AVX2, F16C y FMA (16 elementos por iteración).
+    Los códigos E5M2 se ensanchan a float pasando por binary16 (vcvtph2ps), el cálculo se hace
+    con vfmadd y el estrechamiento usa el mismo redondeo que la versión escalar, por lo que
+    ambas producen resultados idénticos bit a bit.
+*/
+__attribute__((target("avx2,fma,f16c")))
+void axpy_avx2(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y) {
+    __m256 va = _mm256_set1_ps(fp8_e5m2_a_float(a));
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX2 <= n; i += 2 * LANES_AVX2) {
+        __m128i x8 = _mm_loadu_si128((const __m128i *)(x + i));
+        __m128i y8 = _mm_loadu_si128((const __m128i *)(y + i));
+        __m256 vx0 = fp8_e5m2_a_float_avx2(x8);
+        __m256 vx1 = fp8_e5m2_a_float_avx2(_mm_srli_si128(x8, 8));
+        __m256 vy0 = fp8_e5m2_a_float_avx2(y8);
+        __m256 vy1 = fp8_e5m2_a_float_avx2(_mm_srli_si128(y8, 8));
+        __m128i r0 = float_a_fp8_e5m2_avx2(_mm256_fmadd_ps(va, vx0, vy0));
+        __m128i r1 = float_a_fp8_e5m2_avx2(_mm256_fmadd_ps(va, vx1, vy1));
+        _mm_storeu_si128((__m128i *)(y + i), _mm_unpacklo_epi64(r0, r1));
+    }
+
+    // Cola escalar con la misma conversión y redondeo que la parte vectorial
+    float af = fp8_e5m2_a_float(a);
+    for (; i < n; i++) {
+        y[i] = float_a_fp8_e5m2(__builtin_fmaf(af, fp8_e5m2_a_float(x[i]), fp8_e5m2_a_float(y[i])));
+    }
+}
+
+/*
+    Función AXPY vectorial con AVX-512 (32 elementos por iteración), con el mismo esquema que
+    axpy_avx2: ensanchamiento por binary16, vfmadd en float y estrechamiento con vpmovwb.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,fma,f16c")))
+void axpy_avx512(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y) {
+    __m512 va = _mm512_set1_ps(fp8_e5m2_a_float(a));
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX512 <= n; i += 2 * LANES_AVX512) {
+        __m512 vx0 = fp8_e5m2_a_float_avx512(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m512 vx1 = fp8_e5m2_a_float_avx512(_mm_loadu_si128((const __m128i *)(x + i + LANES_AVX512)));
+        __m512 vy0 = fp8_e5m2_a_float_avx512(_mm_loadu_si128((const __m128i *)(y + i)));
+        __m512 vy1 = fp8_e5m2_a_float_avx512(_mm_loadu_si128((const __m128i *)(y + i + LANES_AVX512)));
+        _mm_storeu_si128((__m128i *)(y + i), float_a_fp8_e5m2_avx512(_mm512_fmadd_ps(va, vx0, vy0)));
+        _mm_storeu_si128((__m128i *)(y + i + LANES_AVX512), float_a_fp8_e5m2_avx512(_mm512_fmadd_ps(va, vx1, vy1)));
+    }
+
+    // Cola con el kernel AVX2, que termina a su vez con el bucle escalar
+    axpy_avx2(n - i, a, x + i, y + i);
+}
+#endif
+
+// Kernel AXPY seleccionado en tiempo de ejecución
+typedef void (*axpy_kernel_t)(int64_t, fp8_e5m2_t, fp8_e5m2_t *, fp8_e5m2_t *);
+
+static axpy_kernel_t axpy_kernel = axpy_escalar;
+static const char *axpy_kernel_nombre = "escalar";
+
+/*
+    Función para escoger el kernel AXPY según las extensiones que la CPU indica mediante cpuid.
+    x86 no tiene aritmética FP8 nativa: con "auto" se usa la variante vectorial más ancha
+    disponible (AVX-512 o AVX2) y, si no, el bucle escalar.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_axpy(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+    int soporta_avx512 = soporta_avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                         __builtin_cpu_supports("avx512vl");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512 ? "avx512" : (soporta_avx2 ? "avx2" : "escalar");
+    }
+    if (strcmp(pedido, "avx512") == 0 && soporta_avx512) {
+        axpy_kernel = axpy_avx512;
+        axpy_kernel_nombre = "avx512";
+        return 0;
+    }
+    if (strcmp(pedido, "avx2") == 0 && soporta_avx2) {
+        axpy_kernel = axpy_avx2;
+        axpy_kernel_nombre = "avx2";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        axpy_kernel = axpy_escalar;
+        axpy_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Función AXPY
+void axpy(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y) {
+    axpy_kernel(n, a, x, y);
+}
+
+/*
+    Función AXPY con stores no temporales para conjuntos de trabajo mayores que la LLC. Cada bloque
+    de BLOQUE_STREAMING bytes se calcula con axpy sobre un buffer alineado (residente en L1) y se
+    escribe en y con movntdq, de modo que las líneas de y no se quedan en la jerarquía de caché.
+    Como y se lee antes de escribirse no se ahorra tráfico de lectura: el objetivo es no
+    contaminar la LLC. En arquitecturas sin stores no temporales se mantiene solo el bloqueo.
+*/
+void axpy_streaming(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y) {
+    const int elementos_bloque = BLOQUE_STREAMING / (int)sizeof(fp8_e5m2_t);
+    fp8_e5m2_t bloque[BLOQUE_STREAMING / sizeof(fp8_e5m2_t)] __attribute__((aligned(64)));
+    int64_t i = 0;
+
+    // Elementos iniciales hasta que y queda alineado a 16 bytes, requisito de movntdq
+    int cabecera = (int)((16 - ((uintptr_t)y & 15)) & 15) / (int)sizeof(fp8_e5m2_t);
+    if (cabecera > n) {
+        cabecera = n;
+    }
+    axpy(cabecera, a, x, y);
+    i = cabecera;
+
+    for (; i + elementos_bloque <= n; i += elementos_bloque) {
+        memcpy(bloque, y + i, BLOQUE_STREAMING);
+        axpy(elementos_bloque, a, x + i, bloque);
+
+#ifdef __x86_64__
+        for (int byte = 0; byte < BLOQUE_STREAMING; byte += 16) {
+            _mm_stream_si128((__m128i *)((char *)(y + i) + byte),
+                             _mm_load_si128((const __m128i *)((const char *)bloque + byte)));
+        }
+#else
+        memcpy(y + i, bloque, BLOQUE_STREAMING);
+#endif
+    }
+
+    // Cola con el kernel normal
+    axpy(n - i, a, x + i, y + i);
+
+#ifdef __x86_64__
+    // Los stores no temporales no están ordenados con el resto: se drenan antes de volver
+    _mm_sfence();
+#endif
+}
+
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(fp8_e5m2_t);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Función AXPY multihilo: reparto estático de x e y, cada hilo aplica operacion sobre su bloque
+void axpy_multihilo(int64_t n, fp8_e5m2_t a, fp8_e5m2_t *x, fp8_e5m2_t *y, int hilos, axpy_kernel_t operacion) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            operacion(fin - inicio, a, x + inicio, y + inicio);
+        }
+    }
+}
+
+/*
+    Copia paralela con el mismo reparto que axpy_multihilo. Cada hilo es el primero en escribir
+    (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, fp8_e5m2_t *destino, const fp8_e5m2_t *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(fp8_e5m2_t));
+        }
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide AXPY para cada tamaño de la lista en un único proceso. x e y se
+    reservan e inicializan una vez con el mayor tamaño y cada medida usa sus n primeros elementos,
+    partiendo siempre de la copia inicial de y. Con -s el kernel streaming se decide para cada
+    tamaño. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones, int modo_streaming) {
+    int64_t maximo = barrido->maximo;
+    fp8_e5m2_t a = float_a_fp8_e5m2(2.3752f);
+    long tamanho_llc = cache_tamanho_llc();
+
+    fp8_e5m2_t *x = (fp8_e5m2_t *)memoria_reservar(maximo * sizeof(fp8_e5m2_t));
+    fp8_e5m2_t *y = (fp8_e5m2_t *)memoria_reservar(maximo * sizeof(fp8_e5m2_t));
+    fp8_e5m2_t *y_inicial = (fp8_e5m2_t *)memoria_reservar(maximo * sizeof(fp8_e5m2_t));
+
+    if (x == NULL || y == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
+        x[i] = float_a_fp8_e5m2(x_temp);
+        y[i] = float_a_fp8_e5m2(y_temp);
+    );
+
+    memcpy(y_inicial, y, maximo * sizeof(fp8_e5m2_t));
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && 2.0 * n * sizeof(fp8_e5m2_t) > tamanho_llc);
+        axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            memcpy(y, y_inicial, n * sizeof(fp8_e5m2_t));
+
+            cronometro_arrancar(&cronometro);
+            operacion(n, a, x, y);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "axpy", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", fp8_e5m2_a_float(y[n-1]), fp8_e5m2_a_float(y[n-1]));
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
+int main(int argc, char *argv[]) {
+    
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    int modo_streaming = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -s, -S, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:sSw:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 's':
+                // Streaming solo si el conjunto de trabajo supera la LLC
+                modo_streaming = 1;
+                break;
+            case 'S':
+                // Streaming forzado
+                modo_streaming = 2;
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-k auto|escalar|avx2|avx512] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-s|-S] [-k auto|escalar|avx2|avx512] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Tablas de decodificación FP8 empleadas por los kernels
+    fp8_inicializar_tablas();
+
+    if (seleccionar_kernel_axpy(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel AXPY no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel AXPY: %s\n", axpy_kernel_nombre);
+
+    // Modo streaming: se activa si se fuerza (-S) o si x e y juntos no caben en la LLC (-s)
+    long tamanho_llc = cache_tamanho_llc();
+    double conjunto_trabajo = 2.0 * n * sizeof(fp8_e5m2_t);
+    int usar_streaming = modo_streaming == 2 || (modo_streaming == 1 && conjunto_trabajo > tamanho_llc);
+    axpy_kernel_t operacion = usar_streaming ? axpy_streaming : axpy;
+    if (modo_streaming) {
+        printf("Modo streaming: %s (conjunto de trabajo %.0f bytes, LLC %ld bytes)\n",
+               usar_streaming ? "activado" : "desactivado", conjunto_trabajo, tamanho_llc);
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones, modo_streaming) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    fp8_e5m2_t a = float_a_fp8_e5m2(2.3752f);
+    fp8_e5m2_t *x_small = (fp8_e5m2_t *)malloc(N_SMALL * sizeof(fp8_e5m2_t));
+    fp8_e5m2_t *y_small = (fp8_e5m2_t *)malloc(N_SMALL * sizeof(fp8_e5m2_t));
+
+    if (x_small == NULL || y_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        float x_temp = u[0] * 10.0;
+        float y_temp = u[1] * 10.0;
+        x_small[i] = float_a_fp8_e5m2(x_temp);
+        y_small[i] = float_a_fp8_e5m2(y_temp);
+    );
+
+    printf("Array x_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", fp8_e5m2_a_float(x_small[i]));
+    }
+    printf("]\nArray y_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", fp8_e5m2_a_float(y_small[i]));
+    }
+
+    // Se ejecuta la operación AXPY
+    axpy(N_SMALL, a, x_small, y_small);
+
+    printf("]\nArray y_small despues de AXPY: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", fp8_e5m2_a_float(y_small[i]));
+    }
+    printf("]\n");
+
+    free(x_small);
+    free(y_small);
+
+
+    fp8_e5m2_t *x = (fp8_e5m2_t *)memoria_reservar(n * sizeof(fp8_e5m2_t));
+    fp8_e5m2_t *y = (fp8_e5m2_t *)memoria_reservar(n * sizeof(fp8_e5m2_t));
+
+    if (x == NULL || y == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        float x_temp = u[0] * 10.0f;
+        float y_temp = u[1] * 10.0f;
+        x[i] = float_a_fp8_e5m2(x_temp);
+        y[i] = float_a_fp8_e5m2(y_temp);
+    );
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "fp8_e5m2", "axpy", axpy_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", fp8_e5m2_a_float(x[i]));
+        }
+        printf("\n"); 
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, fp8_e5m2_a_float(x[i]));
+        }
+    }
+
+
+    // Copia de y previa a la operación para las repeticiones y el modo multihilo
+    fp8_e5m2_t *y_inicial = NULL;
+    if (hilos_max > 0 || calentamiento + repeticiones > 1) {
+        y_inicial = (fp8_e5m2_t *)memoria_reservar(n * sizeof(fp8_e5m2_t));
+        if (y_inicial == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+        memcpy(y_inicial, y, n * sizeof(fp8_e5m2_t));
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+    double tiempo;
+
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo y, de modo que el resultado es el de una sola llamada
+        if (y_inicial != NULL) {
+            memcpy(y, y_inicial, n * sizeof(fp8_e5m2_t));
+        }
+
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación AXPY
+        operacion(n, a, x, y);
+        cronometro_parar(&cronometro);
+    }
+
+    tiempo = cronometro_imprimir(&cronometro);
+    if (modo_streaming) {
+        printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(fp8_e5m2_t)) / tiempo / 1e9);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", fp8_e5m2_a_float(y[n-1]), fp8_e5m2_a_float(y[n-1]));
+
+    if(verbose){
+        printf("Resultados ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", fp8_e5m2_a_float(y[i]));
+        }
+        printf("\n");    
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, fp8_e5m2_a_float(y[i]));
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+    
+    /*
+        Modo multihilo: se mide AXPY con 1, 2, 4, ... hasta hilos_max hilos. Para cada número de
+        hilos se crean copias de x e y inicializadas en paralelo con el mismo reparto estático que
+        la operación, de modo que cada hilo trabaja sobre páginas ubicadas en su nodo NUMA.
+        Cada vuelta vuelve a copiar y en paralelo, por lo que solo la primera hace el first-touch.
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            fp8_e5m2_t *x_hilos = (fp8_e5m2_t *)memoria_reservar(n * sizeof(fp8_e5m2_t));
+            fp8_e5m2_t *y_hilos = (fp8_e5m2_t *)memoria_reservar(n * sizeof(fp8_e5m2_t));
+
+            if (x_hilos == NULL || y_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                copiar_multihilo(n, y_hilos, y_inicial, hilos);
+
+                cronometro_arrancar(&cronometro);
+                axpy_multihilo(n, a, x_hilos, y_hilos, hilos, operacion);
+                cronometro_parar(&cronometro);
+            }
+            double tiempo_hilos = cronometro_imprimir(&cronometro);
+            printf("Ancho de banda: %f GB/s\n", (3.0 * n * sizeof(fp8_e5m2_t)) / tiempo_hilos / 1e9);
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    // Liberar memoria asignada
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+
+    return EXIT_SUCCESS;
+}
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de AXPY en el programa unificado (Programas/BENCH, ver registro.h): x son los n
+    primeros valores del driver e y los n siguientes, en E5M2. y se restaura antes de cada vuelta.
+    El kernel se escoge con cpuid ("auto").
+*/
+REGISTRO_TIPO(axpy_tipo, fp8_e5m2_t, float_a_fp8_e5m2, fp8_e5m2_a_float)
+
+// a se convierte al preparar, cuando ya están las tablas de fp8_inicializar_tablas
+static fp8_e5m2_t axpy_a;
+
+static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+    fp8_inicializar_tablas();
+    seleccionar_kernel_axpy("auto");
+    axpy_a = float_a_fp8_e5m2(2.3752f);
+    return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+}
+
+static void axpy_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    axpy(estado->n, axpy_a, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+static double axpy_flops(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double axpy_trafico(int64_t n) {
+    return 3.0 * (double)n;
+}
+
+static const registro_kernel_t registro_axpy = {
+    .kernel = "axpy",
+    .medida = "axpy",
+    .tipo = "FP8_E5M2",
+    .bytes_elemento = sizeof(fp8_e5m2_t),
+    .implementacion = &axpy_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = axpy_preparar,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = axpy_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = axpy_flops,
+    .elementos = axpy_trafico,
+};
+REGISTRO_KERNEL(registro_axpy)
+
+#endif /* BENCH_REGISTRO */
@@ -0,0 +1,671 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
+#include "../common/include/mx.h"
+
+#define N_SMALL 5
+
+// Número de elementos que se ensanchan a un registro float de 256 y de 512 bits
+#define LANES_AVX2 8
+#define LANES_AVX512 16
+
+/*
+    Función AXPY fusionada sobre bloques MXFP8 (versión escalar, empleada como referencia y como
+    fallback). Cada bloque se decodifica a float, se calcula a*x + y con una FMA por elemento y
+    el resultado se vuelve a cuantizar con una nueva escala compartida calculada a partir de su
+    máximo. n es el número de bloques; a se mantiene en float porque el escalado por bloques
+    solo se aplica a los vectores.
+*/
+void axpy_escalar(int64_t n, float a, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y) {
+    float vx[MX_BLOQUE], vy[MX_BLOQUE];
+
+    for (int64_t b = 0; b < n; b++) {
+        mxfp8_e4m3_decodificar_bloque(&x[b], vx);
+        mxfp8_e4m3_decodificar_bloque(&y[b], vy);
+        for (int k = 0; k < MX_BLOQUE; k++) {
+            vy[k] = __builtin_fmaf(a, vx[k], vy[k]);
+        }
+        mxfp8_e4m3_codificar_bloque(vy, &y[b]);
+    }
+}
+
+#ifdef __x86_64__
+/*
+    Función AXPY fusionada con AVX2, F16C y FMA: cada bloque de 32 elementos ocupa cuatro
+    registros de 8 floats. Se decodifica (FP8 -> float por binary16 y producto por la escala),
+    se calcula con vfmadd, se obtiene el máximo absoluto del bloque para su nueva escala y se
+    codifica de nuevo sin salir de los registros. Coincide bit a bit con la versión escalar.
+*/
+__attribute__((target("avx2,fma,f16c")))
+void axpy_avx2(int64_t n, float a, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y) {
+    __m256 va = _mm256_set1_ps(a);
+
+    for (int64_t b = 0; b < n; b++) {
+        __m256 escala_x = _mm256_set1_ps(mx_escala_a_float(x[b].escala));
+        __m256 escala_y = _mm256_set1_ps(mx_escala_a_float(y[b].escala));
+        __m128i x16[2], y16[2];
+        __m256 r[4];
+
+        x16[0] = _mm_loadu_si128((const __m128i *)x[b].elementos);
+        x16[1] = _mm_loadu_si128((const __m128i *)(x[b].elementos + 16));
+        y16[0] = _mm_loadu_si128((const __m128i *)y[b].elementos);
+        y16[1] = _mm_loadu_si128((const __m128i *)(y[b].elementos + 16));
+
+        for (int j = 0; j < 4; j++) {
+            __m128i cx = (j & 1) ? _mm_srli_si128(x16[j / 2], 8) : x16[j / 2];
+            __m128i cy = (j & 1) ? _mm_srli_si128(y16[j / 2], 8) : y16[j / 2];
+            __m256 vx = _mm256_mul_ps(fp8_e4m3_a_float_avx2(cx), escala_x);
+            __m256 vy = _mm256_mul_ps(fp8_e4m3_a_float_avx2(cy), escala_y);
+            r[j] = _mm256_fmadd_ps(va, vx, vy);
+        }
+
+        __m256 max_abs = _mm256_max_ps(_mm256_max_ps(mx_abs_avx2(r[0]), mx_abs_avx2(r[1])),
+                                       _mm256_max_ps(mx_abs_avx2(r[2]), mx_abs_avx2(r[3])));
+        uint8_t escala = mx_calcular_escala(mx_maximo_avx2(max_abs), MXFP8_E4M3_EMAX);
+        __m256 inversa = _mm256_set1_ps(mx_escala_inversa(escala));
+
+        __m128i c0 = float_a_fp8_e4m3_avx2(_mm256_mul_ps(r[0], inversa));
+        __m128i c1 = float_a_fp8_e4m3_avx2(_mm256_mul_ps(r[1], inversa));
+        __m128i c2 = float_a_fp8_e4m3_avx2(_mm256_mul_ps(r[2], inversa));
+        __m128i c3 = float_a_fp8_e4m3_avx2(_mm256_mul_ps(r[3], inversa));
+        y[b].escala = escala;
+        _mm_storeu_si128((__m128i *)y[b].elementos, _mm_unpacklo_epi64(c0, c1));
+        _mm_storeu_si128((__m128i *)(y[b].elementos + 16), _mm_unpacklo_epi64(c2, c3));
+    }
+}
+
+/*
+    Función AXPY fusionada con AVX-512: mismo esquema que axpy_avx2 con dos registros
+    de 16 floats por bloque y la reducción del máximo con vmaxps horizontal.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,fma,f16c")))
+void axpy_avx512(int64_t n, float a, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y) {
+    __m512 va = _mm512_set1_ps(a);
+
+    for (int64_t b = 0; b < n; b++) {
+        __m512 escala_x = _mm512_set1_ps(mx_escala_a_float(x[b].escala));
+        __m512 escala_y = _mm512_set1_ps(mx_escala_a_float(y[b].escala));
+
+        __m512 vx0 = _mm512_mul_ps(fp8_e4m3_a_float_avx512(_mm_loadu_si128((const __m128i *)x[b].elementos)), escala_x);
+        __m512 vx1 = _mm512_mul_ps(fp8_e4m3_a_float_avx512(_mm_loadu_si128((const __m128i *)(x[b].elementos + LANES_AVX512))), escala_x);
+        __m512 vy0 = _mm512_mul_ps(fp8_e4m3_a_float_avx512(_mm_loadu_si128((const __m128i *)y[b].elementos)), escala_y);
+        __m512 vy1 = _mm512_mul_ps(fp8_e4m3_a_float_avx512(_mm_loadu_si128((const __m128i *)(y[b].elementos + LANES_AVX512))), escala_y);
+        __m512 r0 = _mm512_fmadd_ps(va, vx0, vy0);
+        __m512 r1 = _mm512_fmadd_ps(va, vx1, vy1);
+
+        float max_abs = _mm512_reduce_max_ps(_mm512_max_ps(_mm512_abs_ps(r0), _mm512_abs_ps(r1)));
+        uint8_t escala = mx_calcular_escala(max_abs, MXFP8_E4M3_EMAX);
+        __m512 inversa = _mm512_set1_ps(mx_escala_inversa(escala));
+
+        y[b].escala = escala;
+        _mm_storeu_si128((__m128i *)y[b].elementos, float_a_fp8_e4m3_avx512(_mm512_mul_ps(r0, inversa)));
+        _mm_storeu_si128((__m128i *)(y[b].elementos + LANES_AVX512), float_a_fp8_e4m3_avx512(_mm512_mul_ps(r1, inversa)));
+    }
+}
+#endif
+
+// Kernel AXPY seleccionado en tiempo de ejecución
+typedef void (*axpy_kernel_t)(int64_t, float, mxfp8_e4m3_t *, mxfp8_e4m3_t *);
+
+static axpy_kernel_t axpy_kernel = axpy_escalar;
+static const char *axpy_kernel_nombre = "escalar";
+
+/*
+    Función para escoger el kernel AXPY según las extensiones que la CPU indica mediante cpuid.
+    x86 no tiene aritmética MX nativa: con "auto" se usa la variante vectorial más ancha
+    disponible (AVX-512 o AVX2) y, si no, el bucle escalar.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_axpy(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+    int soporta_avx512 = soporta_avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                         __builtin_cpu_supports("avx512vl");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512 ? "avx512" : (soporta_avx2 ? "avx2" : "escalar");
+    }
+    if (strcmp(pedido, "avx512") == 0 && soporta_avx512) {
+        axpy_kernel = axpy_avx512;
+        axpy_kernel_nombre = "avx512";
+        return 0;
+    }
+    if (strcmp(pedido, "avx2") == 0 && soporta_avx2) {
+        axpy_kernel = axpy_avx2;
+        axpy_kernel_nombre = "avx2";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        axpy_kernel = axpy_escalar;
+        axpy_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Función AXPY (n es el número de bloques)
+void axpy(int64_t n, float a, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y) {
+    axpy_kernel(n, a, x, y);
+}
+
+/*
+    Genera n elementos aleatorios entre 0 y 10 para x e y con la misma secuencia que el resto
+    de programas AXPY (x e y intercalados) y los cuantiza bloque a bloque (el relleno vale 0).
+    Cada bloque toma sus valores de la secuencia por posición (ver aleatorio.h), así que los
+    bloques se reparten entre los hilos salvo con --rand-libc.
+*/
+void generar_vectores(int64_t n, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y) {
+    uint64_t inicio = aleatorio_reservar(2 * (uint64_t)n);
+
+    #pragma omp parallel for schedule(static) if (!aleatorio_libc)
+    for (int64_t b = 0; b < mx_num_bloques(n); b++) {
+        float u[2 * MX_BLOQUE], vx[MX_BLOQUE], vy[MX_BLOQUE];
+        int64_t validos = n - b * MX_BLOQUE < MX_BLOQUE ? n - b * MX_BLOQUE : MX_BLOQUE;
+
+        aleatorio_generar(inicio + 2 * (uint64_t)b * MX_BLOQUE, 2 * validos, u);
+        for (int k = 0; k < MX_BLOQUE; k++) {
+            vx[k] = 0.0f;
+            vy[k] = 0.0f;
+            if (k < validos) {
+                vx[k] = u[2 * k] * 10.0f;
+                vy[k] = u[2 * k + 1] * 10.0f;
+            }
+        }
+        mxfp8_e4m3_codificar_bloque(vx, &x[b]);
+        mxfp8_e4m3_codificar_bloque(vy, &y[b]);
+    }
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, en bloques MX completos
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    *inicio = n * id / hilos;
+    *fin = n * (id + 1) / hilos;
+}
+
+// Función AXPY multihilo: reparto estático de los bloques de x e y, cada hilo aplica axpy sobre su parte
+void axpy_multihilo(int64_t n, float a, mxfp8_e4m3_t *x, mxfp8_e4m3_t *y, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            axpy(fin - inicio, a, x + inicio, y + inicio);
+        }
+    }
+}
+
+/*
+    Copia paralela con el mismo reparto que axpy_multihilo. Cada hilo es el primero en escribir
+    (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, mxfp8_e4m3_t *destino, const mxfp8_e4m3_t *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(mxfp8_e4m3_t));
+        }
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide AXPY para cada tamaño de la lista en un único proceso. x e y se
+    reservan e inicializan una vez con el mayor tamaño y cada medida usa los bloques que cubren
+    sus n primeros elementos, partiendo siempre de la copia inicial de y. Devuelve -1 si falla la
+    reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    int64_t maximo = barrido->maximo;
+    float a = 2.3752f;
+    int64_t bloques_maximo = mx_num_bloques(maximo);
+
+    mxfp8_e4m3_t *x = (mxfp8_e4m3_t *)memoria_reservar(bloques_maximo * sizeof(mxfp8_e4m3_t));
+    mxfp8_e4m3_t *y = (mxfp8_e4m3_t *)memoria_reservar(bloques_maximo * sizeof(mxfp8_e4m3_t));
+    mxfp8_e4m3_t *y_inicial = (mxfp8_e4m3_t *)memoria_reservar(bloques_maximo * sizeof(mxfp8_e4m3_t));
+
+    if (x == NULL || y == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    generar_vectores(maximo, x, y);
+
+    memcpy(y_inicial, y, bloques_maximo * sizeof(mxfp8_e4m3_t));
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        int64_t bloques = mx_num_bloques(n);
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            memcpy(y, y_inicial, bloques * sizeof(mxfp8_e4m3_t));
+
+            cronometro_arrancar(&cronometro);
+            axpy(bloques, a, x, y);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "axpy", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", mxfp8_e4m3_a_float(y, n-1), mxfp8_e4m3_a_float(y, n-1));
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|avx2|avx512] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|avx2|avx512] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Tablas de decodificación FP8 empleadas por los kernels
+    fp8_inicializar_tablas();
+
+    if (seleccionar_kernel_axpy(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel AXPY no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel AXPY: %s\n", axpy_kernel_nombre);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    int bloques_small = mx_num_bloques(N_SMALL);
+    int64_t bloques = mx_num_bloques(n);
+
+    float a = 2.3752f;
+    mxfp8_e4m3_t *x_small = (mxfp8_e4m3_t *)malloc(bloques_small * sizeof(mxfp8_e4m3_t));
+    mxfp8_e4m3_t *y_small = (mxfp8_e4m3_t *)malloc(bloques_small * sizeof(mxfp8_e4m3_t));
+
+    if (x_small == NULL || y_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Generar elementos aleatorios entre 0 y 10
+    generar_vectores(N_SMALL, x_small, y_small);
+
+    printf("Array x_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", mxfp8_e4m3_a_float(x_small, i));
+    }
+    printf("]\nArray y_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", mxfp8_e4m3_a_float(y_small, i));
+    }
+
+    // Se ejecuta la operación AXPY
+    axpy(bloques_small, a, x_small, y_small);
+
+    printf("]\nArray y_small despues de AXPY: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", mxfp8_e4m3_a_float(y_small, i));
+    }
+    printf("]\n");
+
+    free(x_small);
+    free(y_small);
+
+
+    mxfp8_e4m3_t *x = (mxfp8_e4m3_t *)memoria_reservar(bloques * sizeof(mxfp8_e4m3_t));
+    mxfp8_e4m3_t *y = (mxfp8_e4m3_t *)memoria_reservar(bloques * sizeof(mxfp8_e4m3_t));
+
+    if (x == NULL || y == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+
+    // Generar elementos aleatorios entre 0 y 10
+    generar_vectores(n, x, y);
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "mxfp8_e4m3", "axpy", axpy_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", mxfp8_e4m3_a_float(x, i));
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, mxfp8_e4m3_a_float(x, i));
+        }
+    }
+
+
+    // Copia de y previa a la operación para las repeticiones y el modo multihilo
+    mxfp8_e4m3_t *y_inicial = NULL;
+    if (hilos_max > 0 || calentamiento + repeticiones > 1) {
+        y_inicial = (mxfp8_e4m3_t *)memoria_reservar(bloques * sizeof(mxfp8_e4m3_t));
+        if (y_inicial == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+        memcpy(y_inicial, y, bloques * sizeof(mxfp8_e4m3_t));
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo y, de modo que el resultado es el de una sola llamada
+        if (y_inicial != NULL) {
+            memcpy(y, y_inicial, bloques * sizeof(mxfp8_e4m3_t));
+        }
+
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación AXPY
+        axpy(bloques, a, x, y);
+        cronometro_parar(&cronometro);
+    }
+
+    cronometro_imprimir(&cronometro);
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", mxfp8_e4m3_a_float(y, n-1), mxfp8_e4m3_a_float(y, n-1));
+
+    if(verbose){
+        printf("Resultados ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", mxfp8_e4m3_a_float(y, i));
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, mxfp8_e4m3_a_float(y, i));
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se mide AXPY con 1, 2, 4, ... hasta hilos_max hilos. Para cada número de
+        hilos se crean copias de x e y inicializadas en paralelo con el mismo reparto estático que
+        la operación, de modo que cada hilo trabaja sobre páginas ubicadas en su nodo NUMA.
+        Cada vuelta vuelve a copiar y en paralelo, por lo que solo la primera hace el first-touch.
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            mxfp8_e4m3_t *x_hilos = (mxfp8_e4m3_t *)memoria_reservar(bloques * sizeof(mxfp8_e4m3_t));
+            mxfp8_e4m3_t *y_hilos = (mxfp8_e4m3_t *)memoria_reservar(bloques * sizeof(mxfp8_e4m3_t));
+
+            if (x_hilos == NULL || y_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(bloques, x_hilos, x, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                copiar_multihilo(bloques, y_hilos, y_inicial, hilos);
+
+                cronometro_arrancar(&cronometro);
+                axpy_multihilo(bloques, a, x_hilos, y_hilos, hilos);
+                cronometro_parar(&cronometro);
+            }
+            double tiempo_hilos = cronometro_imprimir(&cronometro);
+            printf("Ancho de banda: %f GB/s\n", (3.0 * bloques * sizeof(mxfp8_e4m3_t)) / tiempo_hilos / 1e9);
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    // Liberar memoria asignada
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(y_inicial);
+
+    return EXIT_SUCCESS;
+}
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de AXPY en el programa unificado (Programas/BENCH, ver registro.h): x son los n
+    primeros valores del driver e y los n siguientes, cuantizados bloque a bloque como en
+    generar_vectores (el relleno vale 0). y se restaura antes de cada vuelta. El kernel se escoge
+    con cpuid ("auto").
+*/
+static size_t axpy_tipo_bytes(int64_t n) {
+    return mx_num_bloques(n) * sizeof(mxfp8_e4m3_t);
+}
+
+static void axpy_tipo_desde_float(void *destino, const float *origen, int64_t n) {
+    float v[MX_BLOQUE];
+
+    for (int64_t b = 0; b < mx_num_bloques(n); b++) {
+        for (int k = 0; k < MX_BLOQUE; k++) {
+            int64_t i = b * MX_BLOQUE + k;
+            v[k] = (i < n) ? origen[i] : 0.0f;
+        }
+        mxfp8_e4m3_codificar_bloque(v, (mxfp8_e4m3_t *)destino + b);
+    }
+}
+
+static void axpy_tipo_a_float(float *destino, const void *origen, int64_t n) {
+    for (int64_t i = 0; i < n; i++) {
+        destino[i] = mxfp8_e4m3_a_float((const mxfp8_e4m3_t *)origen, i);
+    }
+}
+
+static const registro_tipo_t axpy_tipo = {axpy_tipo_bytes, axpy_tipo_desde_float, axpy_tipo_a_float};
+
+static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+    fp8_inicializar_tablas();
+    seleccionar_kernel_axpy("auto");
+    return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+}
+
+static void axpy_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    axpy(mx_num_bloques(estado->n), 2.3752f, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 multiplicación y 1 suma por elemento; lee x e y, escribe y
+static double axpy_flops(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double axpy_trafico(int64_t n) {
+    return 3.0 * (double)n;
+}
+
+static const registro_kernel_t registro_axpy = {
+    .kernel = "axpy",
+    .medida = "axpy",
+    .tipo = "MXFP8_E4M3",
+    .bytes_elemento = (double)sizeof(mxfp8_e4m3_t) / MX_BLOQUE,
+    .implementacion = &axpy_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = axpy_preparar,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = axpy_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = axpy_flops,
+    .elementos = axpy_trafico,
+};
+REGISTRO_KERNEL(registro_axpy)
+
+#endif /* BENCH_REGISTRO */
@@ -42,10 +42,12 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
-COMMON_FLAGS="-Wall -g"
+COMMON_FLAGS="-Wall -g -fopenmp"
 
 OPT_FLAGS="-mf16c -O3 -fomit-frame-pointer $additional_flags"
 
+LINK_FLAGS="-lm"
+
 # Obtener el directorio donde está ubicado el script
 script_dir="$(dirname "$0")"
 
@@ -54,7 +56,7 @@ cd "$script_dir"
 
 ### COMPILACION DEL PROGRAMA BASE
 
-gcc-14 $COMMON_FLAGS axpy_FP32.c -o axpy_FP32 $OPT_FLAGS
+gcc-14 $COMMON_FLAGS axpy_FP32.c -o axpy_FP32 $OPT_FLAGS $LINK_FLAGS
 
 
 if grep -q "sse2" /proc/cpuinfo; then
@@ -62,59 +64,34 @@ if grep -q "sse2" /proc/cpuinfo; then
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
-    gcc-14 $COMMON_FLAGS axpy_FP16.c -o axpy_FP16 -fexcess-precision=16 $OPT_FLAGS
-
-    # Para los futuros procesadores AMD con arquitectura Zen 6
-
-    if grep -q "avx512fp16" /proc/cpuinfo; then
-        echo "AVX512FP16 support detected. Compiling with -mavx512fp16."
-
-        COMMON_FLAGS+=" -march=znver6 -mtune=znver6 -mavx512fp16"
-
-        # Compilar el programa optimizado con AVX512-FP16 (nativo para Zen 6)
-        gcc-14 $COMMON_FLAGS axpy_FP16.c -o axpy_FP16_native-base $OPT_FLAGS 
-        # Compilar el programa optimizado con AVX512-FP16 y precisión estándar
-        gcc-14 $COMMON_FLAGS axpy_FP16.c -o axpy_FP16_avx512fp16_precision -fexcess-precision=16 $OPT_FLAGS
-        # Compilar el programa con máxima optimización para AVX512-FP16
-        gcc-14 $COMMON_FLAGS axpy_FP16.c -o axpy_FP16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS
-
-
-        # Eliminar los flags específicos de esta sección 
-        COMMON_FLAGS="${COMMON_FLAGS/-march=znver6/}"
-        COMMON_FLAGS="${COMMON_FLAGS/-mtune=znver6/}"
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512fp16/}"
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
-
-    else
-        echo "AVX512 not supported on this system. Skipping compilation with AVX512 flags."
-    fi
+    # Un único ejecutable: el kernel AVX512-FP16 se compila con atributos target y se
+    # selecciona en tiempo de ejecución (cpuid), por lo que no se generan variantes por CPU
+    gcc-14 $COMMON_FLAGS axpy_FP16.c -o axpy_FP16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
     ### COMPILACION DEL PROGRAMA CON BFLOAT16 (EMPLEA EL TIPO DE DATO __bf16)
 
-    gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16 -fexcess-precision=16 $OPT_FLAGS
+    # Un único ejecutable: los kernels AVX2 y AVX512-BF16 se compilan con atributos target y se
+    # seleccionan en tiempo de ejecución (cpuid), por lo que no se generan variantes por CPU
+    gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
-    if grep -q "avx512bf16" /proc/cpuinfo; then
-        echo "AVX512BF16 support detected. Compiling with -mavx512bf16."
-        COMMON_FLAGS+=" -mavx512bf16"
+else
+    echo "SSE2 not supported on this system. Skipping compilation for programs with reduced precision (float) data type."
+fi
 
-        # Compilar el programa optimizado con AVX512 (nativo)
-        gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16_native-base $OPT_FLAGS
-        # Compilar el programa optimizado con AVX512 y precisión de 16 bits
-        gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16_avx512_precision -fexcess-precision=16 $OPT_FLAGS
-        # Compilar el programa con máxima optimización
-        gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS
 
-        # Eliminar los flags específicos de esta sección
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512bf16/}" 
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
+### COMPILACION DE LOS PROGRAMAS CON FLOAT DE 8 BITS (OCP FP8 E4M3 Y E5M2, ALMACENADOS COMO uint8_t)
 
-    else
-        echo "AVX512BF16 not supported on this system. Skipping compilation with -mavx512bf16."
-    fi
+# La conversión a FP8 es software: los kernels AVX2 y AVX-512 se compilan con atributos target
+# y se seleccionan en tiempo de ejecución (cpuid), con el bucle escalar como alternativa
+gcc-14 $COMMON_FLAGS axpy_FP8_E4M3.c -o axpy_FP8_E4M3 $OPT_FLAGS $LINK_FLAGS
+gcc-14 $COMMON_FLAGS axpy_FP8_E5M2.c -o axpy_FP8_E5M2 $OPT_FLAGS $LINK_FLAGS
 
-else
-    echo "SSE2 not supported on this system. Skipping compilation for programs with reduced precision (float) data type."
-fi
+### COMPILACION DE LOS PROGRAMAS CON ESCALADO POR BLOQUES (OCP MX: MXFP8 E4M3 Y MXINT8)
+
+# Bloques de 32 elementos de 8 bits con una escala E8M0 compartida; como en FP8, los kernels
+# vectoriales se seleccionan en tiempo de ejecución
+gcc-14 $COMMON_FLAGS axpy_MXFP8_E4M3.c -o axpy_MXFP8_E4M3 $OPT_FLAGS $LINK_FLAGS
+gcc-14 $COMMON_FLAGS axpy_MXINT8.c -o axpy_MXINT8 $OPT_FLAGS $LINK_FLAGS
 
 if $force_run; then
 
@@ -122,22 +99,36 @@ if $force_run; then
     ### COMPILACION DEL PROGRAMA BASE
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall axpy_FP32.c -o axpy_FP32.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_FP32.c -o axpy_FP32.out -lm
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall -fexcess-precision=16 axpy_FP16.c -o axpy_FP16.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp -fexcess-precision=16 axpy_FP16.c -o axpy_FP16.out -lm
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __fp16)
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall axpy_FP16_ARM.c -o axpy_FP16_ARM.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_FP16_ARM.c -o axpy_FP16_ARM.out -lm
 
     ### COMPILACION DEL PROGRAMA DE CON BFLOAT16 PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __bf16)
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall axpy_BF16.c -o axpy_BF16.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_BF16.c -o axpy_BF16.out -lm
+
+
+    ### COMPILACION DE LOS PROGRAMAS CON FLOAT DE 8 BITS PARA ARQUITECTURA ARM (OCP FP8 E4M3 Y E5M2)
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_FP8_E4M3.c -o axpy_FP8_E4M3.out -lm
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_FP8_E5M2.c -o axpy_FP8_E5M2.out -lm
+
+
+    ### COMPILACION DE LOS PROGRAMAS CON ESCALADO POR BLOQUES PARA ARQUITECTURA ARM (OCP MX)
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_MXFP8_E4M3.c -o axpy_MXFP8_E4M3.out -lm
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp axpy_MXINT8.c -o axpy_MXINT8.out -lm
 
 fi
 
@@ -42,10 +42,12 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
-COMMON_FLAGS="-Wall"
+COMMON_FLAGS="-Wall -fopenmp"
 
 OPT_FLAGS="-O3 -march=armv8.2-a+fp16+fp16fml+simd -ftree-vectorize -fomit-frame-pointer $additional_flags"
 
+LINK_FLAGS="-lm"
+
 # Obtener el directorio donde está ubicado el script
 script_dir="$(dirname "$0")"
 
@@ -56,21 +58,33 @@ cd "$script_dir"
 ### COMPILACION DEL PROGRAMA BASE
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS axpy_FP32.c -o axpy_FP32.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS axpy_FP32.c -o axpy_FP32.out $OPT_FLAGS $LINK_FLAGS
 
 
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS -fexcess-precision=16 axpy_FP16.c -o axpy_FP16.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS -fexcess-precision=16 axpy_FP16.c -o axpy_FP16.out $OPT_FLAGS $LINK_FLAGS
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __fp16)
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS axpy_FP16_ARM.c -o axpy_FP16_ARM.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS axpy_FP16_ARM.c -o axpy_FP16_ARM.out $OPT_FLAGS $LINK_FLAGS
 
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __bf16)
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS axpy_BF16.c -o axpy_BF16.out $OPT_FLAGS $LINK_FLAGS
+
+### COMPILACION DE LOS PROGRAMAS CON FLOAT DE 8 BITS (OCP FP8 E4M3 Y E5M2, ALMACENADOS COMO uint8_t)
+
+# Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+gcc-14 $COMMON_FLAGS axpy_FP8_E4M3.c -o axpy_FP8_E4M3.out $OPT_FLAGS $LINK_FLAGS
+gcc-14 $COMMON_FLAGS axpy_FP8_E5M2.c -o axpy_FP8_E5M2.out $OPT_FLAGS $LINK_FLAGS
+
+### COMPILACION DE LOS PROGRAMAS CON ESCALADO POR BLOQUES (OCP MX: MXFP8 E4M3 Y MXINT8)
+
+# Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+gcc-14 $COMMON_FLAGS axpy_MXFP8_E4M3.c -o axpy_MXFP8_E4M3.out $OPT_FLAGS $LINK_FLAGS
+gcc-14 $COMMON_FLAGS axpy_MXINT8.c -o axpy_MXINT8.out $OPT_FLAGS $LINK_FLAGS
 
 exit 0
\ No newline at end of file
@@ -113,6 +113,21 @@ for file in *; do
     fi
 done
 
+# Ejecutar los kernels alternativos de los programas con selección de kernel en tiempo de ejecución (-k)
+# Formato: "<ejecutable>:<kernel>"
+KERNELS_ALTERNATIVOS=("axpy_FP16:f16c" "axpy_BF16:avx2" "axpy_FP8_E4M3:avx2" "axpy_FP8_E5M2:avx2"
+                      "axpy_MXFP8_E4M3:avx2" "axpy_MXINT8:avx2")
+
+for variante in "${KERNELS_ALTERNATIVOS[@]}"; do
+    file="${variante%%:*}"
+    kernel="${variante##*:}"
+    if [ -f "$file" ] && [ -x "$file" ]; then
+        echo "$(build_message "$file [-k $kernel]" "$tamanhoN" "$seed")"
+        $run_option ./"$file" -k "$kernel" "$tamanhoN" "$seed" "$verbose_flag"
+        echo ""
+    fi
+done
+
 # Ejecutar solo si el flag --force está presente
 if $force_run; then
     echo "Flag [-f]--force presente. Intentando ejecutar todos los archivos con extensión .out en el directorio actual."
@@ -0,0 +1,922 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/cache_info.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
+/*
+    Programa unificado: ejecuta en un único proceso los kernels que los programas de AXPY,
+    BLAS1, DCT, DWT_1D, PCA y PCA_REIMPL registran con REGISTRO_KERNEL (ver registro.h), para
+    todos los tipos de dato con los que se haya compilado bench_compile_<vendor>.sh.
+
+        ./bench [--kernel k1,k2] [--type t1,t2] [-w calentamiento] [-r repeticiones] [-p]
+                [-H malloc|thp|hugetlb] [--rand-libc] [--list] [--throughput]
+                (--n <tamaño> | <tamaño> | --cache) [--seed <s> | <seed>]
+
+    --kernel admite familias (axpy, dwt_1d, ...) o medidas (legall53, cdf97, ...) y --type los
+    sufijos de los programas sin distinguir mayúsculas (fp32, bf16, fp8_e4m3, ...); sin ellos se
+    ejecuta todo. Para cada medida se generan los datos una vez con el seed (con Philox o, con
+    --rand-libc, con rand() de la libc; ver aleatorio.h) y todas las variantes parten de ellos;
+    la de FP32 se ejecuta siempre (aunque no se pida) para verificar las demás.
+
+    Cada variante imprime su bloque de tiempos como los programas individuales y al final una
+    tabla CSV en la que todas las líneas empiezan por "bench,":
+
+        bench,kernel,medida,tipo,implementacion,n,mediana,min,gflops,gbs,error_rel,error_max
+        bench,dwt_1d,legall53,BF16,-,1048576,0.004102311,0.004087122,4.090,1.023,2.1e-03,6.2e-02
+
+    gflops y gbs se calculan con la mediana; error_rel es ||v - ref|| / ||ref|| (norma 2) y
+    error_max el mayor |v - ref| respecto a FP32 (nan si no hay variante FP32).
+
+    Con --cache no se indica el tamaño: cada variante se mide con los datos residentes en L1,
+    L2 y L3 (la mitad de cada nivel, con los tamaños de cache_info.h) y en memoria (cuatro
+    veces la LLC). Como conjunto de trabajo se toma elementos * bytes_elemento, así que a igual
+    nivel FP16 usa el doble de elementos que FP32. Tras preparar los datos (que los toca) y al
+    menos una vuelta de calentamiento, cada repetición (10 si no se pasa -r) encadena las
+    llamadas necesarias para durar CACHE_MUESTRA_MINIMA y se divide entre ellas. Los kernels
+    con restaurar recuperan sus datos solo entre repeticiones: dentro de una, cada llamada
+    trabaja sobre el resultado de la anterior (en AXPY, y acumula a * x en cada llamada). La
+    tabla separa el cómputo del ancho de banda de cada nivel y compara cada tipo con FP32:
+
+        cache,kernel,medida,tipo,implementacion,nivel,bytes_nivel,n,llamadas,mediana,min,gflops,gbs,aceleracion
+        cache,axpy,axpy,FP16,avx512fp16,L1,49152,4096,313,0.000000222,0.000000186,36.868,110.604,2.13
+
+    aceleracion es gflops / gflops de FP32 en el mismo nivel (nan si no se mide FP32; en los
+    kernels sin operaciones, como swap y copy de BLAS1, se comparan los elementos por segundo). Se
+    omiten los niveles en que una llamada supera CACHE_MAX_FLOPS (la DCT, O(n^2), en L3 y en
+    memoria; PCA, O(n^3), en memoria).
+
+    Con --throughput cada variante se ejecuta como P instancias independientes, una por núcleo
+    (fijada con pthread_setaffinity_np a la P-ésima CPU permitida al proceso), para P = 1 hasta
+    el número de CPUs. Cada instancia prepara sus propios datos de tamaño n desde su núcleo
+    (first-touch en su nodo NUMA); en cada vuelta todas arrancan a la vez tras una barrera y la
+    muestra es el tiempo hasta que termina la última. La tabla da el rendimiento agregado
+    cuando todos los núcleos compiten por la memoria:
+
+        throughput,kernel,medida,tipo,implementacion,n,instancias,mediana,min,elementos_s,gflops,gbs,escalado
+        throughput,axpy,axpy,FP16,avx512fp16,16777216,8,0.010352117,0.010198412,1.297e+10,25.930,38.894,5.12
+
+    elementos_s es P * n / mediana, gflops y gbs suman las P instancias y escalado es
+    elementos_s / elementos_s con una instancia. Sin -r se hacen THROUGHPUT_REPETICIONES y al
+    menos una vuelta de calentamiento.
+*/
+
+#define OPCION_KERNEL 0x102
+#define OPCION_TIPO 0x103
+#define OPCION_TAMANHO 0x104
+#define OPCION_SEED 0x105
+#define OPCION_LISTA 0x106
+#define OPCION_CACHE 0x108
+#define OPCION_THROUGHPUT 0x109
+
+// Modo --cache: fracción de cada nivel que ocupan los datos y repeticiones sin -r
+#define CACHE_FRACCION 0.5
+#define CACHE_REPETICIONES 10
+// Duración mínima (s) de una repetición en el modo --cache, por encima del coste del reloj
+#define CACHE_MUESTRA_MINIMA 1e-4
+// Trabajo máximo de una llamada en el modo --cache; los niveles que lo superan se omiten
+#define CACHE_MAX_FLOPS 1e10
+
+// Modo --throughput: repeticiones sin -r
+#define THROUGHPUT_REPETICIONES 10
+
+// Tabla de kernels que rellenan los constructores de cada objeto registrado
+static const registro_kernel_t *registro_tabla[REGISTRO_MAX];
+static int registro_num = 0;
+
+void registro_anhadir(const registro_kernel_t *kernel) {
+    if (registro_num == REGISTRO_MAX) {
+        fprintf(stderr, "Demasiados kernels registrados (máximo %d); se ignora %s %s\n", REGISTRO_MAX, kernel->medida, kernel->tipo);
+        return;
+    }
+    registro_tabla[registro_num++] = kernel;
+}
+
+// Orden de los tipos en la salida: FP32 (la referencia) primero y después de mayor a menor precisión
+static const char *const orden_tipos[] = {
+    "FP32", "FP16", "FP16_ARM", "BF16", "FP8_E4M3", "FP8_E5M2", "MXFP8_E4M3", "MXINT8"
+};
+
+static int posicion_tipo(const char *tipo) {
+    int num = (int)(sizeof(orden_tipos) / sizeof(orden_tipos[0]));
+    for (int i = 0; i < num; i++) {
+        if (strcmp(tipo, orden_tipos[i]) == 0) {
+            return i;
+        }
+    }
+    return num;
+}
+
+// Agrupa los kernels por familia y medida (en orden alfabético) y ordena los tipos dentro del grupo
+static int comparar_registros(const void *a, const void *b) {
+    const registro_kernel_t *ka = *(const registro_kernel_t *const *)a;
+    const registro_kernel_t *kb = *(const registro_kernel_t *const *)b;
+    int c = strcmp(ka->kernel, kb->kernel);
+    if (c == 0) {
+        c = strcmp(ka->medida, kb->medida);
+    }
+    if (c == 0) {
+        c = posicion_tipo(ka->tipo) - posicion_tipo(kb->tipo);
+    }
+    if (c == 0) {
+        c = strcmp(ka->tipo, kb->tipo);
+    }
+    return c;
+}
+
+// Indica si nombre aparece en la lista separada por comas (una lista NULL lo admite todo)
+int en_lista(const char *lista, const char *nombre) {
+    size_t longitud = strlen(nombre);
+    const char *p = lista;
+
+    if (lista == NULL) {
+        return 1;
+    }
+    while (*p != '\0') {
+        const char *fin = strchr(p, ',');
+        size_t tramo = (fin != NULL) ? (size_t)(fin - p) : strlen(p);
+        if (tramo == longitud && strncasecmp(p, nombre, longitud) == 0) {
+            return 1;
+        }
+        if (fin == NULL) {
+            break;
+        }
+        p = fin + 1;
+    }
+    return 0;
+}
+
+int seleccionado(const registro_kernel_t *k, const char *kernels, const char *tipos) {
+    return (en_lista(kernels, k->kernel) || en_lista(kernels, k->medida)) && en_lista(tipos, k->tipo);
+}
+
+void listar_kernels(void) {
+    printf("kernel,medida,tipo\n");
+    for (int i = 0; i < registro_num; i++) {
+        const registro_kernel_t *k = registro_tabla[i];
+        printf("%s,%s,%s\n", k->kernel, k->medida, k->tipo);
+    }
+}
+
+/*
+    Resultado de una ejecución sin medir (la referencia FP32 cuando no se ha pedido).
+    Devuelve -1 si la variante no puede preparar sus datos.
+*/
+int ejecutar_una_vez(const registro_kernel_t *k, int64_t n, const float *entrada, const char *memoria, float *salida) {
+    void *estado = k->preparar(n, entrada, memoria);
+    if (estado == NULL) {
+        return -1;
+    }
+    k->ejecutar(estado);
+    k->resultado(estado, salida);
+    k->liberar(estado);
+    return 0;
+}
+
+// Errores de v respecto a ref: relativo en norma 2 y máximo absoluto
+void calcular_errores(const float *v, const float *ref, int64_t num, double *error_rel, double *error_max) {
+    double diferencia = 0.0, norma = 0.0, maximo = 0.0;
+
+    for (int64_t i = 0; i < num; i++) {
+        double d = fabs((double)v[i] - (double)ref[i]);
+        diferencia += d * d;
+        norma += (double)ref[i] * (double)ref[i];
+        if (d > maximo || isnan(d)) {
+            maximo = d;
+        }
+    }
+    *error_rel = norma > 0.0 ? sqrt(diferencia) / sqrt(norma) : sqrt(diferencia);
+    *error_max = maximo;
+}
+
+typedef struct {
+    const registro_kernel_t *kernel;
+    const char *implementacion;
+    estadisticas_t e;
+    double error_rel;
+    double error_max;
+} fila_t;
+
+/*
+    Mide ejecutar con el cronómetro: calentamiento vueltas sin guardar y repeticiones medidas,
+    cada una con llamadas ejecuciones seguidas. Antes de cada vuelta salvo la primera se
+    restauran los datos (fuera de la medida). Imprime y deja en e los tiempos por llamada (con
+    -p los contadores son los de la vuelta completa).
+*/
+void medir(const registro_kernel_t *k, void *estado, int calentamiento, int repeticiones, int llamadas, estadisticas_t *e) {
+    cronometro_t cronometro;
+
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte de los mismos datos, que algunos kernels sobrescriben
+        if (k->restaurar != NULL && cronometro.vuelta > 0) {
+            k->restaurar(estado);
+        }
+
+        cronometro_arrancar(&cronometro);
+        for (int j = 0; j < llamadas; j++) {
+            k->ejecutar(estado);
+        }
+        cronometro_parar(&cronometro);
+    }
+    for (int j = 0; j < repeticiones; j++) {
+        cronometro.muestras[j] /= llamadas;
+    }
+
+    cronometro_imprimir(&cronometro);
+    calcular_estadisticas(cronometro.muestras, cronometro.repeticiones, e);
+}
+
+typedef struct {
+    const char *nombre;
+    long bytes;         // tamaño del nivel (en memoria, el conjunto de trabajo)
+    double conjunto;    // bytes de datos de cada variante
+} nivel_cache_t;
+
+typedef struct {
+    const registro_kernel_t *kernel;
+    const char *implementacion;
+    const nivel_cache_t *nivel;
+    int64_t n;
+    int llamadas;
+    estadisticas_t e;
+} fila_cache_t;
+
+// Mayor n cuyo conjunto de trabajo (elementos * bytes_elemento) cabe en bytes, o 0 si no cabe ninguno
+int64_t tamanho_para_bytes(const registro_kernel_t *k, double bytes) {
+    int64_t cabe = 1, no_cabe;
+
+    if (k->elementos(1) * k->bytes_elemento > bytes) {
+        return 0;
+    }
+    while (k->elementos(2 * cabe) * k->bytes_elemento <= bytes) {
+        cabe *= 2;
+    }
+    no_cabe = 2 * cabe;
+    while (no_cabe - cabe > 1) {
+        int64_t medio = cabe + (no_cabe - cabe) / 2;
+        if (k->elementos(medio) * k->bytes_elemento <= bytes) {
+            cabe = medio;
+        } else {
+            no_cabe = medio;
+        }
+    }
+    return cabe;
+}
+
+/*
+    Llamadas por repetición para que cada una dure al menos CACHE_MUESTRA_MINIMA, a partir de
+    la segunda llamada (la primera acaba de cargar los datos). Los kernels con restaurar también
+    encadenan llamadas: medir restaura los datos solo entre repeticiones, así que dentro de una
+    repetición cada llamada parte del resultado de la anterior. Al volver los datos quedan
+    restaurados.
+*/
+int calibrar_llamadas(const registro_kernel_t *k, void *estado) {
+    struct timespec inicio, fin;
+
+    k->ejecutar(estado);
+    if (k->restaurar != NULL) {
+        k->restaurar(estado);
+    }
+    clock_gettime(CLOCK_MONOTONIC_RAW, &inicio);
+    k->ejecutar(estado);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &fin);
+    if (k->restaurar != NULL) {
+        k->restaurar(estado);
+    }
+
+    double tiempo = (double)(fin.tv_sec - inicio.tv_sec) + (double)(fin.tv_nsec - inicio.tv_nsec) * 1e-9;
+    if (tiempo >= CACHE_MUESTRA_MINIMA) {
+        return 1;
+    }
+    double llamadas = ceil(CACHE_MUESTRA_MINIMA / (tiempo > 1e-9 ? tiempo : 1e-9));
+    return llamadas > 1e6 ? 1000000 : (int)llamadas;
+}
+
+/*
+    Modo --cache: mide cada variante con los datos residentes en L1, L2, L3 y en memoria (ver el
+    comentario del principio) e imprime la tabla "cache,". Devuelve -1 si falla la reserva de
+    memoria.
+*/
+int modo_cache(const char *kernels, const char *tipos, unsigned int seed, int rand_libc, const char *memoria, int calentamiento, int repeticiones) {
+    static const char *const nombres[] = {"L1", "L2", "L3"};
+    nivel_cache_t niveles[4];
+    int num_niveles = 0;
+    long llc = cache_tamanho_llc();
+
+    for (int nivel = 1; nivel <= 3; nivel++) {
+        // Sin L3 la LLC es la L2 (cache_tamanho(3) daría el valor por defecto)
+        if (nivel == 3 && llc <= cache_tamanho(2)) {
+            break;
+        }
+        niveles[num_niveles].nombre = nombres[nivel - 1];
+        niveles[num_niveles].bytes = cache_tamanho(nivel);
+        niveles[num_niveles].conjunto = CACHE_FRACCION * niveles[num_niveles].bytes;
+        num_niveles++;
+    }
+    niveles[num_niveles].nombre = "memoria";
+    niveles[num_niveles].bytes = 4 * llc;
+    niveles[num_niveles].conjunto = 4.0 * llc;
+    num_niveles++;
+
+    for (int l = 0; l < num_niveles; l++) {
+        printf("Nivel %s: %ld bytes (datos de cada variante: %.0f bytes)\n", niveles[l].nombre, niveles[l].bytes, niveles[l].conjunto);
+    }
+    printf("\n");
+
+    // El calentamiento incluye al menos una vuelta para que la medida parta de los datos en caché
+    if (calentamiento < 1) {
+        calentamiento = 1;
+    }
+
+    fila_cache_t *filas = (fila_cache_t *)calloc((size_t)registro_num * num_niveles, sizeof(fila_cache_t));
+    int num_filas = 0;
+
+    if (filas == NULL) {
+        printf("Error al asignar memoria\n");
+        return -1;
+    }
+
+    // Por grupo (familia, medida) y nivel, todos los tipos seguidos para compararlos
+    for (int inicio = 0, fin; inicio < registro_num; inicio = fin) {
+        for (fin = inicio; fin < registro_num; fin++) {
+            if (strcmp(registro_tabla[fin]->kernel, registro_tabla[inicio]->kernel) != 0 || strcmp(registro_tabla[fin]->medida, registro_tabla[inicio]->medida) != 0) {
+                break;
+            }
+        }
+
+        for (int l = 0; l < num_niveles; l++) {
+            for (int i = inicio; i < fin; i++) {
+                const registro_kernel_t *k = registro_tabla[i];
+                if (!seleccionado(k, kernels, tipos)) {
+                    continue;
+                }
+
+                int64_t n = tamanho_para_bytes(k, niveles[l].conjunto);
+                if (n == 0) {
+                    printf("Kernel: %s %s %s, nivel %s: los datos no caben; se omite\n\n", k->kernel, k->medida, k->tipo, niveles[l].nombre);
+                    continue;
+                }
+                if (k->flops(n) > CACHE_MAX_FLOPS) {
+                    printf("Kernel: %s %s %s, nivel %s, n = %lld: %.3g flops por llamada; se omite\n\n", k->kernel, k->medida, k->tipo,
+                           niveles[l].nombre, (long long)n, k->flops(n));
+                    continue;
+                }
+
+                float *entrada = (float *)malloc(k->elementos_entrada(n) * sizeof(float));
+                if (entrada == NULL) {
+                    printf("Error al asignar memoria\n");
+                    free(filas);
+                    return -1;
+                }
+                k->generar(n, seed, rand_libc, entrada);
+                void *estado = k->preparar(n, entrada, memoria);
+                free(entrada);
+                if (estado == NULL) {
+                    printf("Error al asignar memoria\n");
+                    free(filas);
+                    return -1;
+                }
+
+                // La variante se escoge al preparar
+                const char *implementacion = k->implementacion != NULL ? *k->implementacion : "-";
+                fila_cache_t *fila = &filas[num_filas++];
+                fila->kernel = k;
+                fila->implementacion = implementacion;
+                fila->nivel = &niveles[l];
+                fila->n = n;
+                fila->llamadas = calibrar_llamadas(k, estado);
+                printf("Kernel: %s %s %s (%s), nivel %s, n = %lld, %d llamadas por repeticion\n", k->kernel, k->medida, k->tipo,
+                       implementacion, niveles[l].nombre, (long long)n, fila->llamadas);
+
+                medir(k, estado, calentamiento, repeticiones, fila->llamadas, &fila->e);
+                k->liberar(estado);
+                printf("\n");
+            }
+        }
+    }
+
+    printf("cache,kernel,medida,tipo,implementacion,nivel,bytes_nivel,n,llamadas,mediana,min,gflops,gbs,aceleracion\n");
+    for (int i = 0; i < num_filas; i++) {
+        const fila_cache_t *f = &filas[i];
+        const registro_kernel_t *k = f->kernel;
+        double gflops = k->flops(f->n) / f->e.mediana / 1e9;
+        double gbs = k->elementos(f->n) * k->bytes_elemento / f->e.mediana / 1e9;
+
+        // FP32 de la misma medida y nivel (elementos por segundo si el kernel no hace operaciones)
+        double aceleracion = NAN;
+        for (int j = 0; j < num_filas; j++) {
+            const fila_cache_t *r = &filas[j];
+            if (r->nivel == f->nivel && strcmp(r->kernel->tipo, "FP32") == 0 && strcmp(r->kernel->kernel, k->kernel) == 0 &&
+                strcmp(r->kernel->medida, k->medida) == 0) {
+                if (k->flops(f->n) > 0.0) {
+                    aceleracion = gflops / (r->kernel->flops(r->n) / r->e.mediana / 1e9);
+                } else {
+                    aceleracion = ((double)f->n / f->e.mediana) / ((double)r->n / r->e.mediana);
+                }
+                break;
+            }
+        }
+
+        printf("cache,%s,%s,%s,%s,%s,%ld,%lld,%d,%.9f,%.9f,%.3f,%.3f,%.2f\n", k->kernel, k->medida, k->tipo, f->implementacion,
+               f->nivel->nombre, f->nivel->bytes, (long long)f->n, f->llamadas, f->e.mediana, f->e.min, gflops, gbs, aceleracion);
+    }
+
+    free(filas);
+    return 0;
+}
+
+// Datos compartidos por las instancias de una medida del modo --throughput
+typedef struct {
+    const registro_kernel_t *kernel;
+    int64_t n;
+    const float *entrada;
+    const char *memoria;
+    int vueltas;
+    int fallo;                  // alguna instancia no pudo preparar sus datos
+    int cancelada;              // no se crearon todas las instancias: terminan sin medir
+    pthread_barrier_t barrera;  // instancias + hilo principal
+    pthread_mutex_t cerrojo;    // preparar y liberar (memoria.h no es reentrante)
+} throughput_t;
+
+typedef struct {
+    throughput_t *comun;
+    int cpu;
+    pthread_t hilo;
+} instancia_t;
+
+/*
+    Hilo de una instancia: se fija a su CPU, prepara sus datos y en cada vuelta espera a la
+    barrera de inicio, ejecuta el kernel y espera a la de fin. Si alguna instancia falla al
+    preparar, todas terminan tras la primera barrera.
+*/
+void *instancia_hilo(void *p) {
+    instancia_t *instancia = (instancia_t *)p;
+    throughput_t *comun = instancia->comun;
+    const registro_kernel_t *k = comun->kernel;
+    cpu_set_t cpus;
+
+    CPU_ZERO(&cpus);
+    CPU_SET(instancia->cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        fprintf(stderr, "No se pudo fijar la instancia a la CPU %d\n", instancia->cpu);
+    }
+
+    // El hilo principal tiene el cerrojo hasta crear todas las instancias
+    pthread_mutex_lock(&comun->cerrojo);
+    if (comun->cancelada) {
+        pthread_mutex_unlock(&comun->cerrojo);
+        return NULL;
+    }
+    void *estado = k->preparar(comun->n, comun->entrada, comun->memoria);
+    if (estado == NULL) {
+        comun->fallo = 1;
+    }
+    pthread_mutex_unlock(&comun->cerrojo);
+
+    pthread_barrier_wait(&comun->barrera);
+    if (!comun->fallo) {
+        for (int vuelta = 0; vuelta < comun->vueltas; vuelta++) {
+            if (k->restaurar != NULL && vuelta > 0) {
+                k->restaurar(estado);
+            }
+            pthread_barrier_wait(&comun->barrera);
+            k->ejecutar(estado);
+            pthread_barrier_wait(&comun->barrera);
+        }
+    }
+
+    if (estado != NULL) {
+        pthread_mutex_lock(&comun->cerrojo);
+        k->liberar(estado);
+        pthread_mutex_unlock(&comun->cerrojo);
+    }
+    return NULL;
+}
+
+/*
+    Mide una variante con instancias independientes en las CPUs indicadas: el hilo principal
+    toma el tiempo entre la barrera de inicio y la de fin de cada vuelta. Devuelve -1 si falla
+    la creación de los hilos o la preparación de alguna instancia.
+*/
+int medir_instancias(const registro_kernel_t *k, int64_t n, const float *entrada, const char *memoria, const int *cpus, int instancias,
+                     int calentamiento, int repeticiones, estadisticas_t *e) {
+    throughput_t comun = {.kernel = k, .n = n, .entrada = entrada, .memoria = memoria, .vueltas = calentamiento + repeticiones};
+    instancia_t *lista = (instancia_t *)malloc(instancias * sizeof(instancia_t));
+    int creadas = 0;
+
+    if (lista == NULL) {
+        return -1;
+    }
+    pthread_barrier_init(&comun.barrera, NULL, instancias + 1);
+    pthread_mutex_init(&comun.cerrojo, NULL);
+
+    pthread_mutex_lock(&comun.cerrojo);
+    for (; creadas < instancias; creadas++) {
+        lista[creadas].comun = &comun;
+        lista[creadas].cpu = cpus[creadas];
+        if (pthread_create(&lista[creadas].hilo, NULL, instancia_hilo, &lista[creadas]) != 0) {
+            break;
+        }
+    }
+    if (creadas < instancias) {
+        // Sin todas las instancias la barrera no se abriría: las creadas terminan sin preparar
+        comun.cancelada = 1;
+        pthread_mutex_unlock(&comun.cerrojo);
+        for (int i = 0; i < creadas; i++) {
+            pthread_join(lista[i].hilo, NULL);
+        }
+        pthread_barrier_destroy(&comun.barrera);
+        pthread_mutex_destroy(&comun.cerrojo);
+        free(lista);
+        return -1;
+    }
+    pthread_mutex_unlock(&comun.cerrojo);
+
+    pthread_barrier_wait(&comun.barrera);
+    if (!comun.fallo) {
+        cronometro_t cronometro;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            // Con -p los contadores se activan antes de la barrera de inicio y el reloj se toma
+            // justo al salir de ella, de modo que las ioctl no cuentan en la muestra
+            contadores_arrancar();
+            pthread_barrier_wait(&comun.barrera);
+            cronometro_arrancar_reloj(&cronometro);
+            pthread_barrier_wait(&comun.barrera);
+            cronometro_parar(&cronometro);
+        }
+
+        cronometro_imprimir(&cronometro);
+        calcular_estadisticas(cronometro.muestras, cronometro.repeticiones, e);
+    }
+
+    for (int i = 0; i < instancias; i++) {
+        pthread_join(lista[i].hilo, NULL);
+    }
+    pthread_barrier_destroy(&comun.barrera);
+    pthread_mutex_destroy(&comun.cerrojo);
+    free(lista);
+    return comun.fallo ? -1 : 0;
+}
+
+typedef struct {
+    const registro_kernel_t *kernel;
+    const char *implementacion;
+    int instancias;
+    estadisticas_t e;
+} fila_throughput_t;
+
+/*
+    Modo --throughput: mide cada variante con 1 a P instancias, una por CPU permitida (ver el
+    comentario del principio), e imprime la tabla "throughput,". Devuelve -1 si falla la reserva
+    de memoria o alguna medida.
+*/
+int modo_throughput(const char *kernels, const char *tipos, int64_t n, unsigned int seed, int rand_libc, const char *memoria,
+                    int calentamiento, int repeticiones) {
+    cpu_set_t permitidas;
+    int cpus[CPU_SETSIZE];
+    int num_cpus = 0;
+
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) != 0) {
+        perror("sched_getaffinity");
+        return -1;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &permitidas)) {
+            cpus[num_cpus++] = cpu;
+        }
+    }
+    printf("CPUs: %d\n\n", num_cpus);
+
+    // Como en --cache, al menos una vuelta de calentamiento
+    if (calentamiento < 1) {
+        calentamiento = 1;
+    }
+
+    fila_throughput_t *filas = (fila_throughput_t *)calloc((size_t)registro_num * num_cpus, sizeof(fila_throughput_t));
+    int num_filas = 0;
+
+    if (filas == NULL) {
+        printf("Error al asignar memoria\n");
+        return -1;
+    }
+
+    for (int i = 0; i < registro_num; i++) {
+        const registro_kernel_t *k = registro_tabla[i];
+        if (!seleccionado(k, kernels, tipos)) {
+            continue;
+        }
+
+        // Una única entrada de solo lectura de la que cada instancia copia sus datos
+        float *entrada = (float *)malloc(k->elementos_entrada(n) * sizeof(float));
+        if (entrada == NULL) {
+            printf("Error al asignar memoria\n");
+            free(filas);
+            return -1;
+        }
+        k->generar(n, seed, rand_libc, entrada);
+
+        for (int instancias = 1; instancias <= num_cpus; instancias++) {
+            fila_throughput_t *fila = &filas[num_filas];
+
+            printf("Kernel: %s %s %s, n = %lld, %d instancias\n", k->kernel, k->medida, k->tipo, (long long)n, instancias);
+            if (medir_instancias(k, n, entrada, memoria, cpus, instancias, calentamiento, repeticiones, &fila->e) != 0) {
+                printf("Error al preparar las instancias\n");
+                free(entrada);
+                free(filas);
+                return -1;
+            }
+            // La variante se escoge al preparar
+            fila->kernel = k;
+            fila->implementacion = k->implementacion != NULL ? *k->implementacion : "-";
+            fila->instancias = instancias;
+            num_filas++;
+            printf("\n");
+        }
+        free(entrada);
+    }
+
+    printf("throughput,kernel,medida,tipo,implementacion,n,instancias,mediana,min,elementos_s,gflops,gbs,escalado\n");
+    for (int i = 0, base = 0; i < num_filas; i++) {
+        const fila_throughput_t *f = &filas[i];
+        const registro_kernel_t *k = f->kernel;
+        if (f->instancias == 1) {
+            base = i;
+        }
+        double elementos_s = f->instancias * (double)n / f->e.mediana;
+        double gflops = f->instancias * k->flops(n) / f->e.mediana / 1e9;
+        double gbs = f->instancias * k->elementos(n) * k->bytes_elemento / f->e.mediana / 1e9;
+        double escalado = elementos_s / ((double)n / filas[base].e.mediana);
+
+        printf("throughput,%s,%s,%s,%s,%lld,%d,%.9f,%.9f,%.3e,%.3f,%.3f,%.2f\n", k->kernel, k->medida, k->tipo, f->implementacion,
+               (long long)n, f->instancias, f->e.mediana, f->e.min, elementos_s, gflops, gbs, escalado);
+    }
+
+    free(filas);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    int listar = 0;
+    const char *kernels = NULL;
+    const char *tipos = NULL;
+    const char *texto_n = NULL;
+    const char *texto_seed = NULL;
+    const char *memoria = "malloc";
+    int rand_libc = 0;
+    int cache = 0;
+    int throughput = 0;
+    int repeticiones_indicadas = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --kernel, --type, --n, --seed, --rand-libc, --cache, --throughput, --list)
+    static const struct option opciones_largas[] = {
+        {"kernel", required_argument, NULL, OPCION_KERNEL},
+        {"type", required_argument, NULL, OPCION_TIPO},
+        {"n", required_argument, NULL, OPCION_TAMANHO},
+        {"seed", required_argument, NULL, OPCION_SEED},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {"cache", no_argument, NULL, OPCION_CACHE},
+        {"throughput", no_argument, NULL, OPCION_THROUGHPUT},
+        {"list", no_argument, NULL, OPCION_LISTA},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpw:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                // Se acepta por compatibilidad con los scripts de ejecución; no hay datos que mostrar
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                repeticiones_indicadas = 1;
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                memoria = optarg;
+                break;
+            case OPCION_KERNEL:
+                kernels = optarg;
+                break;
+            case OPCION_TIPO:
+                tipos = optarg;
+                break;
+            case OPCION_TAMANHO:
+                texto_n = optarg;
+                break;
+            case OPCION_SEED:
+                texto_seed = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                rand_libc = 1;
+                break;
+            case OPCION_CACHE:
+                cache = 1;
+                break;
+            case OPCION_THROUGHPUT:
+                throughput = 1;
+                break;
+            case OPCION_LISTA:
+                listar = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [--kernel k1,k2] [--type t1,t2] [-p] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--rand-libc] [--list] [--throughput] (--n <tamaño> | <tamaño> | --cache) [--seed <s> | <seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    qsort(registro_tabla, registro_num, sizeof(registro_tabla[0]), comparar_registros);
+
+    if (listar) {
+        listar_kernels();
+        return EXIT_SUCCESS;
+    }
+
+    // Tamaño y seed también como argumentos posicionales, igual que en los demás programas (con
+    // --cache no hay tamaño)
+    if (texto_n == NULL && !cache && optind < argc) {
+        texto_n = argv[optind++];
+    }
+    if (texto_seed == NULL && optind < argc) {
+        texto_seed = argv[optind++];
+    }
+    if (texto_n == NULL && !cache) {
+        fprintf(stderr, "Uso: %s [--kernel k1,k2] [--type t1,t2] [-p] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--rand-libc] [--list] [--throughput] (--n <tamaño> | <tamaño> | --cache) [--seed <s> | <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t n = cache ? 0 : leer_tamanho(texto_n);
+
+    if (!cache && n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cache && throughput) {
+        fprintf(stderr, "--cache y --throughput no se pueden combinar.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cache && !repeticiones_indicadas) {
+        repeticiones = CACHE_REPETICIONES;
+    }
+    if (throughput && !repeticiones_indicadas) {
+        repeticiones = THROUGHPUT_REPETICIONES;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    int num_seleccionados = 0;
+    for (int i = 0; i < registro_num; i++) {
+        num_seleccionados += seleccionado(registro_tabla[i], kernels, tipos);
+    }
+    if (num_seleccionados == 0) {
+        fprintf(stderr, "Ningún kernel registrado coincide con --kernel y --type (ver --list).\n");
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    unsigned int seed = (texto_seed != NULL) ? (unsigned int)atoi(texto_seed) : (unsigned int)time(NULL);
+    printf("Seed: %u\n", seed);
+    printf("Memoria pedida: %s\n", memoria);
+
+    if (cache) {
+        return modo_cache(kernels, tipos, seed, rand_libc, memoria, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (throughput) {
+        return modo_throughput(kernels, tipos, n, seed, rand_libc, memoria, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    fila_t *filas = (fila_t *)calloc(num_seleccionados, sizeof(fila_t));
+    int num_filas = 0;
+
+    // Cada grupo (familia, medida) ocupa posiciones consecutivas de la tabla ordenada
+    for (int inicio = 0, fin; inicio < registro_num; inicio = fin) {
+        const registro_kernel_t *primero = registro_tabla[inicio];
+        int pedidos = 0;
+
+        for (fin = inicio; fin < registro_num; fin++) {
+            if (strcmp(registro_tabla[fin]->kernel, primero->kernel) != 0 || strcmp(registro_tabla[fin]->medida, primero->medida) != 0) {
+                break;
+            }
+            pedidos += seleccionado(registro_tabla[fin], kernels, tipos);
+        }
+        if (pedidos == 0) {
+            continue;
+        }
+
+        // Datos de entrada comunes a todas las variantes de la medida
+        int64_t num_entrada = primero->elementos_entrada(n);
+        int64_t num_salida = primero->elementos_salida(n);
+        float *entrada = (float *)malloc(num_entrada * sizeof(float));
+        float *referencia = (float *)malloc(num_salida * sizeof(float));
+        float *salida = (float *)malloc(num_salida * sizeof(float));
+
+        if (entrada == NULL || referencia == NULL || salida == NULL) {
+            printf("Error al asignar memoria\n");
+            return EXIT_FAILURE;
+        }
+
+        primero->generar(n, seed, rand_libc, entrada);
+
+        // Referencia FP32 (la primera del grupo tras ordenar, si existe); si no se ha pedido se
+        // ejecuta una vez sin medir y, si se ha pedido, se toma su resultado al medirla
+        const registro_kernel_t *kernel_referencia = strcmp(primero->tipo, "FP32") == 0 ? primero : NULL;
+        int hay_referencia = 0;
+        if (kernel_referencia != NULL && !seleccionado(kernel_referencia, kernels, tipos)) {
+            if (ejecutar_una_vez(kernel_referencia, n, entrada, memoria, referencia) != 0) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+            hay_referencia = 1;
+        }
+
+        for (int i = inicio; i < fin; i++) {
+            const registro_kernel_t *k = registro_tabla[i];
+            if (!seleccionado(k, kernels, tipos)) {
+                continue;
+            }
+
+            void *estado = k->preparar(n, entrada, memoria);
+            if (estado == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            fila_t *fila = &filas[num_filas++];
+            fila->kernel = k;
+            fila->implementacion = k->implementacion != NULL ? *k->implementacion : "-";
+            printf("Kernel: %s %s %s (%s), n = %lld\n", k->kernel, k->medida, k->tipo, fila->implementacion, (long long)n);
+
+            //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+            medir(k, estado, calentamiento, repeticiones, 1, &fila->e);
+
+            k->resultado(estado, salida);
+            k->liberar(estado);
+
+            if (k == kernel_referencia) {
+                memcpy(referencia, salida, num_salida * sizeof(float));
+                hay_referencia = 1;
+            }
+            if (hay_referencia) {
+                calcular_errores(salida, referencia, num_salida, &fila->error_rel, &fila->error_max);
+            } else {
+                fila->error_rel = NAN;
+                fila->error_max = NAN;
+            }
+            printf("Error respecto a FP32: relativo %.3e maximo %.3e\n\n", fila->error_rel, fila->error_max);
+        }
+
+        free(entrada);
+        free(referencia);
+        free(salida);
+    }
+
+    printf("bench,kernel,medida,tipo,implementacion,n,mediana,min,gflops,gbs,error_rel,error_max\n");
+    for (int i = 0; i < num_filas; i++) {
+        const fila_t *f = &filas[i];
+        const registro_kernel_t *k = f->kernel;
+        double gflops = k->flops(n) / f->e.mediana / 1e9;
+        double gbs = k->elementos(n) * k->bytes_elemento / f->e.mediana / 1e9;
+
+        printf("bench,%s,%s,%s,%s,%lld,%.9f,%.9f,%.3f,%.3f,%.3e,%.3e\n", k->kernel, k->medida, k->tipo, f->implementacion,
+               (long long)n, f->e.mediana, f->e.min, gflops, gbs, f->error_rel, f->error_max);
+    }
+
+    free(filas);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#!/bin/bash
+
+### SCRIPT DE COMPILACION PARA ARQUITECTURA AMD x86_64
+
+# Inicializar variables
+force_run=false
+additional_flags=""
+
+OBJETOS=()
+
+#--- Declaración de funciones ---#
+
+# Compila los fuentes de un programa sin su main (-DBENCH_REGISTRO) en un único objeto y hace
+# locales sus símbolos, de modo que varias variantes pueden definir las mismas funciones.
+# Uso: compilar_registro <nombre> "<flags propios>" <fuentes...>
+compilar_registro() {
+    local nombre=$1
+    local flags=$2
+    shift 2
+    local parciales=()
+
+    for fuente in "$@"; do
+        local parcial="$OBJ_DIR/${nombre}_$(basename "${fuente%.c}").o"
+        if ! $CC $COMMON_FLAGS $REGISTRO_FLAGS $flags "$fuente" -o "$parcial" $OPT_FLAGS; then
+            echo "No se pudo compilar $fuente; se omite $nombre."
+            return 1
+        fi
+        parciales+=("$parcial")
+    done
+
+    $LD -r "${parciales[@]}" -o "$OBJ_DIR/$nombre.o" && $OBJCOPY --localize-hidden "$OBJ_DIR/$nombre.o" || return 1
+    OBJETOS+=("$OBJ_DIR/$nombre.o")
+}
+
+# Compila los kernels de todos los programas y enlaza el driver
+# Uso: compilar_bench <ejecutable> <x86|ARM> (con ARM se añaden las variantes FP16_ARM)
+compilar_bench() {
+    local ejecutable=$1
+    local arquitectura=$2
+    OBJETOS=()
+
+    for programa in AXPY/axpy BLAS1/blas1 DCT/dct DWT_1D/dwt_1d PCA/pca; do
+        compilar_registro "$(basename $programa)_FP32" "" ../${programa}_FP32.c
+    done
+    compilar_registro pca_reimpl_FP32 "" ../PCA_REIMPL/pca_reimpl_FP32.c
+
+    for tipo in FP8_E4M3 FP8_E5M2 MXFP8_E4M3 MXINT8; do
+        compilar_registro axpy_$tipo "" ../AXPY/axpy_$tipo.c
+    done
+
+    # Tipos de 16 bits: los mismos flags que los programas base de cada directorio
+    if [[ "$arquitectura" == "ARM" ]]; then
+        for programa in AXPY/axpy BLAS1/blas1 DCT/dct DWT_1D/dwt_1d PCA/pca; do
+            compilar_registro "$(basename $programa)_FP16_ARM" "" ../${programa}_FP16_ARM.c
+        done
+        compilar_registro pca_reimpl_FP16_ARM "-DUSE_FP16 $INCLUDE_DIR" ../PCA_REIMPL/pca_reimpl_FP16_ARM.c "${FILES[@]}"
+    fi
+    for programa in AXPY/axpy BLAS1/blas1 DCT/dct DWT_1D/dwt_1d PCA/pca; do
+        compilar_registro "$(basename $programa)_FP16" "-fexcess-precision=16" ../${programa}_FP16.c
+        compilar_registro "$(basename $programa)_BF16" "-fexcess-precision=16" ../${programa}_BF16.c
+    done
+    compilar_registro pca_reimpl_FP16 "-DUSE_Float16 -fexcess-precision=16 $INCLUDE_DIR" ../PCA_REIMPL/pca_reimpl_FP16.c "${FILES[@]}"
+    compilar_registro pca_reimpl_BF16 "-DUSE_BF16 -fexcess-precision=16 $INCLUDE_DIR" ../PCA_REIMPL/pca_reimpl_BF16.c "${FILES[@]}"
+
+    $CC $COMMON_FLAGS bench.c "${OBJETOS[@]}" -o "$ejecutable" $OPT_FLAGS $LINK_FLAGS
+}
+
+# Uso: $0 [--force] [opciones adicionales]
+usage() {
+    # Mostrar ayuda de uso del script
+    echo "Uso: $0 [-f|--force] [opciones adicionales]"
+    echo "  -f, --force       Fuerza la compilación cruzada de todos los programas a la arquitectura aarch64."
+    echo "  -h, --help        Muestra esta ayuda y sale."
+    exit 0
+}
+
+# Procesar argumentos manualmente
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        -f|--force)
+            force_run=true
+            shift
+            ;;
+        -h|--help)
+            usage
+            ;;            
+        --)  # Fin de las opciones
+            shift
+            break
+            ;;
+        -*)
+            # Flags adicionales para el compilador
+            additional_flags+=" $1"
+            echo "Flag adicional añadido para compilar: $1"
+            shift
+            ;;
+        *)
+            # Argumentos posicionales (tamaño N, seed, etc.)
+            break
+            ;;
+    esac
+done
+
+COMMON_FLAGS="-Wall -g -fopenmp"
+
+OPT_FLAGS="-mf16c -O3 -fomit-frame-pointer $additional_flags"
+
+LINK_FLAGS="-lm -lpthread -llapacke -llapack -lblas"
+
+# Cada programa se compila como objeto sin main y con los símbolos ocultos (ver registro.h)
+REGISTRO_FLAGS="-c -DBENCH_REGISTRO -fvisibility=hidden"
+
+INCLUDE_DIR="-I../PCA_REIMPL/functions-adapted/include"
+
+# Obtener el directorio donde está ubicado el script
+script_dir="$(dirname "$0")"
+
+# Cambiar al directorio del script
+cd "$script_dir"
+
+# Fuentes de LAPACK reimplementadas en media precisión que enlazan pca_reimpl_FP16 y pca_reimpl_BF16
+FILES=()
+for dir in src utils fortran_sourced; do
+    for file in ../PCA_REIMPL/functions-adapted/"$dir"/*.c; do
+        [ -e "$file" ] && FILES+=("$file")
+    done
+done
+
+# Objetos intermedios en un directorio temporal que se borra al terminar
+OBJ_DIR=$(mktemp -d)
+trap 'rm -rf "$OBJ_DIR"' EXIT
+
+
+### COMPILACION DEL PROGRAMA UNIFICADO
+
+CC=gcc-14
+LD=ld
+OBJCOPY=objcopy
+compilar_bench bench x86
+
+
+# Compilación cruzada para ARM de 64 bits
+
+if $force_run; then
+
+    echo "Flag [-f]--force detectada. Cross-compilando programas para arquitectura ARM."
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    CC=aarch64-linux-gnu-gcc-14
+    LD=aarch64-linux-gnu-ld
+    OBJCOPY=aarch64-linux-gnu-objcopy
+    COMMON_FLAGS="-Wall -fopenmp"
+    OPT_FLAGS="$additional_flags"
+    compilar_bench bench.out ARM
+
+fi
+
+exit 0
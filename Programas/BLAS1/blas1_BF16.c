@@ -0,0 +1,1019 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __aarch64__
+#include <arm_bf16.h>
+#endif
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
+#define N_SMALL 5
+
+// Número de elementos __bf16 en un registro de 512 bits
+#define LANES_AVX512 32
+// Número de elementos __bf16 que se ensanchan a un registro float de 512 bits
+#define LANES_AVX512_FLOAT 16
+// Número de elementos __bf16 que se ensanchan a un registro float de 256 bits
+#define LANES_AVX2 8
+
+/*
+    Rutinas BLAS de nivel 1 (dot, nrm2, scal, swap y copy) adaptadas de hfdot, hfnrm2, hfscal,
+    hfswap y hfcopy de PCA_REIMPL para incremento unitario. Las reducciones (dot y nrm2) acumulan
+    en float, como hfnrm2, porque con 8 bits de mantisa la suma de n productos deja de crecer en
+    cuanto n es grande; scal redondea cada producto a __bf16 y swap y copy solo mueven datos.
+*/
+
+// Producto escalar (versión escalar, empleada como referencia y como fallback)
+float dot_escalar(int64_t n, const __bf16 *x, const __bf16 *y) {
+    float suma = 0.0f;
+    for (int64_t i = 0; i < n; i++) {
+        suma += (float)x[i] * (float)y[i];
+    }
+    return suma;
+}
+
+// Suma de cuadrados para nrm2 (versión escalar)
+float suma_cuadrados_escalar(int64_t n, const __bf16 *x) {
+    float suma = 0.0f;
+    for (int64_t i = 0; i < n; i++) {
+        suma += (float)x[i] * (float)x[i];
+    }
+    return suma;
+}
+
+// Escalado x = a * x (versión escalar)
+void scal_escalar(int64_t n, __bf16 a, __bf16 *x) {
+    for (int64_t i = 0; i < n; i++) {
+        x[i] = a * x[i];
+    }
+}
+
+#ifdef __x86_64__
+
+// Ensancha un bfloat16 (sus 16 bits) a float desplazándolo a la mitad alta de la palabra
+static inline float bf16_bits_a_float(uint16_t h) {
+    uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// Estrecha un float a bfloat16 con redondeo al par más cercano (los NaN se mantienen silenciosos)
+static inline uint16_t float_a_bf16_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return (uint16_t)((bits >> 16) | 0x0040u);
+    }
+    return (uint16_t)((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+// Ensancha 8 bfloat16 a float (desplazamiento de 16 bits en cada palabra)
+__attribute__((target("avx2,fma")))
+static inline __m256 bf16_a_float_avx2(__m128i h) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+}
+
+// Versión vectorial de float_a_bf16_bits: deja los 16 bits del resultado en la mitad baja de cada palabra
+__attribute__((target("avx2,fma")))
+static inline __m256i float_a_bf16_avx2(__m256 v) {
+    __m256i bits = _mm256_castps_si256(v);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i redondeado = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF))), 16);
+    __m256i silencioso = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x0040));
+    __m256i es_nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+    return _mm256_blendv_epi8(redondeado, silencioso, es_nan);
+}
+
+// Suma horizontal de los 8 floats de un registro AVX
+__attribute__((target("avx2")))
+static inline float suma_horizontal_avx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+/*
+    Producto escalar con ensanchamiento emulado (AVX2 y FMA): cada bfloat16 se ensancha a float
+    con un desplazamiento de 16 bits y se acumula con vfmadd en dos registros de 8 floats.
+*/
+__attribute__((target("avx2,fma")))
+float dot_avx2(int64_t n, const __bf16 *x, const __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    const uint16_t *yb = (const uint16_t *)y;
+    __m256 suma0 = _mm256_setzero_ps();
+    __m256 suma1 = _mm256_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX2 <= n; i += 2 * LANES_AVX2) {
+        __m256 vx0 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xb + i)));
+        __m256 vx1 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xb + i + LANES_AVX2)));
+        __m256 vy0 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(yb + i)));
+        __m256 vy1 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(yb + i + LANES_AVX2)));
+        suma0 = _mm256_fmadd_ps(vx0, vy0, suma0);
+        suma1 = _mm256_fmadd_ps(vx1, vy1, suma1);
+    }
+
+    float suma = suma_horizontal_avx2(_mm256_add_ps(suma0, suma1));
+    for (; i < n; i++) {
+        suma += bf16_bits_a_float(xb[i]) * bf16_bits_a_float(yb[i]);
+    }
+    return suma;
+}
+
+// Suma de cuadrados con ensanchamiento emulado, con el mismo esquema que dot_avx2
+__attribute__((target("avx2,fma")))
+float suma_cuadrados_avx2(int64_t n, const __bf16 *x) {
+    const uint16_t *xb = (const uint16_t *)x;
+    __m256 suma0 = _mm256_setzero_ps();
+    __m256 suma1 = _mm256_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX2 <= n; i += 2 * LANES_AVX2) {
+        __m256 vx0 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xb + i)));
+        __m256 vx1 = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xb + i + LANES_AVX2)));
+        suma0 = _mm256_fmadd_ps(vx0, vx0, suma0);
+        suma1 = _mm256_fmadd_ps(vx1, vx1, suma1);
+    }
+
+    float suma = suma_horizontal_avx2(_mm256_add_ps(suma0, suma1));
+    for (; i < n; i++) {
+        suma += bf16_bits_a_float(xb[i]) * bf16_bits_a_float(xb[i]);
+    }
+    return suma;
+}
+
+// Escalado con ensanchamiento emulado: producto en float y redondeo al par con aritmética entera
+__attribute__((target("avx2,fma")))
+void scal_avx2(int64_t n, __bf16 a, __bf16 *x) {
+    uint16_t *xb = (uint16_t *)x;
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = 0;
+
+    for (; i + LANES_AVX2 <= n; i += LANES_AVX2) {
+        __m256 vx = bf16_a_float_avx2(_mm_loadu_si128((const __m128i *)(xb + i)));
+        __m256i r = float_a_bf16_avx2(_mm256_mul_ps(va, vx));
+        _mm_storeu_si128((__m128i *)(xb + i), _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1)));
+    }
+
+    float af = (float)a;
+    for (; i < n; i++) {
+        xb[i] = float_a_bf16_bits(af * bf16_bits_a_float(xb[i]));
+    }
+}
+
+/*
+    Producto escalar con AVX512-BF16: vdpbf16ps multiplica parejas de bfloat16 y acumula en
+    float, 32 elementos por instrucción sin ensanchar antes. Dos acumuladores ocultan la latencia
+    y la cola usa cargas enmascaradas (los elementos ausentes valen 0).
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512bf16")))
+float dot_avx512bf16(int64_t n, const __bf16 *x, const __bf16 *y) {
+    const uint16_t *xb = (const uint16_t *)x;
+    const uint16_t *yb = (const uint16_t *)y;
+    __m512 suma0 = _mm512_setzero_ps();
+    __m512 suma1 = _mm512_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX512 <= n; i += 2 * LANES_AVX512) {
+        __m512i vx0 = _mm512_loadu_si512(xb + i);
+        __m512i vx1 = _mm512_loadu_si512(xb + i + LANES_AVX512);
+        __m512i vy0 = _mm512_loadu_si512(yb + i);
+        __m512i vy1 = _mm512_loadu_si512(yb + i + LANES_AVX512);
+        suma0 = _mm512_dpbf16_ps(suma0, (__m512bh)vx0, (__m512bh)vy0);
+        suma1 = _mm512_dpbf16_ps(suma1, (__m512bh)vx1, (__m512bh)vy1);
+    }
+
+    for (; i < n; i += LANES_AVX512) {
+        int resto = n - i;
+        __mmask32 mascara = (resto >= LANES_AVX512) ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+        __m512i vx = _mm512_maskz_loadu_epi16(mascara, xb + i);
+        __m512i vy = _mm512_maskz_loadu_epi16(mascara, yb + i);
+        suma0 = _mm512_dpbf16_ps(suma0, (__m512bh)vx, (__m512bh)vy);
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(suma0, suma1));
+}
+
+// Suma de cuadrados con AVX512-BF16 (vdpbf16ps de x consigo mismo)
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512bf16")))
+float suma_cuadrados_avx512bf16(int64_t n, const __bf16 *x) {
+    const uint16_t *xb = (const uint16_t *)x;
+    __m512 suma0 = _mm512_setzero_ps();
+    __m512 suma1 = _mm512_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX512 <= n; i += 2 * LANES_AVX512) {
+        __m512i vx0 = _mm512_loadu_si512(xb + i);
+        __m512i vx1 = _mm512_loadu_si512(xb + i + LANES_AVX512);
+        suma0 = _mm512_dpbf16_ps(suma0, (__m512bh)vx0, (__m512bh)vx0);
+        suma1 = _mm512_dpbf16_ps(suma1, (__m512bh)vx1, (__m512bh)vx1);
+    }
+
+    for (; i < n; i += LANES_AVX512) {
+        int resto = n - i;
+        __mmask32 mascara = (resto >= LANES_AVX512) ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+        __m512i vx = _mm512_maskz_loadu_epi16(mascara, xb + i);
+        suma0 = _mm512_dpbf16_ps(suma0, (__m512bh)vx, (__m512bh)vx);
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(suma0, suma1));
+}
+
+/*
+    Escalado con AVX512-BF16: no hay multiplicación en bfloat16, así que se ensanchan 16
+    elementos a float, se multiplican y vcvtneps2bf16 los estrecha con redondeo al par.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512bf16")))
+void scal_avx512bf16(int64_t n, __bf16 a, __bf16 *x) {
+    uint16_t *xb = (uint16_t *)x;
+    __m512 va = _mm512_set1_ps((float)a);
+
+    for (int64_t i = 0; i < n; i += LANES_AVX512_FLOAT) {
+        int resto = n - i;
+        __mmask16 mascara = (resto >= LANES_AVX512_FLOAT) ? (__mmask16)0xFFFF : (__mmask16)((1u << resto) - 1);
+        __m512i x32 = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mascara, xb + i));
+        __m512 vx = _mm512_castsi512_ps(_mm512_slli_epi32(x32, 16));
+        __m256i r = (__m256i)_mm512_cvtneps_pbh(_mm512_mul_ps(va, vx));
+        _mm256_mask_storeu_epi16(xb + i, mascara, r);
+    }
+}
+#endif
+
+// Kernels BLAS1 seleccionados en tiempo de ejecución
+typedef float (*dot_kernel_t)(int64_t, const __bf16 *, const __bf16 *);
+typedef float (*suma_cuadrados_kernel_t)(int64_t, const __bf16 *);
+typedef void (*scal_kernel_t)(int64_t, __bf16, __bf16 *);
+
+static dot_kernel_t dot_kernel = dot_escalar;
+static suma_cuadrados_kernel_t suma_cuadrados_kernel = suma_cuadrados_escalar;
+static scal_kernel_t scal_kernel = scal_escalar;
+static const char *blas1_kernel_nombre = "escalar";
+
+/*
+    Función para escoger los kernels BLAS1 según las extensiones que la CPU indica mediante cpuid,
+    con el mismo criterio que en AXPY: "auto" usa AVX512-BF16 si está disponible, si no AVX2
+    (ensanchamiento emulado) y, si tampoco, los bucles escalares.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_blas1(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx512bf16 = __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+    int soporta_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512bf16 ? "avx512bf16" : (soporta_avx2 ? "avx2" : "escalar");
+    }
+    if (strcmp(pedido, "avx512bf16") == 0 && soporta_avx512bf16) {
+        dot_kernel = dot_avx512bf16;
+        suma_cuadrados_kernel = suma_cuadrados_avx512bf16;
+        scal_kernel = scal_avx512bf16;
+        blas1_kernel_nombre = "avx512bf16";
+        return 0;
+    }
+    if (strcmp(pedido, "avx2") == 0 && soporta_avx2) {
+        dot_kernel = dot_avx2;
+        suma_cuadrados_kernel = suma_cuadrados_avx2;
+        scal_kernel = scal_avx2;
+        blas1_kernel_nombre = "avx2";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        dot_kernel = dot_escalar;
+        suma_cuadrados_kernel = suma_cuadrados_escalar;
+        scal_kernel = scal_escalar;
+        blas1_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Producto escalar x · y
+float dot(int64_t n, const __bf16 *x, const __bf16 *y) {
+    return dot_kernel(n, x, y);
+}
+
+// Norma euclídea de x
+float nrm2(int64_t n, const __bf16 *x) {
+    return sqrtf(suma_cuadrados_kernel(n, x));
+}
+
+// Escalado x = a * x
+void scal(int64_t n, __bf16 a, __bf16 *x) {
+    scal_kernel(n, a, x);
+}
+
+// Intercambio de x e y (solo movimiento de datos, el compilador lo vectoriza)
+void swap(int64_t n, __bf16 *x, __bf16 *y) {
+    for (int64_t i = 0; i < n; i++) {
+        __bf16 temporal = x[i];
+        x[i] = y[i];
+        y[i] = temporal;
+    }
+}
+
+// Copia y = x
+void copy(int64_t n, const __bf16 *x, __bf16 *y) {
+    memcpy(y, x, (size_t)n * sizeof(__bf16));
+}
+
+// Rutinas que se miden, en el orden en que se ejecutan
+enum { RUTINA_DOT, RUTINA_NRM2, RUTINA_SCAL, RUTINA_SWAP, RUTINA_COPY, NUM_RUTINAS };
+
+static const char *nombres_rutinas[NUM_RUTINAS] = {"dot", "nrm2", "scal", "swap", "copy"};
+
+// Vectores de n elementos que lee o escribe cada rutina, para calcular el ancho de banda
+static const int accesos_rutinas[NUM_RUTINAS] = {2, 1, 2, 4, 2};
+
+/*
+    Ejecuta una rutina sobre los elementos [inicio, fin): dot(x, y), nrm2(x), scal(a, y),
+    swap(x, y) y copy(x, z). Para nrm2 devuelve la suma de cuadrados, de modo que los bloques
+    de varios hilos se puedan sumar antes de la raíz; para scal, swap y copy devuelve 0.
+*/
+float ejecutar_rutina(int rutina, int64_t inicio, int64_t fin, __bf16 a, __bf16 *x, __bf16 *y, __bf16 *z) {
+    int64_t m = fin - inicio;
+
+    switch (rutina) {
+        case RUTINA_DOT:
+            return dot(m, x + inicio, y + inicio);
+        case RUTINA_NRM2:
+            return suma_cuadrados_kernel(m, x + inicio);
+        case RUTINA_SCAL:
+            scal(m, a, y + inicio);
+            break;
+        case RUTINA_SWAP:
+            swap(m, x + inicio, y + inicio);
+            break;
+        case RUTINA_COPY:
+            copy(m, x + inicio, z + inicio);
+            break;
+    }
+    return 0.0f;
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(__bf16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Rutina multihilo con reparto estático; las reducciones parciales se suman con reduction
+float ejecutar_rutina_multihilo(int rutina, int64_t n, __bf16 a, __bf16 *x, __bf16 *y, __bf16 *z, int hilos) {
+    float suma = 0.0f;
+
+    #pragma omp parallel num_threads(hilos) reduction(+:suma)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            suma += ejecutar_rutina(rutina, inicio, fin, a, x, y, z);
+        }
+    }
+    return suma;
+}
+
+/*
+    Copia paralela con el mismo reparto que ejecutar_rutina_multihilo. Cada hilo es el primero en
+    escribir (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, __bf16 *destino, const __bf16 *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(__bf16));
+        }
+    }
+}
+
+/*
+    Deshace el efecto de la vuelta anterior de una rutina para que todas las repeticiones partan
+    de los mismos datos: scal vuelve a copiar y desde y_inicial y swap se deshace con un segundo
+    intercambio. dot, nrm2 y copy no modifican sus entradas.
+*/
+void restaurar_rutina(int rutina, int64_t n, __bf16 *x, __bf16 *y, const __bf16 *y_inicial, int hilos) {
+    if (rutina == RUTINA_SCAL) {
+        copiar_multihilo(n, y, y_inicial, hilos);
+    } else if (rutina == RUTINA_SWAP) {
+        ejecutar_rutina_multihilo(RUTINA_SWAP, n, (__bf16)0.0f, x, y, NULL, hilos);
+    }
+}
+
+// Imprime el tiempo (mediana de las repeticiones) y el ancho de banda de una rutina y, en las reducciones, su error relativo
+void imprimir_rutina(int rutina, int64_t n, cronometro_t *cronometro, float resultado, double referencia) {
+    printf("Rutina: %s\n", nombres_rutinas[rutina]);
+    double tiempo = cronometro_imprimir(cronometro);
+    printf("Ancho de banda: %f GB/s\n", (double)accesos_rutinas[rutina] * n * sizeof(__bf16) / tiempo / 1e9);
+    if (rutina == RUTINA_DOT || rutina == RUTINA_NRM2) {
+        printf("Resultado: %f Error relativo: %e\n", resultado, fabs((double)resultado - referencia) / referencia);
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide las rutinas para cada tamaño de la lista en un único proceso. Los
+    vectores se reservan e inicializan una vez con el mayor tamaño y cada tamaño usa sus n primeros
+    elementos, partiendo de las copias iniciales de x e y. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    int64_t maximo = barrido->maximo;
+    __bf16 a = 2.3752f;
+
+    __bf16 *x = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *y = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *z = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *x_inicial = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+    __bf16 *y_inicial = (__bf16 *)memoria_reservar(maximo * sizeof(__bf16));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(z);
+        memoria_liberar(x_inicial);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        x[i] = (__bf16)(u[0] * 10.0f);
+        y[i] = (__bf16)(u[1] * 10.0f);
+    );
+    memset(z, 0, maximo * sizeof(__bf16));
+    memcpy(x_inicial, x, maximo * sizeof(__bf16));
+    memcpy(y_inicial, y, maximo * sizeof(__bf16));
+
+    // Suma de los resultados de las reducciones, que se imprime para que no se eliminen
+    double suma_resultados = 0.0;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        memcpy(x, x_inicial, n * sizeof(__bf16));
+        memcpy(y, y_inicial, n * sizeof(__bf16));
+
+        for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+            cronometro_t cronometro;
+            float resultado = 0.0f;
+
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                if (cronometro.vuelta > 0) {
+                    restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+                }
+                cronometro_arrancar(&cronometro);
+                resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+                cronometro_parar(&cronometro);
+            }
+            suma_resultados += resultado;
+            barrido_imprimir(&cronometro, nombres_rutinas[rutina], n);
+        }
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)z[n-1], (float)z[n-1]);
+    printf("Suma de resultados: %f\n", suma_resultados);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|avx2|avx512bf16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|avx2|avx512bf16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (seleccionar_kernel_blas1(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel BLAS1 no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel BLAS1: %s\n", blas1_kernel_nombre);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    __bf16 a = 2.3752f;
+    __bf16 *x_small = (__bf16 *)malloc(N_SMALL * sizeof(__bf16));
+    __bf16 *y_small = (__bf16 *)malloc(N_SMALL * sizeof(__bf16));
+
+    if (x_small == NULL || y_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        x_small[i] = (__bf16)(u[0] * 10.0f);
+        y_small[i] = (__bf16)(u[1] * 10.0f);
+    );
+
+    printf("Array x_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", (float)x_small[i]);
+    }
+    printf("]\nArray y_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", (float)y_small[i]);
+    }
+    printf("]\n");
+
+    printf("dot(x_small, y_small): %f\n", dot(N_SMALL, x_small, y_small));
+    printf("nrm2(x_small): %f\n", nrm2(N_SMALL, x_small));
+
+    free(x_small);
+    free(y_small);
+
+    __bf16 *x = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *y = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *z = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *x_inicial = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *y_inicial = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        x[i] = (__bf16)(u[0] * 10.0f);
+        y[i] = (__bf16)(u[1] * 10.0f);
+    );
+    memset(z, 0, n * sizeof(__bf16));
+    memcpy(x_inicial, x, n * sizeof(__bf16));
+    memcpy(y_inicial, y, n * sizeof(__bf16));
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "bfloat16", "blas1", blas1_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", (float)y[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)y[i]);
+        }
+    }
+
+    // Referencias en double de las reducciones, calculadas sobre los mismos datos __bf16
+    double referencia_dot = 0.0, referencia_nrm2 = 0.0;
+    for (int64_t i = 0; i < n; i++) {
+        referencia_dot += (double)x[i] * (double)y[i];
+        referencia_nrm2 += (double)x[i] * (double)x[i];
+    }
+    referencia_nrm2 = sqrt(referencia_nrm2);
+
+    /*
+        Se mide cada rutina por separado, en el orden dot, nrm2, scal, swap y copy, con el
+        calentamiento y las repeticiones pedidos. Al terminar, z contiene a * y (scal sobre y,
+        intercambio con x y copia de x en z).
+    */
+    for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+        cronometro_t cronometro;
+        float resultado = 0.0f;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            if (cronometro.vuelta > 0) {
+                restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+            }
+            cronometro_arrancar(&cronometro);
+            resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+            cronometro_parar(&cronometro);
+        }
+
+        if (rutina == RUTINA_NRM2) {
+            resultado = sqrtf(resultado);
+        }
+        imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", (float)z[n-1], (float)z[n-1]);
+
+    if(verbose){
+        printf("Resultados ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", (float)z[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)z[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se miden las rutinas con 1, 2, 4, ... hasta hilos_max hilos, partiendo en
+        cada caso de copias de x e y inicializadas en paralelo con el mismo reparto estático (first
+        touch). Las repeticiones restauran los datos con el mismo reparto (ver restaurar_rutina).
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            __bf16 *x_hilos = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+            __bf16 *y_hilos = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+            __bf16 *z_hilos = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+
+            if (x_hilos == NULL || y_hilos == NULL || z_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x_inicial, hilos);
+            copiar_multihilo(n, y_hilos, y_inicial, hilos);
+            copiar_multihilo(n, z_hilos, z, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+                cronometro_t cronometro;
+                float resultado = 0.0f;
+
+                cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+                while (cronometro_continuar(&cronometro)) {
+                    if (cronometro.vuelta > 0) {
+                        restaurar_rutina(rutina, n, x_hilos, y_hilos, y_inicial, hilos);
+                    }
+                    cronometro_arrancar(&cronometro);
+                    resultado = ejecutar_rutina_multihilo(rutina, n, a, x_hilos, y_hilos, z_hilos, hilos);
+                    cronometro_parar(&cronometro);
+                }
+
+                if (rutina == RUTINA_NRM2) {
+                    resultado = sqrtf(resultado);
+                }
+                imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+            }
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+            memoria_liberar(z_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    // Liberar memoria asignada
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+
+
+    return EXIT_SUCCESS;
+}
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de las rutinas en el programa unificado (Programas/BENCH, ver registro.h) como
+    medidas de la familia blas1, con x e y en __bf16 repartidos como en --sweep. scal escala y,
+    swap intercambia x e y y copy copia x en y, así que esos vectores se restauran antes de cada
+    vuelta. El kernel se escoge con cpuid ("auto").
+*/
+REGISTRO_TIPO(blas1_tipo, __bf16, (__bf16), (float))
+
+static const registro_forma_t blas1_forma_reduccion = {.entradas = 2, .vectores = 2, .salida = REGISTRO_ESCALAR, .restaurar = 0};
+static const registro_forma_t blas1_forma_scal = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+static const registro_forma_t blas1_forma_swap = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = (1u << 0) | (1u << 1)};
+static const registro_forma_t blas1_forma_copy = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 0};
+
+static void *blas1_preparar(int64_t n, const float *entrada, const char *memoria, const registro_forma_t *forma) {
+    seleccionar_kernel_blas1("auto");
+    return registro_vectores_crear(n, entrada, memoria, &blas1_tipo, forma);
+}
+
+static void *blas1_preparar_reduccion(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_reduccion);
+}
+
+static void *blas1_preparar_scal(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_scal);
+}
+
+static void *blas1_preparar_swap(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_swap);
+}
+
+static void *blas1_preparar_copy(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_copy);
+}
+
+static void blas1_ejecutar_dot(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = dot(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_nrm2(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = nrm2(estado->n, estado->v[0]);
+}
+
+static void blas1_ejecutar_scal(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    scal(estado->n, 2.3752f, estado->v[1]);
+}
+
+static void blas1_ejecutar_swap(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    swap(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_copy(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    copy(estado->n, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py (flops y vectores de n elementos leídos o escritos)
+static double blas1_flops_dot(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_flops_scal(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_flops_nulos(int64_t n) {
+    (void)n;
+    return 0.0;
+}
+
+static double blas1_trafico_uno(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_trafico_dos(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_trafico_cuatro(int64_t n) {
+    return 4.0 * (double)n;
+}
+
+static const registro_kernel_t registro_dot = {
+    .kernel = "blas1",
+    .medida = "dot",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_dot,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_dot)
+
+static const registro_kernel_t registro_nrm2 = {
+    .kernel = "blas1",
+    .medida = "nrm2",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_nrm2,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_uno,
+};
+REGISTRO_KERNEL(registro_nrm2)
+
+static const registro_kernel_t registro_scal = {
+    .kernel = "blas1",
+    .medida = "scal",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_scal,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_scal,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_scal,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_scal)
+
+static const registro_kernel_t registro_swap = {
+    .kernel = "blas1",
+    .medida = "swap",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_swap,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_swap,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_cuatro,
+};
+REGISTRO_KERNEL(registro_swap)
+
+static const registro_kernel_t registro_copy = {
+    .kernel = "blas1",
+    .medida = "copy",
+    .tipo = "BF16",
+    .bytes_elemento = sizeof(__bf16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_copy,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_copy,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_copy)
+
+#endif /* BENCH_REGISTRO */
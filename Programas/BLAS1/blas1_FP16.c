@@ -0,0 +1,969 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
+#define N_SMALL 5
+
+// Número de elementos _Float16 en un registro de 512 bits
+#define LANES_AVX512 32
+// Número de elementos _Float16 que se convierten a un registro float de 512 bits
+#define LANES_AVX512_FLOAT 16
+// Número de elementos _Float16 que se convierten a un registro float de 256 bits
+#define LANES_F16C 8
+
+/*
+    Rutinas BLAS de nivel 1 (dot, nrm2, scal, swap y copy) adaptadas de hfdot, hfnrm2, hfscal,
+    hfswap y hfcopy de PCA_REIMPL para incremento unitario. Las reducciones (dot y nrm2) acumulan
+    en float, como hfnrm2, porque la suma de n productos desborda _Float16 en cuanto n crece;
+    scal redondea cada producto a _Float16 y swap y copy solo mueven datos.
+*/
+
+// Producto escalar (versión escalar, empleada como referencia y como fallback)
+float dot_escalar(int64_t n, const _Float16 *x, const _Float16 *y) {
+    float suma = 0.0f;
+    for (int64_t i = 0; i < n; i++) {
+        suma += (float)x[i] * (float)y[i];
+    }
+    return suma;
+}
+
+// Suma de cuadrados para nrm2 (versión escalar)
+float suma_cuadrados_escalar(int64_t n, const _Float16 *x) {
+    float suma = 0.0f;
+    for (int64_t i = 0; i < n; i++) {
+        suma += (float)x[i] * (float)x[i];
+    }
+    return suma;
+}
+
+// Escalado x = a * x (versión escalar)
+void scal_escalar(int64_t n, _Float16 a, _Float16 *x) {
+    for (int64_t i = 0; i < n; i++) {
+        x[i] = a * x[i];
+    }
+}
+
+#ifdef __x86_64__
+
+// Suma horizontal de los 8 floats de un registro AVX
+__attribute__((target("avx2")))
+static inline float suma_horizontal_avx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+/*
+    Producto escalar con F16C y FMA: se ensanchan 16 elementos por iteración con vcvtph2ps y se
+    acumulan en dos registros de 8 floats para ocultar la latencia de vfmadd.
+*/
+__attribute__((target("avx2,fma,f16c")))
+float dot_f16c(int64_t n, const _Float16 *x, const _Float16 *y) {
+    __m256 suma0 = _mm256_setzero_ps();
+    __m256 suma1 = _mm256_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_F16C <= n; i += 2 * LANES_F16C) {
+        __m256 vx0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m256 vx1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i + LANES_F16C)));
+        __m256 vy0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(y + i)));
+        __m256 vy1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(y + i + LANES_F16C)));
+        suma0 = _mm256_fmadd_ps(vx0, vy0, suma0);
+        suma1 = _mm256_fmadd_ps(vx1, vy1, suma1);
+    }
+
+    float suma = suma_horizontal_avx2(_mm256_add_ps(suma0, suma1));
+    for (; i < n; i++) {
+        suma += (float)x[i] * (float)y[i];
+    }
+    return suma;
+}
+
+// Suma de cuadrados con F16C y FMA, con el mismo esquema que dot_f16c
+__attribute__((target("avx2,fma,f16c")))
+float suma_cuadrados_f16c(int64_t n, const _Float16 *x) {
+    __m256 suma0 = _mm256_setzero_ps();
+    __m256 suma1 = _mm256_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_F16C <= n; i += 2 * LANES_F16C) {
+        __m256 vx0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        __m256 vx1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i + LANES_F16C)));
+        suma0 = _mm256_fmadd_ps(vx0, vx0, suma0);
+        suma1 = _mm256_fmadd_ps(vx1, vx1, suma1);
+    }
+
+    float suma = suma_horizontal_avx2(_mm256_add_ps(suma0, suma1));
+    for (; i < n; i++) {
+        suma += (float)x[i] * (float)x[i];
+    }
+    return suma;
+}
+
+/*
+    Escalado con F16C: el producto de dos _Float16 es exacto en float, por lo que estrecharlo con
+    vcvtps2ph da el mismo resultado que la multiplicación en _Float16.
+*/
+__attribute__((target("avx2,fma,f16c")))
+void scal_f16c(int64_t n, _Float16 a, _Float16 *x) {
+    __m256 va = _mm256_set1_ps((float)a);
+    int64_t i = 0;
+
+    for (; i + LANES_F16C <= n; i += LANES_F16C) {
+        __m256 vx = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(x + i)));
+        _mm_storeu_si128((__m128i *)(x + i), _mm256_cvtps_ph(_mm256_mul_ps(va, vx), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    for (; i < n; i++) {
+        x[i] = (_Float16)((float)a * (float)x[i]);
+    }
+}
+
+/*
+    Producto escalar con AVX-512: las reducciones no pueden acumular en _Float16, así que cada
+    bloque de 32 elementos se ensancha a dos registros de 16 floats. Esta conversión es la que
+    limita el rendimiento frente a scal, que opera directamente en _Float16.
+    La cola se procesa con cargas enmascaradas (los elementos ausentes valen 0).
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+float dot_avx512fp16(int64_t n, const _Float16 *x, const _Float16 *y) {
+    __m512 suma0 = _mm512_setzero_ps();
+    __m512 suma1 = _mm512_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX512_FLOAT <= n; i += 2 * LANES_AVX512_FLOAT) {
+        __m512 vx0 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(x + i)));
+        __m512 vx1 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(x + i + LANES_AVX512_FLOAT)));
+        __m512 vy0 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(y + i)));
+        __m512 vy1 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(y + i + LANES_AVX512_FLOAT)));
+        suma0 = _mm512_fmadd_ps(vx0, vy0, suma0);
+        suma1 = _mm512_fmadd_ps(vx1, vy1, suma1);
+    }
+
+    for (; i < n; i += LANES_AVX512_FLOAT) {
+        int resto = n - i;
+        __mmask16 mascara = (resto >= LANES_AVX512_FLOAT) ? (__mmask16)0xFFFF : (__mmask16)((1u << resto) - 1);
+        __m512 vx = _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mascara, x + i));
+        __m512 vy = _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mascara, y + i));
+        suma0 = _mm512_fmadd_ps(vx, vy, suma0);
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(suma0, suma1));
+}
+
+// Suma de cuadrados con AVX-512, con el mismo esquema que dot_avx512fp16
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+float suma_cuadrados_avx512fp16(int64_t n, const _Float16 *x) {
+    __m512 suma0 = _mm512_setzero_ps();
+    __m512 suma1 = _mm512_setzero_ps();
+    int64_t i = 0;
+
+    for (; i + 2 * LANES_AVX512_FLOAT <= n; i += 2 * LANES_AVX512_FLOAT) {
+        __m512 vx0 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(x + i)));
+        __m512 vx1 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(x + i + LANES_AVX512_FLOAT)));
+        suma0 = _mm512_fmadd_ps(vx0, vx0, suma0);
+        suma1 = _mm512_fmadd_ps(vx1, vx1, suma1);
+    }
+
+    for (; i < n; i += LANES_AVX512_FLOAT) {
+        int resto = n - i;
+        __mmask16 mascara = (resto >= LANES_AVX512_FLOAT) ? (__mmask16)0xFFFF : (__mmask16)((1u << resto) - 1);
+        __m512 vx = _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mascara, x + i));
+        suma0 = _mm512_fmadd_ps(vx, vx, suma0);
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(suma0, suma1));
+}
+
+// Escalado con AVX512-FP16: vmulph sobre 32 elementos por registro y cola enmascarada
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512fp16")))
+void scal_avx512fp16(int64_t n, _Float16 a, _Float16 *x) {
+    __m512h va = _mm512_set1_ph(a);
+
+    for (int64_t i = 0; i < n; i += LANES_AVX512) {
+        int resto = n - i;
+        __mmask32 mascara = (resto >= LANES_AVX512) ? (__mmask32)0xFFFFFFFFu : (__mmask32)((1u << resto) - 1);
+        __m512h vx = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mascara, x + i));
+        _mm512_mask_storeu_epi16(x + i, mascara, _mm512_castph_si512(_mm512_mul_ph(va, vx)));
+    }
+}
+#endif
+
+// Kernels BLAS1 seleccionados en tiempo de ejecución
+typedef float (*dot_kernel_t)(int64_t, const _Float16 *, const _Float16 *);
+typedef float (*suma_cuadrados_kernel_t)(int64_t, const _Float16 *);
+typedef void (*scal_kernel_t)(int64_t, _Float16, _Float16 *);
+
+static dot_kernel_t dot_kernel = dot_escalar;
+static suma_cuadrados_kernel_t suma_cuadrados_kernel = suma_cuadrados_escalar;
+static scal_kernel_t scal_kernel = scal_escalar;
+static const char *blas1_kernel_nombre = "escalar";
+
+/*
+    Función para escoger los kernels BLAS1 según las extensiones que la CPU indica mediante cpuid,
+    con el mismo criterio que en AXPY: "auto" usa AVX512-FP16 si está disponible, si no F16C y,
+    si tampoco, los bucles escalares.
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_blas1(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx512fp16 = __builtin_cpu_supports("avx512fp16");
+    int soporta_f16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("avx2");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512fp16 ? "avx512fp16" : (soporta_f16c ? "f16c" : "escalar");
+    }
+    if (strcmp(pedido, "avx512fp16") == 0 && soporta_avx512fp16) {
+        dot_kernel = dot_avx512fp16;
+        suma_cuadrados_kernel = suma_cuadrados_avx512fp16;
+        scal_kernel = scal_avx512fp16;
+        blas1_kernel_nombre = "avx512fp16";
+        return 0;
+    }
+    if (strcmp(pedido, "f16c") == 0 && soporta_f16c) {
+        dot_kernel = dot_f16c;
+        suma_cuadrados_kernel = suma_cuadrados_f16c;
+        scal_kernel = scal_f16c;
+        blas1_kernel_nombre = "f16c";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        dot_kernel = dot_escalar;
+        suma_cuadrados_kernel = suma_cuadrados_escalar;
+        scal_kernel = scal_escalar;
+        blas1_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+// Producto escalar x · y
+float dot(int64_t n, const _Float16 *x, const _Float16 *y) {
+    return dot_kernel(n, x, y);
+}
+
+// Norma euclídea de x
+float nrm2(int64_t n, const _Float16 *x) {
+    return sqrtf(suma_cuadrados_kernel(n, x));
+}
+
+// Escalado x = a * x
+void scal(int64_t n, _Float16 a, _Float16 *x) {
+    scal_kernel(n, a, x);
+}
+
+// Intercambio de x e y (solo movimiento de datos, el compilador lo vectoriza)
+void swap(int64_t n, _Float16 *x, _Float16 *y) {
+    for (int64_t i = 0; i < n; i++) {
+        _Float16 temporal = x[i];
+        x[i] = y[i];
+        y[i] = temporal;
+    }
+}
+
+// Copia y = x
+void copy(int64_t n, const _Float16 *x, _Float16 *y) {
+    memcpy(y, x, (size_t)n * sizeof(_Float16));
+}
+
+// Rutinas que se miden, en el orden en que se ejecutan
+enum { RUTINA_DOT, RUTINA_NRM2, RUTINA_SCAL, RUTINA_SWAP, RUTINA_COPY, NUM_RUTINAS };
+
+static const char *nombres_rutinas[NUM_RUTINAS] = {"dot", "nrm2", "scal", "swap", "copy"};
+
+// Vectores de n elementos que lee o escribe cada rutina, para calcular el ancho de banda
+static const int accesos_rutinas[NUM_RUTINAS] = {2, 1, 2, 4, 2};
+
+/*
+    Ejecuta una rutina sobre los elementos [inicio, fin): dot(x, y), nrm2(x), scal(a, y),
+    swap(x, y) y copy(x, z). Para nrm2 devuelve la suma de cuadrados, de modo que los bloques
+    de varios hilos se puedan sumar antes de la raíz; para scal, swap y copy devuelve 0.
+*/
+float ejecutar_rutina(int rutina, int64_t inicio, int64_t fin, _Float16 a, _Float16 *x, _Float16 *y, _Float16 *z) {
+    int64_t m = fin - inicio;
+
+    switch (rutina) {
+        case RUTINA_DOT:
+            return dot(m, x + inicio, y + inicio);
+        case RUTINA_NRM2:
+            return suma_cuadrados_kernel(m, x + inicio);
+        case RUTINA_SCAL:
+            scal(m, a, y + inicio);
+            break;
+        case RUTINA_SWAP:
+            swap(m, x + inicio, y + inicio);
+            break;
+        case RUTINA_COPY:
+            copy(m, x + inicio, z + inicio);
+            break;
+    }
+    return 0.0f;
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(_Float16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Rutina multihilo con reparto estático; las reducciones parciales se suman con reduction
+float ejecutar_rutina_multihilo(int rutina, int64_t n, _Float16 a, _Float16 *x, _Float16 *y, _Float16 *z, int hilos) {
+    float suma = 0.0f;
+
+    #pragma omp parallel num_threads(hilos) reduction(+:suma)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            suma += ejecutar_rutina(rutina, inicio, fin, a, x, y, z);
+        }
+    }
+    return suma;
+}
+
+/*
+    Copia paralela con el mismo reparto que ejecutar_rutina_multihilo. Cada hilo es el primero en
+    escribir (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, _Float16 *destino, const _Float16 *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(_Float16));
+        }
+    }
+}
+
+/*
+    Deshace el efecto de la vuelta anterior de una rutina para que todas las repeticiones partan
+    de los mismos datos: scal vuelve a copiar y desde y_inicial y swap se deshace con un segundo
+    intercambio. dot, nrm2 y copy no modifican sus entradas.
+*/
+void restaurar_rutina(int rutina, int64_t n, _Float16 *x, _Float16 *y, const _Float16 *y_inicial, int hilos) {
+    if (rutina == RUTINA_SCAL) {
+        copiar_multihilo(n, y, y_inicial, hilos);
+    } else if (rutina == RUTINA_SWAP) {
+        ejecutar_rutina_multihilo(RUTINA_SWAP, n, (_Float16)0.0f, x, y, NULL, hilos);
+    }
+}
+
+// Imprime el tiempo (mediana de las repeticiones) y el ancho de banda de una rutina y, en las reducciones, su error relativo
+void imprimir_rutina(int rutina, int64_t n, cronometro_t *cronometro, float resultado, double referencia) {
+    printf("Rutina: %s\n", nombres_rutinas[rutina]);
+    double tiempo = cronometro_imprimir(cronometro);
+    printf("Ancho de banda: %f GB/s\n", (double)accesos_rutinas[rutina] * n * sizeof(_Float16) / tiempo / 1e9);
+    if (rutina == RUTINA_DOT || rutina == RUTINA_NRM2) {
+        printf("Resultado: %f Error relativo: %e\n", resultado, fabs((double)resultado - referencia) / referencia);
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide las rutinas para cada tamaño de la lista en un único proceso. Los
+    vectores se reservan e inicializan una vez con el mayor tamaño y cada tamaño usa sus n primeros
+    elementos, partiendo de las copias iniciales de x e y. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    int64_t maximo = barrido->maximo;
+    _Float16 a = 2.3752f;
+
+    _Float16 *x = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *y = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *z = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *x_inicial = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *y_inicial = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(z);
+        memoria_liberar(x_inicial);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        x[i] = (_Float16)(u[0] * 10.0f);
+        y[i] = (_Float16)(u[1] * 10.0f);
+    );
+    memset(z, 0, maximo * sizeof(_Float16));
+    memcpy(x_inicial, x, maximo * sizeof(_Float16));
+    memcpy(y_inicial, y, maximo * sizeof(_Float16));
+
+    // Suma de los resultados de las reducciones, que se imprime para que no se eliminen
+    double suma_resultados = 0.0;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        memcpy(x, x_inicial, n * sizeof(_Float16));
+        memcpy(y, y_inicial, n * sizeof(_Float16));
+
+        for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+            cronometro_t cronometro;
+            float resultado = 0.0f;
+
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                if (cronometro.vuelta > 0) {
+                    restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+                }
+                cronometro_arrancar(&cronometro);
+                resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+                cronometro_parar(&cronometro);
+            }
+            suma_resultados += resultado;
+            barrido_imprimir(&cronometro, nombres_rutinas[rutina], n);
+        }
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)z[n-1], (float)z[n-1]);
+    printf("Suma de resultados: %f\n", suma_resultados);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    const char *kernel_pedido = "auto";
+    int hilos_max = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -k <kernel>, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:t:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|f16c|avx512fp16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-k auto|escalar|f16c|avx512fp16] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (seleccionar_kernel_blas1(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel BLAS1 no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel BLAS1: %s\n", blas1_kernel_nombre);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    _Float16 a = 2.3752f;
+    _Float16 *x_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
+    _Float16 *y_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
+
+    if (x_small == NULL || y_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        x_small[i] = (_Float16)(u[0] * 10.0f);
+        y_small[i] = (_Float16)(u[1] * 10.0f);
+    );
+
+    printf("Array x_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", (float)x_small[i]);
+    }
+    printf("]\nArray y_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", (float)y_small[i]);
+    }
+    printf("]\n");
+
+    printf("dot(x_small, y_small): %f\n", dot(N_SMALL, x_small, y_small));
+    printf("nrm2(x_small): %f\n", nrm2(N_SMALL, x_small));
+
+    free(x_small);
+    free(y_small);
+
+    _Float16 *x = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *y = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *z = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *x_inicial = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *y_inicial = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        x[i] = (_Float16)(u[0] * 10.0f);
+        y[i] = (_Float16)(u[1] * 10.0f);
+    );
+    memset(z, 0, n * sizeof(_Float16));
+    memcpy(x_inicial, x, n * sizeof(_Float16));
+    memcpy(y_inicial, y, n * sizeof(_Float16));
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "blas1", blas1_kernel_nombre, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", (float)y[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)y[i]);
+        }
+    }
+
+    // Referencias en double de las reducciones, calculadas sobre los mismos datos _Float16
+    double referencia_dot = 0.0, referencia_nrm2 = 0.0;
+    for (int64_t i = 0; i < n; i++) {
+        referencia_dot += (double)x[i] * (double)y[i];
+        referencia_nrm2 += (double)x[i] * (double)x[i];
+    }
+    referencia_nrm2 = sqrt(referencia_nrm2);
+
+    /*
+        Se mide cada rutina por separado, en el orden dot, nrm2, scal, swap y copy, con el
+        calentamiento y las repeticiones pedidos. Al terminar, z contiene a * y (scal sobre y,
+        intercambio con x y copia de x en z).
+    */
+    for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+        cronometro_t cronometro;
+        float resultado = 0.0f;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            if (cronometro.vuelta > 0) {
+                restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+            }
+            cronometro_arrancar(&cronometro);
+            resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+            cronometro_parar(&cronometro);
+        }
+
+        if (rutina == RUTINA_NRM2) {
+            resultado = sqrtf(resultado);
+        }
+        imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", (float)z[n-1], (float)z[n-1]);
+
+    if(verbose){
+        printf("Resultados ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", (float)z[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)z[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se miden las rutinas con 1, 2, 4, ... hasta hilos_max hilos, partiendo en
+        cada caso de copias de x e y inicializadas en paralelo con el mismo reparto estático (first
+        touch). Las repeticiones restauran los datos con el mismo reparto (ver restaurar_rutina).
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            _Float16 *x_hilos = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+            _Float16 *y_hilos = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+            _Float16 *z_hilos = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+
+            if (x_hilos == NULL || y_hilos == NULL || z_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x_inicial, hilos);
+            copiar_multihilo(n, y_hilos, y_inicial, hilos);
+            copiar_multihilo(n, z_hilos, z, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+                cronometro_t cronometro;
+                float resultado = 0.0f;
+
+                cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+                while (cronometro_continuar(&cronometro)) {
+                    if (cronometro.vuelta > 0) {
+                        restaurar_rutina(rutina, n, x_hilos, y_hilos, y_inicial, hilos);
+                    }
+                    cronometro_arrancar(&cronometro);
+                    resultado = ejecutar_rutina_multihilo(rutina, n, a, x_hilos, y_hilos, z_hilos, hilos);
+                    cronometro_parar(&cronometro);
+                }
+
+                if (rutina == RUTINA_NRM2) {
+                    resultado = sqrtf(resultado);
+                }
+                imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+            }
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+            memoria_liberar(z_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    // Liberar memoria asignada
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+
+
+    return EXIT_SUCCESS;
+}
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de las rutinas en el programa unificado (Programas/BENCH, ver registro.h) como
+    medidas de la familia blas1, con x e y en _Float16 repartidos como en --sweep. scal escala y,
+    swap intercambia x e y y copy copia x en y, así que esos vectores se restauran antes de cada
+    vuelta. El kernel se escoge con cpuid ("auto").
+*/
+REGISTRO_TIPO(blas1_tipo, _Float16, (_Float16), (float))
+
+static const registro_forma_t blas1_forma_reduccion = {.entradas = 2, .vectores = 2, .salida = REGISTRO_ESCALAR, .restaurar = 0};
+static const registro_forma_t blas1_forma_scal = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+static const registro_forma_t blas1_forma_swap = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = (1u << 0) | (1u << 1)};
+static const registro_forma_t blas1_forma_copy = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 0};
+
+static void *blas1_preparar(int64_t n, const float *entrada, const char *memoria, const registro_forma_t *forma) {
+    seleccionar_kernel_blas1("auto");
+    return registro_vectores_crear(n, entrada, memoria, &blas1_tipo, forma);
+}
+
+static void *blas1_preparar_reduccion(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_reduccion);
+}
+
+static void *blas1_preparar_scal(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_scal);
+}
+
+static void *blas1_preparar_swap(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_swap);
+}
+
+static void *blas1_preparar_copy(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_copy);
+}
+
+static void blas1_ejecutar_dot(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = dot(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_nrm2(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = nrm2(estado->n, estado->v[0]);
+}
+
+static void blas1_ejecutar_scal(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    scal(estado->n, 2.3752f, estado->v[1]);
+}
+
+static void blas1_ejecutar_swap(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    swap(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_copy(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    copy(estado->n, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py (flops y vectores de n elementos leídos o escritos)
+static double blas1_flops_dot(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_flops_scal(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_flops_nulos(int64_t n) {
+    (void)n;
+    return 0.0;
+}
+
+static double blas1_trafico_uno(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_trafico_dos(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_trafico_cuatro(int64_t n) {
+    return 4.0 * (double)n;
+}
+
+static const registro_kernel_t registro_dot = {
+    .kernel = "blas1",
+    .medida = "dot",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_dot,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_dot)
+
+static const registro_kernel_t registro_nrm2 = {
+    .kernel = "blas1",
+    .medida = "nrm2",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_nrm2,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_uno,
+};
+REGISTRO_KERNEL(registro_nrm2)
+
+static const registro_kernel_t registro_scal = {
+    .kernel = "blas1",
+    .medida = "scal",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_scal,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_scal,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_scal,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_scal)
+
+static const registro_kernel_t registro_swap = {
+    .kernel = "blas1",
+    .medida = "swap",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_swap,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_swap,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_cuatro,
+};
+REGISTRO_KERNEL(registro_swap)
+
+static const registro_kernel_t registro_copy = {
+    .kernel = "blas1",
+    .medida = "copy",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &blas1_kernel_nombre,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_copy,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_copy,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_copy)
+
+#endif /* BENCH_REGISTRO */
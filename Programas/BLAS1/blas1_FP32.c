@@ -0,0 +1,741 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
+#define N_SMALL 5
+
+/*
+    Rutinas BLAS de nivel 1 (dot, nrm2, scal, swap y copy) adaptadas de hfdot, hfnrm2, hfscal,
+    hfswap y hfcopy de PCA_REIMPL para incremento unitario. Son bucles simples que el compilador
+    vectoriza; las reducciones llevan omp simd para que pueda reordenar la suma.
+*/
+
+// Producto escalar x · y
+float dot(int64_t n, const float *x, const float *y) {
+    float suma = 0.0f;
+    #pragma omp simd reduction(+:suma)
+    for (int64_t i = 0; i < n; i++) {
+        suma += x[i] * y[i];
+    }
+    return suma;
+}
+
+// Suma de cuadrados de x, base de nrm2
+float suma_cuadrados(int64_t n, const float *x) {
+    float suma = 0.0f;
+    #pragma omp simd reduction(+:suma)
+    for (int64_t i = 0; i < n; i++) {
+        suma += x[i] * x[i];
+    }
+    return suma;
+}
+
+// Norma euclídea de x
+float nrm2(int64_t n, const float *x) {
+    return sqrtf(suma_cuadrados(n, x));
+}
+
+// Escalado x = a * x
+void scal(int64_t n, float a, float *x) {
+    for (int64_t i = 0; i < n; i++) {
+        x[i] = a * x[i];
+    }
+}
+
+// Intercambio de x e y (solo movimiento de datos, el compilador lo vectoriza)
+void swap(int64_t n, float *x, float *y) {
+    for (int64_t i = 0; i < n; i++) {
+        float temporal = x[i];
+        x[i] = y[i];
+        y[i] = temporal;
+    }
+}
+
+// Copia y = x
+void copy(int64_t n, const float *x, float *y) {
+    memcpy(y, x, (size_t)n * sizeof(float));
+}
+
+// Rutinas que se miden, en el orden en que se ejecutan
+enum { RUTINA_DOT, RUTINA_NRM2, RUTINA_SCAL, RUTINA_SWAP, RUTINA_COPY, NUM_RUTINAS };
+
+static const char *nombres_rutinas[NUM_RUTINAS] = {"dot", "nrm2", "scal", "swap", "copy"};
+
+// Vectores de n elementos que lee o escribe cada rutina, para calcular el ancho de banda
+static const int accesos_rutinas[NUM_RUTINAS] = {2, 1, 2, 4, 2};
+
+/*
+    Ejecuta una rutina sobre los elementos [inicio, fin): dot(x, y), nrm2(x), scal(a, y),
+    swap(x, y) y copy(x, z). Para nrm2 devuelve la suma de cuadrados, de modo que los bloques
+    de varios hilos se puedan sumar antes de la raíz; para scal, swap y copy devuelve 0.
+*/
+float ejecutar_rutina(int rutina, int64_t inicio, int64_t fin, float a, float *x, float *y, float *z) {
+    int64_t m = fin - inicio;
+
+    switch (rutina) {
+        case RUTINA_DOT:
+            return dot(m, x + inicio, y + inicio);
+        case RUTINA_NRM2:
+            return suma_cuadrados(m, x + inicio);
+        case RUTINA_SCAL:
+            scal(m, a, y + inicio);
+            break;
+        case RUTINA_SWAP:
+            swap(m, x + inicio, y + inicio);
+            break;
+        case RUTINA_COPY:
+            copy(m, x + inicio, z + inicio);
+            break;
+    }
+    return 0.0f;
+}
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(float);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// Rutina multihilo con reparto estático; las reducciones parciales se suman con reduction
+float ejecutar_rutina_multihilo(int rutina, int64_t n, float a, float *x, float *y, float *z, int hilos) {
+    float suma = 0.0f;
+
+    #pragma omp parallel num_threads(hilos) reduction(+:suma)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            suma += ejecutar_rutina(rutina, inicio, fin, a, x, y, z);
+        }
+    }
+    return suma;
+}
+
+/*
+    Copia paralela con el mismo reparto que ejecutar_rutina_multihilo. Cada hilo es el primero en
+    escribir (first-touch) las páginas de su bloque, por lo que el sistema las ubica en su nodo NUMA.
+*/
+void copiar_multihilo(int64_t n, float *destino, const float *origen, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        if (fin > inicio) {
+            memcpy(destino + inicio, origen + inicio, (size_t)(fin - inicio) * sizeof(float));
+        }
+    }
+}
+
+/*
+    Deshace el efecto de la vuelta anterior de una rutina para que todas las repeticiones partan
+    de los mismos datos: scal vuelve a copiar y desde y_inicial y swap se deshace con un segundo
+    intercambio. dot, nrm2 y copy no modifican sus entradas.
+*/
+void restaurar_rutina(int rutina, int64_t n, float *x, float *y, const float *y_inicial, int hilos) {
+    if (rutina == RUTINA_SCAL) {
+        copiar_multihilo(n, y, y_inicial, hilos);
+    } else if (rutina == RUTINA_SWAP) {
+        ejecutar_rutina_multihilo(RUTINA_SWAP, n, (float)0.0f, x, y, NULL, hilos);
+    }
+}
+
+// Imprime el tiempo (mediana de las repeticiones) y el ancho de banda de una rutina y, en las reducciones, su error relativo
+void imprimir_rutina(int rutina, int64_t n, cronometro_t *cronometro, float resultado, double referencia) {
+    printf("Rutina: %s\n", nombres_rutinas[rutina]);
+    double tiempo = cronometro_imprimir(cronometro);
+    printf("Ancho de banda: %f GB/s\n", (double)accesos_rutinas[rutina] * n * sizeof(float) / tiempo / 1e9);
+    if (rutina == RUTINA_DOT || rutina == RUTINA_NRM2) {
+        printf("Resultado: %f Error relativo: %e\n", resultado, fabs((double)resultado - referencia) / referencia);
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide las rutinas para cada tamaño de la lista en un único proceso. Los
+    vectores se reservan e inicializan una vez con el mayor tamaño y cada tamaño usa sus n primeros
+    elementos, partiendo de las copias iniciales de x e y. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    int64_t maximo = barrido->maximo;
+    float a = 2.3752f;
+
+    float *x = (float *)memoria_reservar(maximo * sizeof(float));
+    float *y = (float *)memoria_reservar(maximo * sizeof(float));
+    float *z = (float *)memoria_reservar(maximo * sizeof(float));
+    float *x_inicial = (float *)memoria_reservar(maximo * sizeof(float));
+    float *y_inicial = (float *)memoria_reservar(maximo * sizeof(float));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(x);
+        memoria_liberar(y);
+        memoria_liberar(z);
+        memoria_liberar(x_inicial);
+        memoria_liberar(y_inicial);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, maximo, u, 2,
+        x[i] = u[0] * 10.0;
+        y[i] = u[1] * 10.0;
+    );
+    memset(z, 0, maximo * sizeof(float));
+    memcpy(x_inicial, x, maximo * sizeof(float));
+    memcpy(y_inicial, y, maximo * sizeof(float));
+
+    // Suma de los resultados de las reducciones, que se imprime para que no se eliminen
+    double suma_resultados = 0.0;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+        memcpy(x, x_inicial, n * sizeof(float));
+        memcpy(y, y_inicial, n * sizeof(float));
+
+        for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+            cronometro_t cronometro;
+            float resultado = 0.0f;
+
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                if (cronometro.vuelta > 0) {
+                    restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+                }
+                cronometro_arrancar(&cronometro);
+                resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+                cronometro_parar(&cronometro);
+            }
+            suma_resultados += resultado;
+            barrido_imprimir(&cronometro, nombres_rutinas[rutina], n);
+        }
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", z[n-1], z[n-1]);
+    printf("Suma de resultados: %f\n", suma_resultados);
+
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    int hilos_max = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpt:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos_max = atoi(optarg);
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // El barrido mide un solo hilo
+    if (barrido.num > 0 && hilos_max > 0) {
+        fprintf(stderr, "-t no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    if (hilos_max < 0) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    float a = 2.3752f;
+    float *x_small = (float *)malloc(N_SMALL * sizeof(float));
+    float *y_small = (float *)malloc(N_SMALL * sizeof(float));
+
+    if (x_small == NULL || y_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 2,
+        x_small[i] = u[0] * 10.0;
+        y_small[i] = u[1] * 10.0;
+    );
+
+    printf("Array x_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", x_small[i]);
+    }
+    printf("]\nArray y_small: [ ");
+    for (int i = 0; i < N_SMALL; i++) {
+        printf("%f ", y_small[i]);
+    }
+    printf("]\n");
+
+    printf("dot(x_small, y_small): %f\n", dot(N_SMALL, x_small, y_small));
+    printf("nrm2(x_small): %f\n", nrm2(N_SMALL, x_small));
+
+    free(x_small);
+    free(y_small);
+
+    float *x = (float *)memoria_reservar(n * sizeof(float));
+    float *y = (float *)memoria_reservar(n * sizeof(float));
+    float *z = (float *)memoria_reservar(n * sizeof(float));
+    float *x_inicial = (float *)memoria_reservar(n * sizeof(float));
+    float *y_inicial = (float *)memoria_reservar(n * sizeof(float));
+
+    if (x == NULL || y == NULL || z == NULL || x_inicial == NULL || y_inicial == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Generar elementos aleatorios entre 0 y 10
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        x[i] = u[0] * 10.0;
+        y[i] = u[1] * 10.0;
+    );
+    memset(z, 0, n * sizeof(float));
+    memcpy(x_inicial, x, n * sizeof(float));
+    memcpy(y_inicial, y, n * sizeof(float));
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float32", "blas1", NULL, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", y[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, y[i]);
+        }
+    }
+
+    // Referencias en double de las reducciones, calculadas sobre los mismos datos float
+    double referencia_dot = 0.0, referencia_nrm2 = 0.0;
+    for (int64_t i = 0; i < n; i++) {
+        referencia_dot += (double)x[i] * (double)y[i];
+        referencia_nrm2 += (double)x[i] * (double)x[i];
+    }
+    referencia_nrm2 = sqrt(referencia_nrm2);
+
+    /*
+        Se mide cada rutina por separado, en el orden dot, nrm2, scal, swap y copy, con el
+        calentamiento y las repeticiones pedidos. Al terminar, z contiene a * y (scal sobre y,
+        intercambio con x y copia de x en z).
+    */
+    for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+        cronometro_t cronometro;
+        float resultado = 0.0f;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            if (cronometro.vuelta > 0) {
+                restaurar_rutina(rutina, n, x, y, y_inicial, 1);
+            }
+            cronometro_arrancar(&cronometro);
+            resultado = ejecutar_rutina(rutina, 0, n, a, x, y, z);
+            cronometro_parar(&cronometro);
+        }
+
+        if (rutina == RUTINA_NRM2) {
+            resultado = sqrtf(resultado);
+        }
+        imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", z[n-1], z[n-1]);
+
+    if(verbose){
+        printf("Resultados ejecucion: ");
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", z[i]);
+        }
+        printf("\n");
+    }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, z[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    /*
+        Modo multihilo: se miden las rutinas con 1, 2, 4, ... hasta hilos_max hilos, partiendo en
+        cada caso de copias de x e y inicializadas en paralelo con el mismo reparto estático (first
+        touch). Las repeticiones restauran los datos con el mismo reparto (ver restaurar_rutina).
+    */
+    if (hilos_max > 0) {
+        printf("Modo multihilo: de 1 a %d hilos\n", hilos_max);
+
+        for (int hilos = 1; ; hilos *= 2) {
+            if (hilos > hilos_max) {
+                hilos = hilos_max;
+            }
+
+            float *x_hilos = (float *)memoria_reservar(n * sizeof(float));
+            float *y_hilos = (float *)memoria_reservar(n * sizeof(float));
+            float *z_hilos = (float *)memoria_reservar(n * sizeof(float));
+
+            if (x_hilos == NULL || y_hilos == NULL || z_hilos == NULL) {
+                printf("Error al asignar memoria\n");
+                return EXIT_FAILURE;
+            }
+
+            copiar_multihilo(n, x_hilos, x_inicial, hilos);
+            copiar_multihilo(n, y_hilos, y_inicial, hilos);
+            copiar_multihilo(n, z_hilos, z, hilos);
+
+            printf("Hilos: %d\n", hilos);
+            for (int rutina = 0; rutina < NUM_RUTINAS; rutina++) {
+                cronometro_t cronometro;
+                float resultado = 0.0f;
+
+                cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+                while (cronometro_continuar(&cronometro)) {
+                    if (cronometro.vuelta > 0) {
+                        restaurar_rutina(rutina, n, x_hilos, y_hilos, y_inicial, hilos);
+                    }
+                    cronometro_arrancar(&cronometro);
+                    resultado = ejecutar_rutina_multihilo(rutina, n, a, x_hilos, y_hilos, z_hilos, hilos);
+                    cronometro_parar(&cronometro);
+                }
+
+                if (rutina == RUTINA_NRM2) {
+                    resultado = sqrtf(resultado);
+                }
+                imprimir_rutina(rutina, n, &cronometro, resultado, rutina == RUTINA_DOT ? referencia_dot : referencia_nrm2);
+            }
+
+            memoria_liberar(x_hilos);
+            memoria_liberar(y_hilos);
+            memoria_liberar(z_hilos);
+
+            if (hilos == hilos_max) {
+                break;
+            }
+        }
+    }
+
+    // Liberar memoria asignada
+    memoria_liberar(x);
+    memoria_liberar(y);
+    memoria_liberar(z);
+    memoria_liberar(x_inicial);
+    memoria_liberar(y_inicial);
+
+
+    return EXIT_SUCCESS;
+}
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de las rutinas en el programa unificado (Programas/BENCH, ver registro.h) como
+    medidas de la familia blas1, con x e y repartidos como en --sweep. scal escala y, swap
+    intercambia x e y y copy copia x en y, así que esos vectores se restauran antes de cada
+    vuelta.
+*/
+REGISTRO_TIPO(blas1_tipo, float, (float), (float))
+
+static const registro_forma_t blas1_forma_reduccion = {.entradas = 2, .vectores = 2, .salida = REGISTRO_ESCALAR, .restaurar = 0};
+static const registro_forma_t blas1_forma_scal = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+static const registro_forma_t blas1_forma_swap = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = (1u << 0) | (1u << 1)};
+static const registro_forma_t blas1_forma_copy = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 0};
+
+static void *blas1_preparar(int64_t n, const float *entrada, const char *memoria, const registro_forma_t *forma) {
+    return registro_vectores_crear(n, entrada, memoria, &blas1_tipo, forma);
+}
+
+static void *blas1_preparar_reduccion(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_reduccion);
+}
+
+static void *blas1_preparar_scal(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_scal);
+}
+
+static void *blas1_preparar_swap(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_swap);
+}
+
+static void *blas1_preparar_copy(int64_t n, const float *entrada, const char *memoria) {
+    return blas1_preparar(n, entrada, memoria, &blas1_forma_copy);
+}
+
+static void blas1_ejecutar_dot(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = dot(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_nrm2(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    estado->escalar = nrm2(estado->n, estado->v[0]);
+}
+
+static void blas1_ejecutar_scal(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    scal(estado->n, 2.3752f, estado->v[1]);
+}
+
+static void blas1_ejecutar_swap(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    swap(estado->n, estado->v[0], estado->v[1]);
+}
+
+static void blas1_ejecutar_copy(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    copy(estado->n, estado->v[0], estado->v[1]);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py (flops y vectores de n elementos leídos o escritos)
+static double blas1_flops_dot(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_flops_scal(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_flops_nulos(int64_t n) {
+    (void)n;
+    return 0.0;
+}
+
+static double blas1_trafico_uno(int64_t n) {
+    return (double)n;
+}
+
+static double blas1_trafico_dos(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static double blas1_trafico_cuatro(int64_t n) {
+    return 4.0 * (double)n;
+}
+
+static const registro_kernel_t registro_dot = {
+    .kernel = "blas1",
+    .medida = "dot",
+    .tipo = "FP32",
+    .bytes_elemento = sizeof(float),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_dot,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_dot)
+
+static const registro_kernel_t registro_nrm2 = {
+    .kernel = "blas1",
+    .medida = "nrm2",
+    .tipo = "FP32",
+    .bytes_elemento = sizeof(float),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_uno,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_reduccion,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_nrm2,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_dot,
+    .elementos = blas1_trafico_uno,
+};
+REGISTRO_KERNEL(registro_nrm2)
+
+static const registro_kernel_t registro_scal = {
+    .kernel = "blas1",
+    .medida = "scal",
+    .tipo = "FP32",
+    .bytes_elemento = sizeof(float),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_scal,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_scal,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_scal,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_scal)
+
+static const registro_kernel_t registro_swap = {
+    .kernel = "blas1",
+    .medida = "swap",
+    .tipo = "FP32",
+    .bytes_elemento = sizeof(float),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_swap,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = blas1_ejecutar_swap,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_cuatro,
+};
+REGISTRO_KERNEL(registro_swap)
+
+static const registro_kernel_t registro_copy = {
+    .kernel = "blas1",
+    .medida = "copy",
+    .tipo = "FP32",
+    .bytes_elemento = sizeof(float),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_dos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_dos,
+    .preparar = blas1_preparar_copy,
+    .restaurar = NULL,
+    .ejecutar = blas1_ejecutar_copy,
+    .resultado = registro_vectores_resultado,
+    .liberar = registro_vectores_liberar,
+    .flops = blas1_flops_nulos,
+    .elementos = blas1_trafico_dos,
+};
+REGISTRO_KERNEL(registro_copy)
+
+#endif /* BENCH_REGISTRO */
@@ -0,0 +1,113 @@
+#!/bin/bash
+
+### SCRIPT DE COMPILACION PARA ARQUITECTURA INTEL x86_64
+
+# Inicializar variables
+force_run=false
+additional_flags=""
+
+# Uso: $0 [--force] [opciones adicionales]
+usage() {
+    # Mostrar ayuda de uso del script
+    echo "Uso: $0 [-f|--force] [opciones adicionales]"
+    echo "  -f, --force       Fuerza la compilación cruzada de todos los programas a la arquitectura aarch64."
+    echo "  -h, --help        Muestra esta ayuda y sale."
+    exit 0
+}
+
+# Procesar argumentos manualmente
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        -f|--force)
+            force_run=true
+            shift
+            ;;
+        -h|--help)
+            usage
+            ;;            
+        --)  # Fin de las opciones
+            shift
+            break
+            ;;
+        -*)
+            # Flags adicionales para el compilador
+            additional_flags+=" $1"
+            echo "Flag adicional añadido para compilar: $1"
+            shift
+            ;;
+        *)
+            # Argumentos posicionales (tamaño N, seed, etc.)
+            break
+            ;;
+    esac
+done
+
+COMMON_FLAGS="-Wall -g -fopenmp"
+
+OPT_FLAGS="-mtune=tigerlake -O3 -fomit-frame-pointer $additional_flags"
+
+LINK_FLAGS="-lm"
+
+# Obtener el directorio donde está ubicado el script
+script_dir="$(dirname "$0")"
+
+# Cambiar al directorio del script
+cd "$script_dir"
+
+
+### COMPILACION DEL PROGRAMA BASE
+
+gcc-14 $COMMON_FLAGS blas1_FP32.c -o blas1_FP32 $OPT_FLAGS $LINK_FLAGS
+
+
+if grep -q "sse2" /proc/cpuinfo; then
+    echo "SSE2 support detected. Compiling programs with reduced precision (float) data type."
+
+    ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
+
+    # Un único ejecutable: el kernel AVX512-FP16 se compila con atributos target y se
+    # selecciona en tiempo de ejecución (cpuid), por lo que no se generan variantes por CPU
+    gcc-14 $COMMON_FLAGS blas1_FP16.c -o blas1_FP16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
+
+    ### COMPILACION DEL PROGRAMA CON BFLOAT16 (EMPLEA EL TIPO DE DATO __bf16)
+
+    # Un único ejecutable: los kernels AVX2 y AVX512-BF16 se compilan con atributos target y se
+    # seleccionan en tiempo de ejecución (cpuid), por lo que no se generan variantes por CPU
+    gcc-14 $COMMON_FLAGS blas1_BF16.c -o blas1_BF16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
+
+else
+    echo "SSE2 not supported on this system. Skipping compilation for programs with reduced precision (float) data type."
+fi
+
+
+# Compilación cruzada para ARM de 64 bits
+
+if $force_run; then
+
+    echo "Flag [-f]--force detectada. Cross-compilando programas para arquitectura ARM."
+    ### COMPILACION DEL PROGRAMA BASE
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp blas1_FP32.c -o blas1_FP32.out -lm
+
+
+    ### COMPILACION DEL PROGRAMA CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO _Float16)
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp -fexcess-precision=16 blas1_FP16.c -o blas1_FP16.out -lm
+
+
+    ### COMPILACION DEL PROGRAMA CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __fp16)
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp blas1_FP16_ARM.c -o blas1_FP16_ARM.out -lm
+
+
+    ### COMPILACION DEL PROGRAMA CON BFLOAT16 PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __bf16)
+
+    # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp blas1_BF16.c -o blas1_BF16.out -lm
+
+fi
+
+exit 0
\ No newline at end of file
@@ -3,91 +3,488 @@
 #include <math.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/despacho.h"
+#include "../common/include/aleatorio.h"
+
+#define FFT_TIPO _Float16
+#include "../common/include/fft.h"
 
 #define N_SMALL 5
 
+// Hilos de la suma directa (-t)
+static int dct_hilos = 1;
+
 
-void dct(_Float16 *input, _Float16 *output, int n_size) {
-    const float pi = 3.1415926535f; // Literal float para PI
+// Estado y sumas de DCT_CARRILES valores de k (un carril por k), en float como la recurrencia original
+typedef float dct_vector_t __attribute__((vector_size(DCT_CARRILES * sizeof(float))));
+
+/*
+    Suma directa de las salidas k_inicio ... k_inicio + DCT_CARRILES - 1 (ver fft.h): cada carril
+    lleva el cos/sin del ángulo de su k y todos avanzan con la misma rotación vectorial. Al
+    empezar cada tramo de DCT_TRAMO elementos, cos y sin se leen de la tabla de cosenos. Solo
+    la salida se redondea al tipo del programa.
+*/
+DESPACHO_CUERPO void dct_cuerpo(const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t k_inicio) {
     // Precomputar raíces cuadradas
-    const _Float16 sqrt1 = (_Float16) sqrtf(1.0f / n_size); 
+    const _Float16 sqrt1 = (_Float16) sqrtf(1.0f / n_size);
+    const _Float16 sqrt2 = (_Float16) sqrtf(2.0f / n_size);
+    const int64_t periodo = 4 * n_size;
+    int64_t indice[DCT_CARRILES], salto[DCT_CARRILES];
+    dct_vector_t cos_angle, sin_angle, cos_delta, sin_delta;
+    dct_vector_t sum = {0.0f};
+
+    for (int l = 0; l < DCT_CARRILES; l++) {
+        // Los carriles que pasan de n_size repiten la última k y no se guardan
+        int64_t k = (k_inicio + l < n_size) ? k_inicio + l : n_size - 1;
+        // Ángulo del elemento n: índice k (2n + 1) mod 4n de la tabla; delta = 2k
+        indice[l] = k;
+        salto[l] = (2 * k * DCT_TRAMO) % periodo;
+        cos_delta[l] = dct_coseno(coseno, 2 * k, n_size);
+        sin_delta[l] = dct_seno(coseno, 2 * k, n_size);
+    }
+
+    for (int64_t inicio = 0; inicio < n_size; inicio += DCT_TRAMO) {
+        int64_t fin = (inicio + DCT_TRAMO < n_size) ? inicio + DCT_TRAMO : n_size;
+
+        for (int l = 0; l < DCT_CARRILES; l++) {
+            cos_angle[l] = dct_coseno(coseno, indice[l], n_size);
+            sin_angle[l] = dct_seno(coseno, indice[l], n_size);
+            indice[l] += salto[l];
+            indice[l] -= (indice[l] >= periodo) ? periodo : 0;
+        }
+
+        // Bucle interno: recurrencia de todos los carriles a la vez
+        dct_vector_t tramo = {0.0f};
+        for (int64_t n = inicio; n < fin; n++) {
+            tramo += (float)input[n] * cos_angle;
+            dct_vector_t new_cos = cos_angle * cos_delta - sin_angle * sin_delta;
+            sin_angle = sin_angle * cos_delta + cos_angle * sin_delta;
+            cos_angle = new_cos;
+        }
+        sum += tramo;
+    }
+
+    for (int l = 0; l < DCT_CARRILES && k_inicio + l < n_size; l++) {
+        _Float16 alpha = (k_inicio + l == 0) ? sqrt1 : sqrt2;
+        output[k_inicio + l] = alpha * sum[l];
+    }
+}
+
+DESPACHO_VARIANTES(dct, (const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t k_inicio), (coseno, input, output, n_size, k_inicio))
+DESPACHO_VARIANTE(dct, avx512fp16, "arch=x86-64-v4,avx512fp16", (const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t k_inicio), (coseno, input, output, n_size, k_inicio))
+
+// Variante de la DCT escogida en tiempo de ejecución (ver despacho.h)
+typedef void (*dct_kernel_t)(const _Float16 *, _Float16 *, _Float16 *, int64_t, int64_t);
+
+static dct_kernel_t dct_kernel = dct_base;
+static const char *dct_kernel_nombre = "base";
+
+// Escoge la variante de mayor nivel de ISA que soporta la CPU
+void seleccionar_kernel_dct(void) {
+    DESPACHO_PROBAR(dct, avx512fp16, DESPACHO_AVX512FP16)
+    DESPACHO_PROBAR(dct, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(dct, x86_64_v3, DESPACHO_X86_64_V3)
+    dct_kernel = dct_base;
+    dct_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+// Suma directa: los bloques de DCT_CARRILES valores de k se reparten entre dct_hilos hilos
+void dct(const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size) {
+    int64_t bloques = (n_size + DCT_CARRILES - 1) / DCT_CARRILES;
+
+    #pragma omp parallel for schedule(static) num_threads(dct_hilos)
+    for (int64_t b = 0; b < bloques; b++) {
+        dct_kernel(coseno, input, output, n_size, b * DCT_CARRILES);
+    }
+}
+
+/*
+    DCT-III (inversa de la DCT ortonormal) por carriles, con la misma tabla de cosenos: cada
+    carril es una salida i y recorre las k. El ángulo pi k (2i + 1) / 2n es el índice
+    (2i + 1) k mod 4n, que empieza en 0 y avanza 2i + 1 por elemento. Se suma con alpha_k =
+    sqrt(2/n) para todas las k y al final se corrige el término k = 0 (cos 0 = 1).
+*/
+DESPACHO_CUERPO void idct_cuerpo(const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t i_inicio) {
+    const _Float16 sqrt1 = (_Float16) sqrtf(1.0f / n_size);
     const _Float16 sqrt2 = (_Float16) sqrtf(2.0f / n_size);
-    
-    for (int k = 0; k < n_size; k++) {
-        _Float16 alpha = (k == 0) ? sqrt1 : sqrt2;
-        _Float16 sum = 0.0f;
-        // Calcular theta_k y delta para la relación de recurrencia
-        float theta_k = (pi * k) / (2.0f * n_size);
-        float delta = (pi * k) / n_size; // 2*theta_k
-        
-        // Precomputar cos(delta) y sin(delta)
-        float cos_delta = cosf(delta);
-        float sin_delta = sinf(delta);
-        
-        // Inicializar para n=0
-        float cos_angle = cosf(theta_k);
-        float sin_angle = sinf(theta_k);
-        sum += input[0] * cos_angle;
-        
-        // Bucle interno: calcular para n >= 1 usando recurrencia
-        for (int n = 1; n < n_size; n++) {
-            float new_cos = cos_angle * cos_delta - sin_angle * sin_delta;
-            float new_sin = sin_angle * cos_delta + cos_angle * sin_delta;
-            sum += input[n] * new_cos;
+    const int64_t periodo = 4 * n_size;
+    int64_t indice[DCT_CARRILES], salto[DCT_CARRILES];
+    dct_vector_t cos_angle, sin_angle, cos_delta, sin_delta;
+    dct_vector_t sum = {0.0f};
+
+    for (int l = 0; l < DCT_CARRILES; l++) {
+        // Los carriles que pasan de n_size repiten la última i y no se guardan
+        int64_t i = (i_inicio + l < n_size) ? i_inicio + l : n_size - 1;
+        indice[l] = 0;
+        salto[l] = ((2 * i + 1) * DCT_TRAMO) % periodo;
+        cos_delta[l] = dct_coseno(coseno, 2 * i + 1, n_size);
+        sin_delta[l] = dct_seno(coseno, 2 * i + 1, n_size);
+    }
+
+    for (int64_t inicio = 0; inicio < n_size; inicio += DCT_TRAMO) {
+        int64_t fin = (inicio + DCT_TRAMO < n_size) ? inicio + DCT_TRAMO : n_size;
+
+        for (int l = 0; l < DCT_CARRILES; l++) {
+            cos_angle[l] = dct_coseno(coseno, indice[l], n_size);
+            sin_angle[l] = dct_seno(coseno, indice[l], n_size);
+            indice[l] += salto[l];
+            indice[l] -= (indice[l] >= periodo) ? periodo : 0;
+        }
+
+        dct_vector_t tramo = {0.0f};
+        for (int64_t k = inicio; k < fin; k++) {
+            tramo += (float)input[k] * cos_angle;
+            dct_vector_t new_cos = cos_angle * cos_delta - sin_angle * sin_delta;
+            sin_angle = sin_angle * cos_delta + cos_angle * sin_delta;
             cos_angle = new_cos;
-            sin_angle = new_sin;
         }
-        output[k] = alpha * sum;
+        sum += tramo;
+    }
+
+    const float correccion = ((float)sqrt1 - (float)sqrt2) * (float)input[0];
+    for (int l = 0; l < DCT_CARRILES && i_inicio + l < n_size; l++) {
+        output[i_inicio + l] = sqrt2 * sum[l] + correccion;
+    }
+}
+
+DESPACHO_VARIANTES(idct, (const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t i_inicio), (coseno, input, output, n_size, i_inicio))
+DESPACHO_VARIANTE(idct, avx512fp16, "arch=x86-64-v4,avx512fp16", (const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size, int64_t i_inicio), (coseno, input, output, n_size, i_inicio))
+
+static dct_kernel_t idct_kernel = idct_base;
+static const char *idct_kernel_nombre = "base";
+
+void seleccionar_kernel_idct(void) {
+    DESPACHO_PROBAR(idct, avx512fp16, DESPACHO_AVX512FP16)
+    DESPACHO_PROBAR(idct, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(idct, x86_64_v3, DESPACHO_X86_64_V3)
+    idct_kernel = idct_base;
+    idct_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+void idct(const _Float16 *coseno, _Float16 *input, _Float16 *output, int64_t n_size) {
+    int64_t bloques = (n_size + DCT_CARRILES - 1) / DCT_CARRILES;
+
+    #pragma omp parallel for schedule(static) num_threads(dct_hilos)
+    for (int64_t b = 0; b < bloques; b++) {
+        idct_kernel(coseno, input, output, n_size, b * DCT_CARRILES);
+    }
+}
+
+// DCT-II rápida (--method fft, ver fft.h), con las mismas variantes de ISA que la suma directa
+DESPACHO_CUERPO void dct_fft_cuerpo(const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    fft_dct(plan, input, output);
+}
+
+DESPACHO_VARIANTES(dct_fft, (const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output), (plan, input, output))
+DESPACHO_VARIANTE(dct_fft, avx512fp16, "arch=x86-64-v4,avx512fp16", (const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output), (plan, input, output))
+
+typedef void (*dct_fft_kernel_t)(const fft_dct_plan_t *, _Float16 *, _Float16 *);
+
+static dct_fft_kernel_t dct_fft_kernel = dct_fft_base;
+static const char *dct_fft_kernel_nombre = "base";
+
+void seleccionar_kernel_dct_fft(void) {
+    DESPACHO_PROBAR(dct_fft, avx512fp16, DESPACHO_AVX512FP16)
+    DESPACHO_PROBAR(dct_fft, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(dct_fft, x86_64_v3, DESPACHO_X86_64_V3)
+    dct_fft_kernel = dct_fft_base;
+    dct_fft_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+void dct_fft(const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    dct_fft_kernel(plan, input, output);
+}
+
+// DCT-III rápida con el plan de la DCT-II (ver fft_idct en fft.h)
+DESPACHO_CUERPO void idct_fft_cuerpo(const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    fft_idct(plan, input, output);
+}
+
+DESPACHO_VARIANTES(idct_fft, (const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output), (plan, input, output))
+DESPACHO_VARIANTE(idct_fft, avx512fp16, "arch=x86-64-v4,avx512fp16", (const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output), (plan, input, output))
+
+static dct_fft_kernel_t idct_fft_kernel = idct_fft_base;
+static const char *idct_fft_kernel_nombre = "base";
+
+void seleccionar_kernel_idct_fft(void) {
+    DESPACHO_PROBAR(idct_fft, avx512fp16, DESPACHO_AVX512FP16)
+    DESPACHO_PROBAR(idct_fft, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(idct_fft, x86_64_v3, DESPACHO_X86_64_V3)
+    idct_fft_kernel = idct_fft_base;
+    idct_fft_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+void idct_fft(const fft_dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    idct_fft_kernel(plan, input, output);
+}
+
+// DCT con el método del plan: la rápida (--method fft) o la suma directa con la tabla de cosenos
+void dct_metodo(const dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    if (plan->fft != NULL) {
+        dct_fft(plan->fft, input, output);
+    } else {
+        dct(plan->coseno, input, output, plan->n);
+    }
+}
+
+// DCT inversa con el método y las tablas del mismo plan
+void idct_metodo(const dct_plan_t *plan, _Float16 *input, _Float16 *output) {
+    if (plan->fft != NULL) {
+        idct_fft(plan->fft, input, output);
+    } else {
+        idct(plan->coseno, input, output, plan->n);
+    }
+}
+
+/*
+    Cuantización de los coeficientes en el modo --roundtrip: cada uno se redondea al múltiplo de
+    paso más cercano, de modo que los menores que paso / 2 se truncan a 0, como en un códec por
+    transformada. Con paso 0 los coeficientes no se tocan y el error es solo el de la precisión.
+*/
+void cuantizar(_Float16 *coef, int64_t n, float paso) {
+    if (paso <= 0.0f) {
+        return;
+    }
+    const float inverso = 1.0f / paso;
+    for (int64_t i = 0; i < n; i++) {
+        coef[i] = (_Float16)(rintf((float)coef[i] * inverso) * paso);
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide la DCT para cada tamaño de la lista en un único proceso. La
+    entrada y la salida se reservan una vez con el mayor tamaño y cada medida usa sus n primeros
+    elementos (la DCT no modifica la entrada). El plan de cada tamaño (sus tablas, ver fft.h) se
+    crea antes de medirlo. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, dct_metodo_t metodo, int calentamiento, int repeticiones) {
+    int64_t maximo = barrido->maximo;
+
+    _Float16 *input = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+    _Float16 *output = (_Float16 *)memoria_reservar(maximo * sizeof(_Float16));
+
+    if (input == NULL || output == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(input);
+        memoria_liberar(output);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    ALEATORIO_RELLENAR(i, maximo, u, 1,
+        float input_temp = u[0] * 10.0f;
+        input[i] = (_Float16)input_temp;
+    );
+
+    cronometro_t cronometro;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+
+        dct_plan_t *plan = dct_plan_crear(n, metodo);
+        if (plan == NULL) {
+            printf("Error al asignar memoria\n");
+            memoria_liberar(input);
+            memoria_liberar(output);
+            return -1;
+        }
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            cronometro_arrancar(&cronometro);
+            dct_metodo(plan, input, output);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "dct", n);
+        dct_plan_liberar(plan);
     }
+    fft_cache_imprimir();
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)output[n-1], (float)output[n-1]);
+
+    memoria_liberar(input);
+    memoria_liberar(output);
+    return 0;
 }
 
+#ifndef BENCH_REGISTRO
+
 int main(int argc, char *argv[]) {
 
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
+    dct_metodo_t metodo = DCT_DIRECTA;
+    int ida_vuelta = 0;
+    float paso = 0.0f;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc, --method <direct|fft>, --roundtrip <paso>)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {"method", required_argument, NULL, OPCION_METODO},
+        {"roundtrip", required_argument, NULL, OPCION_IDA_VUELTA},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpt:w:r:H:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                dct_hilos = atoi(optarg);
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            case OPCION_METODO:
+                if (dct_metodo_leer(optarg, &metodo) != 0) {
+                    fprintf(stderr, "Método de la DCT desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_IDA_VUELTA:
+                // DCT, cuantización con este paso y DCT inversa dentro de la medida
+                ida_vuelta = 1;
+                paso = strtof(optarg, NULL);
+                if (!(paso >= 0.0f)) {
+                    fprintf(stderr, "El paso de cuantización debe ser un número no negativo: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--method direct|fft] [--roundtrip paso] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
         return EXIT_FAILURE;
-    }   
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && ida_vuelta) {
+        fprintf(stderr, "--roundtrip no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
 
-    int n = -1;
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--method direct|fft] [--roundtrip paso] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
 
-    n = atoi(argv[optind]);
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
 
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (dct_hilos < 1) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Método (ver fft.h) y variante de la DCT para esta CPU (ver despacho.h)
+    printf("Metodo DCT: %s\n", dct_metodo_nombres[metodo]);
+    if (metodo == DCT_FFT) {
+        seleccionar_kernel_dct_fft();
+        printf("Kernel DCT: %s\n", dct_fft_kernel_nombre);
+    } else {
+        seleccionar_kernel_dct();
+        printf("Kernel DCT: %s\n", dct_kernel_nombre);
+    }
+    if (ida_vuelta && metodo == DCT_FFT) {
+        seleccionar_kernel_idct_fft();
+        printf("Kernel IDCT: %s\n", idct_fft_kernel_nombre);
+    } else if (ida_vuelta) {
+        seleccionar_kernel_idct();
+        printf("Kernel IDCT: %s\n", idct_kernel_nombre);
+    }
+    if (ida_vuelta) {
+        printf("Ida y vuelta: DCT, cuantizacion con paso %g y DCT inversa\n", paso);
+    }
+
+    printf("Hilos: %d\n", dct_hilos);
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, metodo, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     _Float16 *input_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
     _Float16 *output_small = (_Float16 *)malloc(N_SMALL * sizeof(_Float16));
 
     // Se usa una semilla proporcionada como argumento o una por defecto
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
 
     // Generar elementos aleatorios entre 0 y 10
-    for (int i = 0; i < N_SMALL; i++) {
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 1,
 
-        float input_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+        float input_temp = u[0] * 10.0f;
         input_small[i] = (_Float16)input_temp;
 
-    }
+    );
 
     printf("Array input_small: [ ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -95,8 +492,15 @@ int main(int argc, char *argv[]) {
     }
     printf("]\n");
 
+    // Plan de la DCT con las tablas del método (ver fft.h)
+    dct_plan_t *plan_small = dct_plan_crear(N_SMALL, metodo);
+    if (plan_small == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+
     // Se ejecuta la operación DCT
-    dct(input_small, output_small, N_SMALL);
+    dct_metodo(plan_small, input_small, output_small);
 
     printf("Resultado DCT_small: [");
     for (int i = 0; i < N_SMALL; i++) {
@@ -104,59 +508,252 @@ int main(int argc, char *argv[]) {
     }
     printf("]\n");
 
+    // Con --roundtrip, la inversa de los coeficientes sin cuantizar debe devolver la entrada
+    if (ida_vuelta) {
+        idct_metodo(plan_small, output_small, input_small);
+        printf("Resultado IDCT_small: [");
+        for (int i = 0; i < N_SMALL; i++) {
+            printf("%f ", (float)input_small[i]);
+        }
+        printf("]\n");
+    }
+
     free(input_small);
     free(output_small);
+    dct_plan_liberar(plan_small);
 
 
-    _Float16 *input = (_Float16 *)malloc(n * sizeof(_Float16));
-    _Float16 *output = (_Float16 *)malloc(n * sizeof(_Float16));
+    _Float16 *input = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    _Float16 *output = (_Float16 *)memoria_reservar(n * sizeof(_Float16));
+    // Reconstrucción de la DCT inversa (solo con --roundtrip)
+    _Float16 *reconstruida = ida_vuelta ? (_Float16 *)memoria_reservar(n * sizeof(_Float16)) : NULL;
 
-    for (int i = 0; i < n; i++) {
-        float input_temp = ((float)rand() / (float)(RAND_MAX)) * 10.0f;
+    if (input == NULL || output == NULL || (ida_vuelta && reconstruida == NULL)) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    ALEATORIO_RELLENAR(i, n, u, 1,
+        float input_temp = u[0] * 10.0f;
         input[i] = (_Float16)input_temp;
+    );
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "dct", NULL, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
     }
 
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)input[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)input[i]);
+        }
+    }
 
-    //Para medir el tiempo de ejecución
-
-    clock_t start, end;
-    double cpu_time_used;
+    // El plan de la DCT (tablas de cosenos o de la FFT) se crea fuera de la medida
+    dct_plan_t *plan = dct_plan_crear(n, metodo);
+    if (plan == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    dct_plan_imprimir_tablas(plan);
 
-    start = clock();
-    
-    /* 
-        Código del programa cuyo tiempo quiero medir
-    */
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
 
-    // Se ejecuta la operación DCT
-    dct(input, output, n);
+    cronometro_t cronometro;
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        // Se ejecuta la operación DCT
+        dct_metodo(plan, input, output);
+        if (ida_vuelta) {
+            // Ida y vuelta: cuantización de los coeficientes y DCT inversa con el mismo plan
+            cuantizar(output, n, paso);
+            idct_metodo(plan, output, reconstruida);
+        }
+        cronometro_parar(&cronometro);
+    }
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    cronometro_imprimir(&cronometro);
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
     printf("%f %.10e\n", (float)output[n-1], (float)output[n-1]);
 
+    // Error de la reconstrucción frente a la entrada (en double)
+    if (ida_vuelta) {
+        double error_maximo = 0.0, suma_error = 0.0, suma_entrada = 0.0;
+        for (int64_t i = 0; i < n; i++) {
+            double diferencia = fabs((double)(float)reconstruida[i] - (double)(float)input[i]);
+            error_maximo = diferencia > error_maximo ? diferencia : error_maximo;
+            suma_error += diferencia * diferencia;
+            suma_entrada += (double)(float)input[i] * (double)(float)input[i];
+        }
+        printf("Error maximo de reconstruccion: %.6e\n", error_maximo);
+        printf("Error relativo de reconstruccion: %.6e\n", suma_entrada > 0.0 ? sqrt(suma_error / suma_entrada) : 0.0);
+    }
+
+    // Con --roundtrip el resultado es la señal reconstruida (la que se compara con la entrada);
+    // los coeficientes cuantizados se muestran y vuelcan aparte
+    const _Float16 *resultado = ida_vuelta ? reconstruida : output;
+
     if(verbose){
+        if (ida_vuelta) {
+            printf("Coeficientes cuantizados: ");
+            for(int64_t i = 0; i < n; i++){
+                printf("%.10e ", (float)output[i]);
+            }
+            printf("\n");
+        }
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
-            printf("%.10e ", (float)output[i]);
+        for(int64_t i = 0; i < n; i++){
+            printf("%.10e ", (float)resultado[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        if (ida_vuelta) {
+            volcado_seccion(volcado, "coeficientes", 1, n);
+            for (int64_t i = 0; i < n; i++) {
+                volcado_valor(volcado, (float)output[i]);
+            }
+        }
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)resultado[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
 
-    free(input);
-    free(output);
+    memoria_liberar(input);
+    memoria_liberar(output);
+    memoria_liberar(reconstruida);
+    dct_plan_liberar(plan);
+    fft_cache_vaciar();
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de la DCT en el programa unificado (Programas/BENCH, ver registro.h), con la entrada
+    en _Float16. La DCT rápida (ver fft.h) es la medida fft de la misma familia, con el plan
+    creado al preparar.
+*/
+REGISTRO_TIPO(dct_tipo, _Float16, (_Float16), (float))
+
+static const registro_forma_t dct_forma = {.entradas = 1, .vectores = 2, .salida = 1, .restaurar = 0};
+
+// datos: tablas de la suma directa o plan de la FFT
+static void *dct_preparar(int64_t n, const float *entrada, const char *memoria, dct_metodo_t metodo) {
+    if (metodo == DCT_FFT) {
+        seleccionar_kernel_dct_fft();
+    } else {
+        seleccionar_kernel_dct();
+    }
+
+    registro_vectores_t *estado = registro_vectores_crear(n, entrada, memoria, &dct_tipo, &dct_forma);
+    if (estado == NULL) {
+        return NULL;
+    }
+    if ((estado->datos = dct_plan_crear(n, metodo)) == NULL) {
+        registro_vectores_liberar(estado);
+        return NULL;
+    }
+    return estado;
+}
+
+static void *dct_preparar_directa(int64_t n, const float *entrada, const char *memoria) {
+    return dct_preparar(n, entrada, memoria, DCT_DIRECTA);
+}
+
+static void *dct_preparar_fft(int64_t n, const float *entrada, const char *memoria) {
+    return dct_preparar(n, entrada, memoria, DCT_FFT);
+}
+
+static void dct_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    dct_metodo(estado->datos, estado->v[0], estado->v[1]);
+}
+
+static void dct_liberar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    dct_plan_liberar(estado->datos);
+    registro_vectores_liberar(estado);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 8 operaciones por par (k, n); lee la entrada y la tabla de cosenos (2n + 1) y escribe la salida
+static double dct_flops(int64_t n) {
+    return 8.0 * (double)n * (double)n;
+}
+
+static double dct_trafico(int64_t n) {
+    return 4.0 * (double)n + 1.0;
+}
+
+// Recuento nominal de una FFT real de longitud n (2.5 n log2 n, como benchFFT); lee la entrada y escribe la salida
+static double dct_fft_flops(int64_t n) {
+    return 2.5 * (double)n * log2((double)n);
+}
+
+static double dct_fft_trafico(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static const registro_kernel_t registro_dct = {
+    .kernel = "dct",
+    .medida = "dct",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &dct_kernel_nombre,
+    .elementos_entrada = registro_elementos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_uno,
+    .preparar = dct_preparar_directa,
+    .restaurar = NULL,
+    .ejecutar = dct_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = dct_liberar,
+    .flops = dct_flops,
+    .elementos = dct_trafico,
+};
+REGISTRO_KERNEL(registro_dct)
+
+static const registro_kernel_t registro_dct_fft = {
+    .kernel = "dct",
+    .medida = "fft",
+    .tipo = "FP16",
+    .bytes_elemento = sizeof(_Float16),
+    .implementacion = &dct_fft_kernel_nombre,
+    .elementos_entrada = registro_elementos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_uno,
+    .preparar = dct_preparar_fft,
+    .restaurar = NULL,
+    .ejecutar = dct_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = dct_liberar,
+    .flops = dct_fft_flops,
+    .elementos = dct_fft_trafico,
+};
+REGISTRO_KERNEL(registro_dct_fft)
+
+#endif /* BENCH_REGISTRO */
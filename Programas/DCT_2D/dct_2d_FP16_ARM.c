@@ -0,0 +1,468 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <arm_fp16.h>
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/aleatorio.h"
+#include "../common/include/imagen.h"
+#include "../common/include/dct_2d.h"
+
+// Desplazamiento de nivel de JPEG: los píxeles [0, 255] se transforman como [-128, 127]
+#define DESPLAZAMIENTO_NIVEL 128.0f
+
+// Hilos entre los que se reparten las franjas de bloques (-t)
+static int dct_2d_hilos = 1;
+
+
+/*
+    Franja de bloques: transforma con la matriz los bloques de las filas [0, bloque) de entrada,
+    que tiene ancho columnas. El compilador vectoriza las pasadas de dct_2d.h con NEON.
+*/
+void dct_2d_franja(const float *matriz, const __fp16 *entrada, __fp16 *salida, int64_t ancho, int bloque) {
+    float x[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+
+    for (int64_t j = 0; j < ancho; j += bloque) {
+        for (int f = 0; f < bloque; f++) {
+            for (int c = 0; c < bloque; c++) {
+                x[f * bloque + c] = (float)entrada[f * ancho + j + c];
+            }
+        }
+        dct_2d_bloque_escalar(matriz, x, bloque);
+        for (int f = 0; f < bloque; f++) {
+            for (int c = 0; c < bloque; c++) {
+                salida[f * ancho + j + c] = (__fp16)x[f * bloque + c];
+            }
+        }
+    }
+}
+
+/*
+    DCT 2D por bloques de una imagen de alto x ancho (múltiplos de bloque) con la matriz de la
+    DCT-II o de la DCT-III (ver dct_2d.h): las franjas de bloque filas se reparten entre
+    dct_2d_hilos hilos.
+*/
+void dct_2d(const float *matriz, const __fp16 *entrada, __fp16 *salida, int64_t alto, int64_t ancho, int bloque) {
+    int64_t franjas = alto / bloque;
+
+    #pragma omp parallel for schedule(static) num_threads(dct_2d_hilos)
+    for (int64_t b = 0; b < franjas; b++) {
+        int64_t desplazamiento = b * bloque * ancho;
+        dct_2d_franja(matriz, entrada + desplazamiento, salida + desplazamiento, ancho, bloque);
+    }
+}
+
+// Lado redondeado al siguiente múltiplo del bloque
+static int64_t redondear_bloque(int64_t lado, int bloque) {
+    return (lado + bloque - 1) / bloque * bloque;
+}
+
+/*
+    Completa la imagen de alto x ancho píxeles hasta alto_p x ancho_p (múltiplos del bloque)
+    repitiendo el último píxel de cada fila y la última fila, como los codificadores JPEG.
+*/
+void rellenar_bordes(__fp16 *imagen, int64_t alto, int64_t ancho, int64_t alto_p, int64_t ancho_p) {
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = ancho; j < ancho_p; j++) {
+            imagen[i * ancho_p + j] = imagen[i * ancho_p + ancho - 1];
+        }
+    }
+    for (int64_t i = alto; i < alto_p; i++) {
+        memcpy(imagen + i * ancho_p, imagen + (alto - 1) * ancho_p, ancho_p * sizeof(__fp16));
+    }
+}
+
+// Escribe como PGM la zona de alto x ancho píxeles de una imagen con ancho_p columnas
+int guardar_pgm(const char *ruta, const __fp16 *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    uint8_t *pixeles = (uint8_t *)malloc((size_t)alto * (size_t)ancho);
+    int resultado;
+
+    if (pixeles == NULL) {
+        return -1;
+    }
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            pixeles[i * ancho + j] = imagen_saturar((float)imagen[i * ancho_p + j] + DESPLAZAMIENTO_NIVEL);
+        }
+    }
+    resultado = imagen_escribir_pgm(ruta, pixeles, alto, ancho);
+    free(pixeles);
+    return resultado;
+}
+
+// Imprime la zona de alto x ancho de una imagen, una fila por línea (formato de matriz de Metricas)
+void imprimir_imagen(const __fp16 *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    for (int64_t i = 0; i < alto; i++) {
+        printf("\t");
+        for (int64_t j = 0; j < ancho; j++) {
+            printf("%.10e  ", (float)imagen[i * ancho_p + j]);
+        }
+        printf("\n");
+    }
+}
+
+// Escribe la zona de alto x ancho de una imagen como sección del volcado binario (--dump)
+void volcar_imagen(volcado_t *volcado, const char *nombre, const __fp16 *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    volcado_seccion(volcado, nombre, alto, ancho);
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            volcado_valor(volcado, (float)imagen[i * ancho_p + j]);
+        }
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide la DCT-II y la DCT-III de imágenes de n x n píxeles para cada
+    n de la lista en un único proceso. Las imágenes se reservan una vez con el mayor tamaño y
+    cada medida usa sus primeros n_p x n_p píxeles (n redondeado al bloque) como una imagen
+    compacta. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, const float *directa, const float *inversa, int bloque, int calentamiento, int repeticiones) {
+    int64_t maximo = redondear_bloque(barrido->maximo, bloque);
+    int64_t pixeles = maximo * maximo;
+
+    __fp16 *entrada = (__fp16 *)memoria_reservar(pixeles * sizeof(__fp16));
+    __fp16 *coeficientes = (__fp16 *)memoria_reservar(pixeles * sizeof(__fp16));
+    __fp16 *reconstruida = (__fp16 *)memoria_reservar(pixeles * sizeof(__fp16));
+
+    if (entrada == NULL || coeficientes == NULL || reconstruida == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(entrada);
+        memoria_liberar(coeficientes);
+        memoria_liberar(reconstruida);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    ALEATORIO_RELLENAR(i, pixeles, u, 1,
+        entrada[i] = (__fp16)(floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL);
+    );
+
+    cronometro_t cronometro;
+    int64_t n_p = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n_p = redondear_bloque(barrido->tamanhos[k], bloque);
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            cronometro_arrancar(&cronometro);
+            dct_2d(directa, entrada, coeficientes, n_p, n_p, bloque);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "dct", barrido->tamanhos[k]);
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            cronometro_arrancar(&cronometro);
+            dct_2d(inversa, coeficientes, reconstruida, n_p, n_p, bloque);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "idct", barrido->tamanhos[k]);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)coeficientes[n_p * n_p - 1], (float)reconstruida[n_p * n_p - 1]);
+
+    memoria_liberar(entrada);
+    memoria_liberar(coeficientes);
+    memoria_liberar(reconstruida);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    int bloque = DCT_2D_BLOQUE;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    const char *ruta_imagen = NULL;
+    const char *prefijo_pgm = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -b <bloque>, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc, --image <ruta>, --pgm <prefijo>)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {"image", required_argument, NULL, OPCION_IMAGEN},
+        {"pgm", required_argument, NULL, OPCION_PGM},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpb:t:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 'b':
+                bloque = atoi(optarg);
+                break;
+            case 't':
+                dct_2d_hilos = atoi(optarg);
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            case OPCION_IMAGEN:
+                ruta_imagen = optarg;
+                break;
+            case OPCION_PGM:
+                prefijo_pgm = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-b 8|16] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--pgm prefijo] (<lado de la imagen> | --image ruta.pgm | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && (ruta_volcado != NULL || ruta_imagen != NULL || prefijo_pgm != NULL)) {
+        fprintf(stderr, "--dump, --image y --pgm no se pueden combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (lado y seed; con --sweep el lado es el mayor del barrido y con --image el de la imagen)
+    if (barrido.num == 0 && ruta_imagen == NULL && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-b 8|16] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--pgm prefijo] (<lado de la imagen> | --image ruta.pgm | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t alto, ancho;
+    uint8_t *pixeles = NULL;
+
+    if (ruta_imagen != NULL) {
+        pixeles = imagen_leer_pgm(ruta_imagen, &alto, &ancho);
+        if (pixeles == NULL) {
+            fprintf(stderr, "No se pudo leer la imagen (PGM binario de 8 bits): %s\n", ruta_imagen);
+            return EXIT_FAILURE;
+        }
+    } else {
+        alto = ancho = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+    }
+
+    if (ancho <= 0) {
+        fprintf(stderr, "El lado de la imagen debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!dct_2d_bloque_valido(bloque)) {
+        fprintf(stderr, "El lado del bloque debe ser 8 o 16.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (dct_2d_hilos < 1) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Bloque: %dx%d\n", bloque, bloque);
+    printf("Hilos: %d\n", dct_2d_hilos);
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    // Matrices de la DCT-II y la DCT-III del bloque (ver dct_2d.h)
+    float directa[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    float inversa[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    dct_2d_matrices(bloque, directa, inversa);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con un bloque
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, directa, inversa, bloque, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    int arg_seed = (ruta_imagen != NULL) ? optind : optind + 1;
+    unsigned int seed = (arg_seed < argc) ? (unsigned int)atoi(argv[arg_seed]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Demostración con un único bloque
+    __fp16 bloque_small[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    __fp16 resultado_small[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+
+    ALEATORIO_RELLENAR(i, bloque * bloque, u, 1,
+        bloque_small[i] = (__fp16)(floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL);
+    );
+
+    printf("Bloque input_small:\n");
+    imprimir_imagen(bloque_small, bloque, bloque, bloque);
+
+    dct_2d(directa, bloque_small, resultado_small, bloque, bloque, bloque);
+
+    printf("Resultado DCT_small:\n");
+    imprimir_imagen(resultado_small, bloque, bloque, bloque);
+
+
+    // Imagen completada hasta múltiplos del bloque
+    int64_t alto_p = redondear_bloque(alto, bloque);
+    int64_t ancho_p = redondear_bloque(ancho, bloque);
+    int64_t total = alto_p * ancho_p;
+
+    __fp16 *entrada = (__fp16 *)memoria_reservar(total * sizeof(__fp16));
+    __fp16 *coeficientes = (__fp16 *)memoria_reservar(total * sizeof(__fp16));
+    __fp16 *reconstruida = (__fp16 *)memoria_reservar(total * sizeof(__fp16));
+
+    if (entrada == NULL || coeficientes == NULL || reconstruida == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Píxeles de la imagen o enteros aleatorios en [0, 255], con el desplazamiento de nivel
+    if (pixeles != NULL) {
+        for (int64_t i = 0; i < alto; i++) {
+            for (int64_t j = 0; j < ancho; j++) {
+                entrada[i * ancho_p + j] = (__fp16)((float)pixeles[i * ancho + j] - DESPLAZAMIENTO_NIVEL);
+            }
+        }
+        free(pixeles);
+    } else {
+        ALEATORIO_RELLENAR(i, alto * ancho, u, 1,
+            entrada[(i / ancho) * ancho_p + i % ancho] = (__fp16)(floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL);
+        );
+    }
+    rellenar_bordes(entrada, alto, ancho, alto_p, ancho_p);
+
+    double megapixeles = (double)alto * (double)ancho / 1e6;
+    printf("Imagen: %lld x %lld (%.3f megapixeles)\n", (long long)alto, (long long)ancho, megapixeles);
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "dct_2d", NULL, ancho, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: \n");
+        imprimir_imagen(entrada, alto, ancho, ancho_p);
+    }
+    if (volcado != NULL) {
+        volcar_imagen(volcado, "entrada", entrada, alto, ancho, ancho_p);
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+    double mediana;
+
+    // DCT-II de todos los bloques
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        dct_2d(directa, entrada, coeficientes, alto_p, ancho_p, bloque);
+        cronometro_parar(&cronometro);
+    }
+    mediana = cronometro_imprimir(&cronometro);
+    printf("Megapixeles/s DCT-II: %.3f\n", megapixeles / mediana);
+
+    // DCT-III de los coeficientes: reconstruye la imagen
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        dct_2d(inversa, coeficientes, reconstruida, alto_p, ancho_p, bloque);
+        cronometro_parar(&cronometro);
+    }
+    mediana = cronometro_imprimir(&cronometro);
+    printf("Megapixeles/s DCT-III: %.3f\n", megapixeles / mediana);
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", (float)coeficientes[total - 1], (float)reconstruida[total - 1]);
+
+    double error_maximo = 0.0;
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            double error = fabs((double)reconstruida[i * ancho_p + j] - (double)entrada[i * ancho_p + j]);
+            error_maximo = error > error_maximo ? error : error_maximo;
+        }
+    }
+    printf("Error maximo de reconstruccion: %.6e\n", error_maximo);
+
+    if(verbose){
+        printf("Resultados ejecucion: \n");
+        imprimir_imagen(coeficientes, alto, ancho, ancho_p);
+        printf("Resultados ejecucion: \n");
+        imprimir_imagen(reconstruida, alto, ancho, ancho_p);
+    }
+    if (volcado != NULL) {
+        volcar_imagen(volcado, "resultado", coeficientes, alto, ancho, ancho_p);
+        volcar_imagen(volcado, "resultado", reconstruida, alto, ancho, ancho_p);
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    // Original y reconstruida en PGM para SSIM.py y PSNR.py (--image)
+    if (prefijo_pgm != NULL) {
+        char ruta_original[4096], ruta_reconstruida[4096];
+        snprintf(ruta_original, sizeof(ruta_original), "%s_original.pgm", prefijo_pgm);
+        snprintf(ruta_reconstruida, sizeof(ruta_reconstruida), "%s_reconstruida_FP16_ARM.pgm", prefijo_pgm);
+        if (guardar_pgm(ruta_original, entrada, alto, ancho, ancho_p) != 0 ||
+            guardar_pgm(ruta_reconstruida, reconstruida, alto, ancho, ancho_p) != 0) {
+            fprintf(stderr, "Error al escribir las imágenes: %s_*.pgm\n", prefijo_pgm);
+            return EXIT_FAILURE;
+        }
+        printf("Imagenes: %s %s\n", ruta_original, ruta_reconstruida);
+    }
+
+    memoria_liberar(entrada);
+    memoria_liberar(coeficientes);
+    memoria_liberar(reconstruida);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,626 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <stdint.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/aleatorio.h"
+#include "../common/include/imagen.h"
+#include "../common/include/dct_2d.h"
+
+// Desplazamiento de nivel de JPEG: los píxeles [0, 255] se transforman como [-128, 127]
+#define DESPLAZAMIENTO_NIVEL 128.0f
+
+// Hilos entre los que se reparten las franjas de bloques (-t)
+static int dct_2d_hilos = 1;
+
+
+/*
+    Franja de bloques (versión escalar, empleada como referencia y como fallback): transforma
+    con la matriz los bloques de las filas [0, bloque) de entrada, que tiene ancho columnas.
+*/
+void dct_2d_franja_escalar(const float *matriz, const float *entrada, float *salida, int64_t ancho, int bloque) {
+    float x[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+
+    for (int64_t j = 0; j < ancho; j += bloque) {
+        for (int f = 0; f < bloque; f++) {
+            for (int c = 0; c < bloque; c++) {
+                x[f * bloque + c] = entrada[f * ancho + j + c];
+            }
+        }
+        dct_2d_bloque_escalar(matriz, x, bloque);
+        for (int f = 0; f < bloque; f++) {
+            for (int c = 0; c < bloque; c++) {
+                salida[f * ancho + j + c] = x[f * bloque + c];
+            }
+        }
+    }
+}
+
+#ifdef __x86_64__
+
+// Carga y guardado de 8 y 16 píxeles consecutivos en un registro float
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 cargar_8_avx2(const float *p) {
+    return _mm256_loadu_ps(p);
+}
+
+__attribute__((target("avx2,fma"), always_inline))
+static inline void guardar_8_avx2(float *p, __m256 v) {
+    _mm256_storeu_ps(p, v);
+}
+
+__attribute__((target("avx512f"), always_inline))
+static inline __m512 cargar_16_avx512(const float *p) {
+    return _mm512_loadu_ps(p);
+}
+
+__attribute__((target("avx512f"), always_inline))
+static inline void guardar_16_avx512(float *p, __m512 v) {
+    _mm512_storeu_ps(p, v);
+}
+
+/*
+    Franja de bloques con AVX2 y FMA: cada bloque se carga una vez (una fila por registro, dos
+    por fila con 16x16), se transforma con las pasadas y transposiciones de dct_2d.h y se guarda.
+    Los de 8x8 se quedan en registros; los de 16x16 no caben y se desbordan en parte a la pila.
+*/
+__attribute__((target("avx2,fma")))
+void dct_2d_franja_avx2(const float *matriz, const float *entrada, float *salida, int64_t ancho, int bloque) {
+    if (bloque == 8) {
+        for (int64_t j = 0; j < ancho; j += 8) {
+            __m256 f[8];
+            for (int i = 0; i < 8; i++) {
+                f[i] = cargar_8_avx2(entrada + i * ancho + j);
+            }
+            dct_2d_8x8_avx2(matriz, f);
+            for (int i = 0; i < 8; i++) {
+                guardar_8_avx2(salida + i * ancho + j, f[i]);
+            }
+        }
+        return;
+    }
+
+    for (int64_t j = 0; j < ancho; j += 16) {
+        __m256 f[32];
+        for (int i = 0; i < 16; i++) {
+            f[2 * i] = cargar_8_avx2(entrada + i * ancho + j);
+            f[2 * i + 1] = cargar_8_avx2(entrada + i * ancho + j + 8);
+        }
+        dct_2d_16x16_avx2(matriz, f);
+        for (int i = 0; i < 16; i++) {
+            guardar_8_avx2(salida + i * ancho + j, f[2 * i]);
+            guardar_8_avx2(salida + i * ancho + j + 8, f[2 * i + 1]);
+        }
+    }
+}
+
+/*
+    Franja de bloques con AVX-512: los bloques de 16x16 ocupan un registro por fila (con
+    desbordes a la pila, ver dct_2d.h) y los de 8x8 se transforman de dos en dos (filas de 16
+    píxeles, un bloque en cada mitad). Si la franja tiene un número impar de bloques de 8x8, el
+    último se hace con los registros de 256 bits.
+*/
+__attribute__((target("avx512f,avx512bw,avx512vl,avx2,fma")))
+void dct_2d_franja_avx512(const float *matriz, const float *entrada, float *salida, int64_t ancho, int bloque) {
+    int64_t j = 0;
+
+    if (bloque == 8) {
+        for (; j + 16 <= ancho; j += 16) {
+            __m512 f[8];
+            for (int i = 0; i < 8; i++) {
+                f[i] = cargar_16_avx512(entrada + i * ancho + j);
+            }
+            dct_2d_8x8_x2_avx512(matriz, f);
+            for (int i = 0; i < 8; i++) {
+                guardar_16_avx512(salida + i * ancho + j, f[i]);
+            }
+        }
+        for (; j < ancho; j += 8) {
+            __m256 f[8];
+            for (int i = 0; i < 8; i++) {
+                f[i] = cargar_8_avx2(entrada + i * ancho + j);
+            }
+            dct_2d_8x8_avx2(matriz, f);
+            for (int i = 0; i < 8; i++) {
+                guardar_8_avx2(salida + i * ancho + j, f[i]);
+            }
+        }
+        return;
+    }
+
+    for (; j < ancho; j += 16) {
+        __m512 f[16];
+        for (int i = 0; i < 16; i++) {
+            f[i] = cargar_16_avx512(entrada + i * ancho + j);
+        }
+        dct_2d_16x16_avx512(matriz, f);
+        for (int i = 0; i < 16; i++) {
+            guardar_16_avx512(salida + i * ancho + j, f[i]);
+        }
+    }
+}
+#endif
+
+// Kernel de las franjas seleccionado en tiempo de ejecución
+typedef void (*dct_2d_kernel_t)(const float *, const float *, float *, int64_t, int);
+
+static dct_2d_kernel_t dct_2d_kernel = dct_2d_franja_escalar;
+static const char *dct_2d_kernel_nombre = "escalar";
+
+/*
+    Función para escoger el kernel según las extensiones que la CPU indica mediante cpuid. Con
+    "auto" se usa el de mayor nivel disponible (avx512, avx2 o escalar).
+    Devuelve 0 si el kernel pedido existe y la CPU lo soporta, -1 en caso contrario.
+*/
+int seleccionar_kernel_dct_2d(const char *pedido) {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    int soporta_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    int soporta_avx512 = soporta_avx2 && __builtin_cpu_supports("avx512f") &&
+                         __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+
+    if (strcmp(pedido, "auto") == 0) {
+        pedido = soporta_avx512 ? "avx512" : (soporta_avx2 ? "avx2" : "escalar");
+    }
+    if (strcmp(pedido, "avx512") == 0 && soporta_avx512) {
+        dct_2d_kernel = dct_2d_franja_avx512;
+        dct_2d_kernel_nombre = "avx512";
+        return 0;
+    }
+    if (strcmp(pedido, "avx2") == 0 && soporta_avx2) {
+        dct_2d_kernel = dct_2d_franja_avx2;
+        dct_2d_kernel_nombre = "avx2";
+        return 0;
+    }
+#endif
+    if (strcmp(pedido, "auto") == 0 || strcmp(pedido, "escalar") == 0) {
+        dct_2d_kernel = dct_2d_franja_escalar;
+        dct_2d_kernel_nombre = "escalar";
+        return 0;
+    }
+    return -1;
+}
+
+/*
+    DCT 2D por bloques de una imagen de alto x ancho (múltiplos de bloque) con la matriz de la
+    DCT-II o de la DCT-III (ver dct_2d.h): las franjas de bloque filas se reparten entre
+    dct_2d_hilos hilos.
+*/
+void dct_2d(const float *matriz, const float *entrada, float *salida, int64_t alto, int64_t ancho, int bloque) {
+    int64_t franjas = alto / bloque;
+
+    #pragma omp parallel for schedule(static) num_threads(dct_2d_hilos)
+    for (int64_t b = 0; b < franjas; b++) {
+        int64_t desplazamiento = b * bloque * ancho;
+        dct_2d_kernel(matriz, entrada + desplazamiento, salida + desplazamiento, ancho, bloque);
+    }
+}
+
+// Lado redondeado al siguiente múltiplo del bloque
+static int64_t redondear_bloque(int64_t lado, int bloque) {
+    return (lado + bloque - 1) / bloque * bloque;
+}
+
+/*
+    Completa la imagen de alto x ancho píxeles hasta alto_p x ancho_p (múltiplos del bloque)
+    repitiendo el último píxel de cada fila y la última fila, como los codificadores JPEG.
+*/
+void rellenar_bordes(float *imagen, int64_t alto, int64_t ancho, int64_t alto_p, int64_t ancho_p) {
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = ancho; j < ancho_p; j++) {
+            imagen[i * ancho_p + j] = imagen[i * ancho_p + ancho - 1];
+        }
+    }
+    for (int64_t i = alto; i < alto_p; i++) {
+        memcpy(imagen + i * ancho_p, imagen + (alto - 1) * ancho_p, ancho_p * sizeof(float));
+    }
+}
+
+// Escribe como PGM la zona de alto x ancho píxeles de una imagen con ancho_p columnas
+int guardar_pgm(const char *ruta, const float *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    uint8_t *pixeles = (uint8_t *)malloc((size_t)alto * (size_t)ancho);
+    int resultado;
+
+    if (pixeles == NULL) {
+        return -1;
+    }
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            pixeles[i * ancho + j] = imagen_saturar((float)imagen[i * ancho_p + j] + DESPLAZAMIENTO_NIVEL);
+        }
+    }
+    resultado = imagen_escribir_pgm(ruta, pixeles, alto, ancho);
+    free(pixeles);
+    return resultado;
+}
+
+// Imprime la zona de alto x ancho de una imagen, una fila por línea (formato de matriz de Metricas)
+void imprimir_imagen(const float *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    for (int64_t i = 0; i < alto; i++) {
+        printf("\t");
+        for (int64_t j = 0; j < ancho; j++) {
+            printf("%.10e  ", (float)imagen[i * ancho_p + j]);
+        }
+        printf("\n");
+    }
+}
+
+// Escribe la zona de alto x ancho de una imagen como sección del volcado binario (--dump)
+void volcar_imagen(volcado_t *volcado, const char *nombre, const float *imagen, int64_t alto, int64_t ancho, int64_t ancho_p) {
+    volcado_seccion(volcado, nombre, alto, ancho);
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            volcado_valor(volcado, (float)imagen[i * ancho_p + j]);
+        }
+    }
+}
+
+/*
+    Modo barrido (--sweep): mide la DCT-II y la DCT-III de imágenes de n x n píxeles para cada
+    n de la lista en un único proceso. Las imágenes se reservan una vez con el mayor tamaño y
+    cada medida usa sus primeros n_p x n_p píxeles (n redondeado al bloque) como una imagen
+    compacta. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, const float *directa, const float *inversa, int bloque, int calentamiento, int repeticiones) {
+    int64_t maximo = redondear_bloque(barrido->maximo, bloque);
+    int64_t pixeles = maximo * maximo;
+
+    float *entrada = (float *)memoria_reservar(pixeles * sizeof(float));
+    float *coeficientes = (float *)memoria_reservar(pixeles * sizeof(float));
+    float *reconstruida = (float *)memoria_reservar(pixeles * sizeof(float));
+
+    if (entrada == NULL || coeficientes == NULL || reconstruida == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(entrada);
+        memoria_liberar(coeficientes);
+        memoria_liberar(reconstruida);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    ALEATORIO_RELLENAR(i, pixeles, u, 1,
+        entrada[i] = floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL;
+    );
+
+    cronometro_t cronometro;
+    int64_t n_p = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n_p = redondear_bloque(barrido->tamanhos[k], bloque);
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            cronometro_arrancar(&cronometro);
+            dct_2d(directa, entrada, coeficientes, n_p, n_p, bloque);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "dct", barrido->tamanhos[k]);
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            cronometro_arrancar(&cronometro);
+            dct_2d(inversa, coeficientes, reconstruida, n_p, n_p, bloque);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "idct", barrido->tamanhos[k]);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", coeficientes[n_p * n_p - 1], reconstruida[n_p * n_p - 1]);
+
+    memoria_liberar(entrada);
+    memoria_liberar(coeficientes);
+    memoria_liberar(reconstruida);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+    int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    int bloque = DCT_2D_BLOQUE;
+    const char *kernel_pedido = "auto";
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    const char *ruta_imagen = NULL;
+    const char *prefijo_pgm = NULL;
+    int rand_libc = 0;
+    int opt;
+
+    // Manejar opciones (-v, -p, -k <kernel>, -b <bloque>, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc, --image <ruta>, --pgm <prefijo>)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {"image", required_argument, NULL, OPCION_IMAGEN},
+        {"pgm", required_argument, NULL, OPCION_PGM},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpk:b:t:w:r:H:", opciones_largas, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 'k':
+                kernel_pedido = optarg;
+                break;
+            case 'b':
+                bloque = atoi(optarg);
+                break;
+            case 't':
+                dct_2d_hilos = atoi(optarg);
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
+            case OPCION_IMAGEN:
+                ruta_imagen = optarg;
+                break;
+            case OPCION_PGM:
+                prefijo_pgm = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-k auto|escalar|avx2|avx512] [-b 8|16] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--pgm prefijo] (<lado de la imagen> | --image ruta.pgm | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (barrido.num > 0 && (ruta_volcado != NULL || ruta_imagen != NULL || prefijo_pgm != NULL)) {
+        fprintf(stderr, "--dump, --image y --pgm no se pueden combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (lado y seed; con --sweep el lado es el mayor del barrido y con --image el de la imagen)
+    if (barrido.num == 0 && ruta_imagen == NULL && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-k auto|escalar|avx2|avx512] [-b 8|16] [-t hilos] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] [--pgm prefijo] (<lado de la imagen> | --image ruta.pgm | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t alto, ancho;
+    uint8_t *pixeles = NULL;
+
+    if (ruta_imagen != NULL) {
+        pixeles = imagen_leer_pgm(ruta_imagen, &alto, &ancho);
+        if (pixeles == NULL) {
+            fprintf(stderr, "No se pudo leer la imagen (PGM binario de 8 bits): %s\n", ruta_imagen);
+            return EXIT_FAILURE;
+        }
+    } else {
+        alto = ancho = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
+    }
+
+    if (ancho <= 0) {
+        fprintf(stderr, "El lado de la imagen debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!dct_2d_bloque_valido(bloque)) {
+        fprintf(stderr, "El lado del bloque debe ser 8 o 16.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (dct_2d_hilos < 1) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Kernel de las franjas para esta CPU
+    if (seleccionar_kernel_dct_2d(kernel_pedido) != 0) {
+        fprintf(stderr, "Kernel DCT 2D no disponible en esta CPU: %s\n", kernel_pedido);
+        return EXIT_FAILURE;
+    }
+    printf("Kernel DCT 2D: %s\n", dct_2d_kernel_nombre);
+    printf("Bloque: %dx%d\n", bloque, bloque);
+    printf("Hilos: %d\n", dct_2d_hilos);
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    // Matrices de la DCT-II y la DCT-III del bloque (ver dct_2d.h)
+    float directa[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    float inversa[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    dct_2d_matrices(bloque, directa, inversa);
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con un bloque
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, directa, inversa, bloque, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Se usa una semilla proporcionada como argumento o una por defecto
+    int arg_seed = (ruta_imagen != NULL) ? optind : optind + 1;
+    unsigned int seed = (arg_seed < argc) ? (unsigned int)atoi(argv[arg_seed]) : (unsigned int)time(NULL);
+    aleatorio_iniciar(seed, rand_libc);
+
+    // Demostración con un único bloque
+    float bloque_small[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+    float resultado_small[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+
+    ALEATORIO_RELLENAR(i, bloque * bloque, u, 1,
+        bloque_small[i] = floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL;
+    );
+
+    printf("Bloque input_small:\n");
+    imprimir_imagen(bloque_small, bloque, bloque, bloque);
+
+    dct_2d(directa, bloque_small, resultado_small, bloque, bloque, bloque);
+
+    printf("Resultado DCT_small:\n");
+    imprimir_imagen(resultado_small, bloque, bloque, bloque);
+
+
+    // Imagen completada hasta múltiplos del bloque
+    int64_t alto_p = redondear_bloque(alto, bloque);
+    int64_t ancho_p = redondear_bloque(ancho, bloque);
+    int64_t total = alto_p * ancho_p;
+
+    float *entrada = (float *)memoria_reservar(total * sizeof(float));
+    float *coeficientes = (float *)memoria_reservar(total * sizeof(float));
+    float *reconstruida = (float *)memoria_reservar(total * sizeof(float));
+
+    if (entrada == NULL || coeficientes == NULL || reconstruida == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    // Píxeles de la imagen o enteros aleatorios en [0, 255], con el desplazamiento de nivel
+    if (pixeles != NULL) {
+        for (int64_t i = 0; i < alto; i++) {
+            for (int64_t j = 0; j < ancho; j++) {
+                entrada[i * ancho_p + j] = (float)pixeles[i * ancho + j] - DESPLAZAMIENTO_NIVEL;
+            }
+        }
+        free(pixeles);
+    } else {
+        ALEATORIO_RELLENAR(i, alto * ancho, u, 1,
+            entrada[(i / ancho) * ancho_p + i % ancho] = floorf(u[0] * 256.0f) - DESPLAZAMIENTO_NIVEL;
+        );
+    }
+    rellenar_bordes(entrada, alto, ancho, alto_p, ancho_p);
+
+    double megapixeles = (double)alto * (double)ancho / 1e6;
+    printf("Imagen: %lld x %lld (%.3f megapixeles)\n", (long long)alto, (long long)ancho, megapixeles);
+
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float32", "dct_2d", dct_2d_kernel_nombre, ancho, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(verbose){
+        printf("Datos ejecucion: \n");
+        imprimir_imagen(entrada, alto, ancho, ancho_p);
+    }
+    if (volcado != NULL) {
+        volcar_imagen(volcado, "entrada", entrada, alto, ancho, ancho_p);
+    }
+
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
+
+    cronometro_t cronometro;
+    double mediana;
+
+    // DCT-II de todos los bloques
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        dct_2d(directa, entrada, coeficientes, alto_p, ancho_p, bloque);
+        cronometro_parar(&cronometro);
+    }
+    mediana = cronometro_imprimir(&cronometro);
+    printf("Megapixeles/s DCT-II: %.3f\n", megapixeles / mediana);
+
+    // DCT-III de los coeficientes: reconstruye la imagen
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        dct_2d(inversa, coeficientes, reconstruida, alto_p, ancho_p, bloque);
+        cronometro_parar(&cronometro);
+    }
+    mediana = cronometro_imprimir(&cronometro);
+    printf("Megapixeles/s DCT-III: %.3f\n", megapixeles / mediana);
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+
+    printf("%f %.10e\n", coeficientes[total - 1], reconstruida[total - 1]);
+
+    double error_maximo = 0.0;
+    for (int64_t i = 0; i < alto; i++) {
+        for (int64_t j = 0; j < ancho; j++) {
+            double error = fabs((double)reconstruida[i * ancho_p + j] - (double)entrada[i * ancho_p + j]);
+            error_maximo = error > error_maximo ? error : error_maximo;
+        }
+    }
+    printf("Error maximo de reconstruccion: %.6e\n", error_maximo);
+
+    if(verbose){
+        printf("Resultados ejecucion: \n");
+        imprimir_imagen(coeficientes, alto, ancho, ancho_p);
+        printf("Resultados ejecucion: \n");
+        imprimir_imagen(reconstruida, alto, ancho, ancho_p);
+    }
+    if (volcado != NULL) {
+        volcar_imagen(volcado, "resultado", coeficientes, alto, ancho, ancho_p);
+        volcar_imagen(volcado, "resultado", reconstruida, alto, ancho, ancho_p);
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
+
+    // Original y reconstruida en PGM para SSIM.py y PSNR.py (--image)
+    if (prefijo_pgm != NULL) {
+        char ruta_original[4096], ruta_reconstruida[4096];
+        snprintf(ruta_original, sizeof(ruta_original), "%s_original.pgm", prefijo_pgm);
+        snprintf(ruta_reconstruida, sizeof(ruta_reconstruida), "%s_reconstruida_FP32.pgm", prefijo_pgm);
+        if (guardar_pgm(ruta_original, entrada, alto, ancho, ancho_p) != 0 ||
+            guardar_pgm(ruta_reconstruida, reconstruida, alto, ancho, ancho_p) != 0) {
+            fprintf(stderr, "Error al escribir las imágenes: %s_*.pgm\n", prefijo_pgm);
+            return EXIT_FAILURE;
+        }
+        printf("Imagenes: %s %s\n", ruta_original, ruta_reconstruida);
+    }
+
+    memoria_liberar(entrada);
+    memoria_liberar(coeficientes);
+    memoria_liberar(reconstruida);
+
+    return EXIT_SUCCESS;
+}
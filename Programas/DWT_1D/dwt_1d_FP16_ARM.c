@@ -2,8 +2,16 @@
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <arm_fp16.h>
 
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
 #define LEGALL_53_WAVELET 1
 #define CDF_97_WAVELET 2
 #define N_SMALL 6
@@ -15,16 +23,15 @@ typedef struct {
     int high_pass_size;
 } WaveletKernels;
 
-void convolve1d_generic(__fp16* input_vector, int vector_size, WaveletKernels kernels) {
-    __fp16* low_pass_result = (__fp16*) malloc(vector_size * sizeof(__fp16));
-    __fp16* high_pass_result = (__fp16*) malloc(vector_size * sizeof(__fp16));
-
-    for (int i = 0; i < vector_size; i++) {
+// Los resultados intermedios de los dos filtros (vector_size elementos cada uno) los reserva
+// quien llama, fuera de la región medida
+void convolve1d_generic(__fp16* input_vector, int64_t vector_size, WaveletKernels kernels, __fp16* low_pass_result, __fp16* high_pass_result) {
+    for (int64_t i = 0; i < vector_size; i++) {
         low_pass_result[i] = 0.0f;
         high_pass_result[i] = 0.0f;
     }
 
-    for (int i = 0; i < vector_size; i++) {
+    for (int64_t i = 0; i < vector_size; i++) {
         for (int j = 0; j < kernels.low_pass_size; j++) {
             if (i + j < vector_size) {
                 low_pass_result[i] += input_vector[i + j] * (__fp16)kernels.low_pass_kernel[j];
@@ -32,7 +39,7 @@ void convolve1d_generic(__fp16* input_vector, int vector_size, WaveletKernels ke
         }
     }
 
-    for (int i = 0; i < vector_size; i++) {
+    for (int64_t i = 0; i < vector_size; i++) {
         for (int j = 0; j < kernels.high_pass_size; j++) {
             if (i + j < vector_size) {
                 high_pass_result[i] += input_vector[i + j] * (__fp16)kernels.high_pass_kernel[j];
@@ -40,13 +47,10 @@ void convolve1d_generic(__fp16* input_vector, int vector_size, WaveletKernels ke
         }
     }
 
-    for (int i = 0; i < vector_size / 2; i++) {
+    for (int64_t i = 0; i < vector_size / 2; i++) {
         input_vector[i] = low_pass_result[2 * i];
         input_vector[vector_size / 2 + i] = high_pass_result[2 * i];
     }
-
-    free(low_pass_result);
-    free(high_pass_result);
 }
 
 void initialize_kernels(WaveletKernels* kernels, int kernel_type) {
@@ -99,48 +103,185 @@ void initialize_kernels(WaveletKernels* kernels, int kernel_type) {
     }
 }
 
+/*
+    Modo barrido (--sweep): mide la convolución con las dos wavelets para cada tamaño de la lista
+    en un único proceso. Los vectores se reservan e inicializan una vez con el mayor tamaño y cada
+    medida parte de los n primeros elementos de la copia inicial. Devuelve -1 si falla la reserva
+    de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    static const int wavelets[] = {LEGALL_53_WAVELET, CDF_97_WAVELET};
+    static const char *nombres_wavelets[] = {"legall53", "cdf97"};
+    int64_t maximo = barrido->maximo;
+
+    __fp16* input_vector = (__fp16*)memoria_reservar(maximo * sizeof(__fp16));
+    __fp16* aux_vector = (__fp16*)memoria_reservar(maximo * sizeof(__fp16));
+    __fp16* low_pass_result = (__fp16*)malloc(maximo * sizeof(__fp16));
+    __fp16* high_pass_result = (__fp16*)malloc(maximo * sizeof(__fp16));
+
+    if (input_vector == NULL || aux_vector == NULL || low_pass_result == NULL || high_pass_result == NULL) {
+        printf("Error al asignar memoria\n");
+        memoria_liberar(input_vector);
+        memoria_liberar(aux_vector);
+        free(low_pass_result);
+        free(high_pass_result);
+        return -1;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+
+    ALEATORIO_RELLENAR(i, maximo, u, 1,
+        float temp_value = u[0] * 10.0;
+        aux_vector[i] = (__fp16)temp_value;
+    );
+
+    WaveletKernels kernels;
+    int64_t n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        n = barrido->tamanhos[k];
+
+        for (int w = 0; w < 2; w++) {
+            cronometro_t cronometro;
+
+            initialize_kernels(&kernels, wavelets[w]);
+
+            cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+            while (cronometro_continuar(&cronometro)) {
+                for (int64_t i = 0; i < n; i++) {
+                    input_vector[i] = aux_vector[i];
+                }
+
+                cronometro_arrancar(&cronometro);
+                convolve1d_generic(input_vector, n, kernels, low_pass_result, high_pass_result);
+                cronometro_parar(&cronometro);
+            }
+            barrido_imprimir(&cronometro, nombres_wavelets[w], n);
+
+            free(kernels.low_pass_kernel);
+            free(kernels.high_pass_kernel);
+        }
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)input_vector[n-1], (float)input_vector[n-1]);
+
+    memoria_liberar(input_vector);
+    memoria_liberar(aux_vector);
+    free(low_pass_result);
+    free(high_pass_result);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
 int main(int argc, char *argv[]) {
     
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -w <calentamiento>, -r <repeticiones>, -H <memoria>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpw:r:H:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
         return EXIT_FAILURE;
-    }   
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
 
-    int n = -1;
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-w calentamiento] [-r repeticiones] [-H malloc|thp|hugetlb] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }   
 
-    n = atoi(argv[optind]);
+    int64_t n = barrido.num > 0 ? barrido.maximo : leer_tamanho(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
 
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     __fp16* input_vector_small = (__fp16*) malloc(N_SMALL * sizeof(__fp16));
     __fp16* aux_vector_small = (__fp16*) malloc(N_SMALL * sizeof(__fp16));
+    __fp16 low_pass_small[N_SMALL], high_pass_small[N_SMALL];
 
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
-    for (int i = 0; i < N_SMALL; i++) {
-        float temp_value = ((float)rand() / (float)(RAND_MAX)) * 10.0;
+    ALEATORIO_RELLENAR(i, N_SMALL, u, 1,
+        float temp_value = u[0] * 10.0;
         aux_vector_small[i] = (__fp16)temp_value;
-    }
+    );
 
     for (int i = 0; i < N_SMALL; i++) {
         input_vector_small[i] = aux_vector_small[i];
@@ -157,7 +298,7 @@ int main(int argc, char *argv[]) {
     initialize_kernels(&kernels, LEGALL_53_WAVELET);
 
     printf("Convolving with LeGall 5/3 Wavelet\n");
-    convolve1d_generic(input_vector_small, N_SMALL, kernels);
+    convolve1d_generic(input_vector_small, N_SMALL, kernels, low_pass_small, high_pass_small);
 
     printf("Result: ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -175,7 +316,7 @@ int main(int argc, char *argv[]) {
     initialize_kernels(&kernels, CDF_97_WAVELET);
 
     printf("Convolving with CDF 9/7 Wavelet (lossy)\n");
-    convolve1d_generic(input_vector_small, N_SMALL, kernels);
+    convolve1d_generic(input_vector_small, N_SMALL, kernels, low_pass_small, high_pass_small);
 
     printf("Result: ");
     for (int i = 0; i < N_SMALL; i++) {
@@ -190,15 +331,24 @@ int main(int argc, char *argv[]) {
 
     // Fin del programa para un vector pequeño
 
-    __fp16* input_vector = (__fp16*) malloc(n * sizeof(__fp16));
-    __fp16* aux_vector = (__fp16*) malloc(n * sizeof(__fp16));
+    __fp16* input_vector = (__fp16*)memoria_reservar(n * sizeof(__fp16));
+    __fp16* aux_vector = (__fp16*)memoria_reservar(n * sizeof(__fp16));
+    // Resultados intermedios de la convolución, fuera del modo de memoria (-H) y de la medida
+    __fp16* low_pass_result = (__fp16*)malloc(n * sizeof(__fp16));
+    __fp16* high_pass_result = (__fp16*)malloc(n * sizeof(__fp16));
 
-    for (int i = 0; i < n; i++) {
-        float temp_value = ((float)rand() / (float)(RAND_MAX)) * 10.0;
-        aux_vector[i] = (__fp16)temp_value;
+    if (input_vector == NULL || aux_vector == NULL || low_pass_result == NULL || high_pass_result == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
     }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
 
-    for (int i = 0; i < n; i++) {
+    ALEATORIO_RELLENAR(i, n, u, 1,
+        float temp_value = u[0] * 10.0;
+        aux_vector[i] = (__fp16)temp_value;
+    );
+
+    for (int64_t i = 0; i < n; i++) {
         input_vector[i] = aux_vector[i];
     }
 
@@ -206,31 +356,49 @@ int main(int argc, char *argv[]) {
 
     printf("Convolving large vector with LeGall 5/3 Wavelet\n");
 
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "dwt_1d", NULL, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
+        }
+    }
+
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)input_vector[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)input_vector[i]);
+        }
+    }
 
-    //Para medir el tiempo de ejecución
-
-    clock_t start, end;
-    double cpu_time_used;
-
-    start = clock();
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
 
-    /* 
-        Código del programa cuyo tiempo quiero medir
-    */
+    cronometro_t cronometro;
 
-    convolve1d_generic(input_vector, n, kernels);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo vector de entrada, que la convolución sobrescribe
+        if (cronometro.vuelta > 0) {
+            for (int64_t i = 0; i < n; i++) {
+                input_vector[i] = aux_vector[i];
+            }
+        }
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+        cronometro_arrancar(&cronometro);
+        convolve1d_generic(input_vector, n, kernels, low_pass_result, high_pass_result);
+        cronometro_parar(&cronometro);
+    }
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    cronometro_imprimir(&cronometro);
 
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
@@ -239,16 +407,22 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)input_vector[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)input_vector[i]);
+        }
+    }
 
     free(kernels.low_pass_kernel);
     free(kernels.high_pass_kernel);
 
-    for (int i = 0; i < n; i++) {
+    for (int64_t i = 0; i < n; i++) {
         input_vector[i] = aux_vector[i];
     }
 
@@ -258,26 +432,35 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Datos ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)input_vector[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "entrada", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)input_vector[i]);
+        }
+    }
 
-    //Para medir el tiempo de ejecución
-
-    start = clock();
-
-    /* 
-        Código del programa cuyo tiempo quiero medir
-    */
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
 
-    convolve1d_generic(input_vector, n, kernels);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte del mismo vector de entrada, que la convolución sobrescribe
+        if (cronometro.vuelta > 0) {
+            for (int64_t i = 0; i < n; i++) {
+                input_vector[i] = aux_vector[i];
+            }
+        }
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+        cronometro_arrancar(&cronometro);
+        convolve1d_generic(input_vector, n, kernels, low_pass_result, high_pass_result);
+        cronometro_parar(&cronometro);
+    }
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    cronometro_imprimir(&cronometro);
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
@@ -285,16 +468,149 @@ int main(int argc, char *argv[]) {
 
     if(verbose){
         printf("Resultados ejecucion: ");
-        for(int i = 0; i < n; i++){
+        for(int64_t i = 0; i < n; i++){
             printf("%.10e ", (float)input_vector[i]);
         }
         printf("\n");
     }
+    if (volcado != NULL) {
+        volcado_seccion(volcado, "resultado", 1, n);
+        for (int64_t i = 0; i < n; i++) {
+            volcado_valor(volcado, (float)input_vector[i]);
+        }
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
 
-    free(input_vector);
-    free(aux_vector);
+    memoria_liberar(input_vector);
+    memoria_liberar(aux_vector);
+    free(low_pass_result);
+    free(high_pass_result);
     free(kernels.low_pass_kernel);
     free(kernels.high_pass_kernel);
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de las dos convoluciones en el programa unificado (Programas/BENCH, ver registro.h),
+    con la señal en __fp16. convolve1d_generic sobrescribe la señal, así que se restaura antes de
+    cada vuelta.
+*/
+REGISTRO_TIPO(dwt_tipo, __fp16, (__fp16), (float))
+
+static const registro_forma_t dwt_forma = {.entradas = 1, .vectores = 1, .salida = 0, .restaurar = 1u << 0};
+
+// datos: filtros de la wavelet y resultados intermedios de la convolución, reservados con malloc
+// aquí y no en cada vuelta medida
+typedef struct {
+    WaveletKernels kernels;
+    __fp16* low_pass_result;
+    __fp16* high_pass_result;
+} dwt_datos_t;
+
+static void *dwt_preparar(int64_t n, const float *entrada, const char *memoria, int kernel_type) {
+    registro_vectores_t *estado = registro_vectores_crear(n, entrada, memoria, &dwt_tipo, &dwt_forma);
+    if (estado == NULL) {
+        return NULL;
+    }
+    dwt_datos_t *datos = (dwt_datos_t *)malloc(sizeof(dwt_datos_t));
+    if (datos == NULL) {
+        registro_vectores_liberar(estado);
+        return NULL;
+    }
+    datos->low_pass_result = (__fp16*)malloc(n * sizeof(__fp16));
+    datos->high_pass_result = (__fp16*)malloc(n * sizeof(__fp16));
+    if (datos->low_pass_result == NULL || datos->high_pass_result == NULL) {
+        free(datos->low_pass_result);
+        free(datos->high_pass_result);
+        free(datos);
+        registro_vectores_liberar(estado);
+        return NULL;
+    }
+    initialize_kernels(&datos->kernels, kernel_type);
+    estado->datos = datos;
+    return estado;
+}
+
+static void *dwt_preparar_legall53(int64_t n, const float *entrada, const char *memoria) {
+    return dwt_preparar(n, entrada, memoria, LEGALL_53_WAVELET);
+}
+
+static void *dwt_preparar_cdf97(int64_t n, const float *entrada, const char *memoria) {
+    return dwt_preparar(n, entrada, memoria, CDF_97_WAVELET);
+}
+
+static void dwt_ejecutar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    dwt_datos_t *datos = (dwt_datos_t *)estado->datos;
+    convolve1d_generic(estado->v[0], estado->n, datos->kernels, datos->low_pass_result, datos->high_pass_result);
+}
+
+static void dwt_liberar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    dwt_datos_t *datos = (dwt_datos_t *)estado->datos;
+    free(datos->kernels.low_pass_kernel);
+    free(datos->kernels.high_pass_kernel);
+    free(datos->low_pass_result);
+    free(datos->high_pass_result);
+    free(datos);
+    registro_vectores_liberar(estado);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: 1 FMA por coeficiente de cada filtro; lee la señal y la sobrescribe
+static double dwt_flops_legall53(int64_t n) {
+    return 2.0 * (5 + 3) * (double)n;
+}
+
+static double dwt_flops_cdf97(int64_t n) {
+    return 2.0 * (9 + 7) * (double)n;
+}
+
+static double dwt_trafico(int64_t n) {
+    return 2.0 * (double)n;
+}
+
+static const registro_kernel_t registro_legall53 = {
+    .kernel = "dwt_1d",
+    .medida = "legall53",
+    .tipo = "FP16_ARM",
+    .bytes_elemento = sizeof(__fp16),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_uno,
+    .preparar = dwt_preparar_legall53,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = dwt_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = dwt_liberar,
+    .flops = dwt_flops_legall53,
+    .elementos = dwt_trafico,
+};
+REGISTRO_KERNEL(registro_legall53)
+
+static const registro_kernel_t registro_cdf97 = {
+    .kernel = "dwt_1d",
+    .medida = "cdf97",
+    .tipo = "FP16_ARM",
+    .bytes_elemento = sizeof(__fp16),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_n,
+    .elementos_salida = registro_elementos_n,
+    .generar = registro_generar_uno,
+    .preparar = dwt_preparar_cdf97,
+    .restaurar = registro_vectores_restaurar,
+    .ejecutar = dwt_ejecutar,
+    .resultado = registro_vectores_resultado,
+    .liberar = dwt_liberar,
+    .flops = dwt_flops_cdf97,
+    .elementos = dwt_trafico,
+};
+REGISTRO_KERNEL(registro_cdf97)
+
+#endif /* BENCH_REGISTRO */
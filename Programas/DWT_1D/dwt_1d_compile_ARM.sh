@@ -42,10 +42,12 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
-COMMON_FLAGS="-Wall"
+COMMON_FLAGS="-Wall -fopenmp"
 
 OPT_FLAGS="-O3 -march=armv8.2-a+fp16+fp16fml+simd -ftree-vectorize -fomit-frame-pointer $additional_flags"
 
+LINK_FLAGS="-lm"
+
 # Obtener el directorio donde está ubicado el script
 script_dir="$(dirname "$0")"
 
@@ -56,22 +58,22 @@ cd "$script_dir"
 ### COMPILACION DEL PROGRAMA BASE
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS dwt_1d_FP32.c -o dwt_1d_FP32.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS dwt_1d_FP32.c -o dwt_1d_FP32.out $OPT_FLAGS $LINK_FLAGS
 
 
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS -fexcess-precision=16 dwt_1d_FP16.c -o dwt_1d_FP16.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS -fexcess-precision=16 dwt_1d_FP16.c -o dwt_1d_FP16.out $OPT_FLAGS $LINK_FLAGS
 
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __fp16)
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS dwt_1d_FP16_ARM.c -o dwt_1d_FP16_ARM.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS dwt_1d_FP16_ARM.c -o dwt_1d_FP16_ARM.out $OPT_FLAGS $LINK_FLAGS
 
 ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __bf16)
 
 # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16.out $OPT_FLAGS
+gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16.out $OPT_FLAGS $LINK_FLAGS
 
 exit 0
\ No newline at end of file
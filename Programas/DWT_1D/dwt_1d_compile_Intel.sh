@@ -42,9 +42,11 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
-COMMON_FLAGS="-Wall -g"
+COMMON_FLAGS="-Wall -g -fopenmp"
 
-OPT_FLAGS="-march=tigerlake -mtune=tigerlake -O3 -fomit-frame-pointer $additional_flags"
+OPT_FLAGS="-mtune=tigerlake -O3 -fomit-frame-pointer $additional_flags"
+
+LINK_FLAGS="-lm"
 
 # Obtener el directorio donde está ubicado el script
 script_dir="$(dirname "$0")"
@@ -55,7 +57,7 @@ cd "$script_dir"
 
 ### COMPILACION DEL PROGRAMA BASE
 
-gcc-14 $COMMON_FLAGS dwt_1d_FP32.c -o dwt_1d_FP32 $OPT_FLAGS
+gcc-14 $COMMON_FLAGS dwt_1d_FP32.c -o dwt_1d_FP32 $OPT_FLAGS $LINK_FLAGS
 
 
 if grep -q "sse2" /proc/cpuinfo; then
@@ -63,50 +65,15 @@ if grep -q "sse2" /proc/cpuinfo; then
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
-    gcc-14 $COMMON_FLAGS dwt_1d_FP16.c -o dwt_1d_FP16 -fexcess-precision=16 $OPT_FLAGS
-
-    if grep -q "avx512fp16" /proc/cpuinfo; then
-        
-        echo "AVX512FP16 support detected. Compiling with -mavx512fp16."
-        COMMON_FLAGS+=" -mavx512fp16"
-
-        # Compilar el programa optimizado con AVX512 (nativo)
-        gcc-14 $COMMON_FLAGS dwt_1d_FP16.c -o dwt_1d_FP16_native-base $OPT_FLAGS
-        # Compilar el programa optimizado con AVX512 y precisión de 16 bits
-        gcc-14 $COMMON_FLAGS dwt_1d_FP16.c -o dwt_1d_FP16_avx512_precision -fexcess-precision=16 $OPT_FLAGS
-        # Compilar el programa con máxima optimización
-        gcc-14 $COMMON_FLAGS dwt_1d_FP16.c -o dwt_1d_FP16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS
-
-        # Eliminar los flags específicos de esta sección
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512fp16/}"
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
-
-    else
-        echo "AVX512FP16 not supported on this system. Skipping compilation with -mavx512fp16."
-    fi
+    # Un único ejecutable: las variantes x86-64-v3, x86-64-v4 y AVX512-FP16 del kernel se compilan
+    # con atributos target y se escogen en tiempo de ejecución (ver common/include/despacho.h)
+    gcc-14 $COMMON_FLAGS dwt_1d_FP16.c -o dwt_1d_FP16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
     ### COMPILACION DEL PROGRAMA CON BFLOAT16 (EMPLEA EL TIPO DE DATO __bf16)
 
-    gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16 -fexcess-precision=16 $OPT_FLAGS
-
-    if grep -q "avx512bf16" /proc/cpuinfo; then
-        echo "AVX512BF16 support detected. Compiling with -mavx512bf16."
-        COMMON_FLAGS+=" -mavx512bf16"
-
-        # Compilar el programa optimizado con AVX512 (nativo)
-        gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16_native-base $OPT_FLAGS
-        # Compilar el programa optimizado con AVX512 y precisión de 16 bits
-        gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16_avx512_precision -fexcess-precision=16 $OPT_FLAGS
-        # Compilar el programa con máxima optimización
-        gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS
-
-        # Eliminar los flags específicos de esta sección
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512bf16/}" 
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
-
-    else
-        echo "AVX512BF16 not supported on this system. Skipping compilation with -mavx512bf16."
-    fi
+    # Un único ejecutable: las variantes x86-64-v3, x86-64-v4 y AVX512-BF16 del kernel se compilan
+    # con atributos target y se escogen en tiempo de ejecución (ver common/include/despacho.h)
+    gcc-14 $COMMON_FLAGS dwt_1d_BF16.c -o dwt_1d_BF16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
 else
     echo "SSE2 not supported on this system. Skipping compilation for programs with reduced precision (float) data type."
@@ -121,25 +88,25 @@ if $force_run; then
     ### COMPILACION DEL PROGRAMA BASE
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall dwt_1d_FP32.c -o dwt_1d_FP32.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp dwt_1d_FP32.c -o dwt_1d_FP32.out -lm
 
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall -fexcess-precision=16 dwt_1d_FP16.c -o dwt_1d_FP16.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp -fexcess-precision=16 dwt_1d_FP16.c -o dwt_1d_FP16.out -lm
 
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __fp16)
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall dwt_1d_FP16_ARM.c -o dwt_1d_FP16_ARM.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp dwt_1d_FP16_ARM.c -o dwt_1d_FP16_ARM.out -lm
 
 
     ### COMPILACION DEL PROGRAMA CON BFLOAT PARA ARQUITECTURA ARM (EMPLEA EL TIPO DE DATO __bf16)
 
     # Compila para ARM de 64 bits, como distintivo el archivo tiene la extension .out
-    aarch64-linux-gnu-gcc-14 -Wall dwt_1d_BF16.c -o dwt_1d_BF16.out
+    aarch64-linux-gnu-gcc-14 -Wall -fopenmp dwt_1d_BF16.c -o dwt_1d_BF16.out -lm
 
 fi
 
@@ -3,10 +3,17 @@
 #include <math.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <lapacke.h>
 #include <arm_fp16.h>
 #include <armpl.h> // Esta es para usar cblas_hgemm
 
+#include "../common/include/cronometro.h"
+#include "../common/include/barrido.h"
+#include "../common/include/volcado.h"
+#include "../common/include/registro.h"
+#include "../common/include/aleatorio.h"
+
 #define N_SMALL 4
 
 // Estructura para representar una matriz
@@ -60,6 +67,16 @@ void _print_matrix_exp(Matrix* matrix) {
     }
 }
 
+// Función para escribir una matriz como sección del volcado binario (--dump)
+void _volcar_matrix(volcado_t *volcado, const char *nombre, Matrix* matrix) {
+    volcado_seccion(volcado, nombre, matrix->rows, matrix->cols);
+    for(int i = 0; i < matrix->rows; i++) {
+        for(int j = 0; j < matrix->cols; j++) {
+            volcado_valor(volcado, (float)matrix->data[i][j]);
+        }
+    }
+}
+
 // Función para calcular las medias y desviaciones estándar de cada columna de la matriz
 void _calc_means_and_deviations(Matrix* matrix, __fp16 *medias, __fp16 *desviaciones) {
     for(int j = 0; j < matrix->cols; j++) {
@@ -297,40 +314,160 @@ void do_pca(Matrix* matrix) {
     _free_matrix(covariance);
 }
 
+/*
+    Modo barrido (--sweep): aplica PCA a una matriz n x n para cada tamaño de la lista en un único
+    proceso. La matriz se reserva e inicializa una vez con el mayor tamaño y cada medida trabaja
+    sobre su submatriz superior izquierda de n x n, restaurada desde la copia inicial antes de cada
+    vuelta. Devuelve -1 si falla la reserva de memoria.
+*/
+int modo_barrido(const barrido_t *barrido, int calentamiento, int repeticiones) {
+    int maximo = (int)barrido->maximo;
+
+    Matrix* matriz = _create_Matrix(maximo, maximo);
+    Matrix* matriz_inicial = _create_Matrix(maximo, maximo);
+
+    if (matriz == NULL || matriz_inicial == NULL) {
+        printf("Error: No se pudo reservar memoria para la matriz.\n");
+        return -1;
+    }
+
+    ALEATORIO_RELLENAR(k, (int64_t)matriz->rows * matriz->cols, u, 1,
+        int i = k / matriz->cols;
+        int j = k % matriz->cols;
+        float temp = u[0] * 10.0f; // Genera números aleatorios entre 0 y 10
+        matriz->data[i][j] = (__fp16)temp;
+    );
+
+    _copy_matrix(matriz, matriz_inicial);
+
+    int n = maximo;
+
+    barrido_cabecera();
+    for (int k = 0; k < barrido->num; k++) {
+        cronometro_t cronometro;
+
+        // Las filas de la reserva máxima se usan como submatriz de n x n
+        n = (int)barrido->tamanhos[k];
+        matriz->rows = matriz->cols = n;
+        matriz_inicial->rows = matriz_inicial->cols = n;
+
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            _copy_matrix(matriz_inicial, matriz);
+
+            cronometro_arrancar(&cronometro);
+            do_pca(matriz);
+            cronometro_parar(&cronometro);
+        }
+        barrido_imprimir(&cronometro, "pca", n);
+    }
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)matriz->data[n-1][n-1], (float)matriz->data[n-1][n-1]);
+
+    matriz->rows = matriz->cols = maximo;
+    matriz_inicial->rows = matriz_inicial->cols = maximo;
+    _free_matrix(matriz);
+    _free_matrix(matriz_inicial);
+    return 0;
+}
+
+#ifndef BENCH_REGISTRO
+
 int main(int argc, char *argv[]) {
 
     int verbose = 0;
+    int calentamiento = 0;
+    int repeticiones = 1;
+    int medir_contadores = 0;
+    barrido_t barrido = {0};
+    const char *ruta_volcado = NULL;
+    int rand_libc = 0;
     int opt;
 
-    // Manejar opciones (-v)
-    while ((opt = getopt(argc, argv, "v")) != -1) {
+    // Manejar opciones (-v, -p, -w <calentamiento>, -r <repeticiones>, --sweep <n1,n2,...>, --dump <ruta>, --rand-libc)
+    static const struct option opciones_largas[] = {
+        {"sweep", required_argument, NULL, OPCION_BARRIDO},
+        {"dump", required_argument, NULL, OPCION_VOLCADO},
+        {"rand-libc", no_argument, NULL, OPCION_RAND_LIBC},
+        {NULL, 0, NULL, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "vpw:r:", opciones_largas, NULL)) != -1) {
         switch (opt) {
             case 'v':
                 verbose = 1;
                 break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case OPCION_BARRIDO:
+                if (barrido_leer(optarg, &barrido) != 0) {
+                    fprintf(stderr, "Lista de tamaños no válida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case OPCION_VOLCADO:
+                ruta_volcado = optarg;
+                break;
+            case OPCION_RAND_LIBC:
+                // Datos con rand() de la libc, como los de referencia (ver aleatorio.h)
+                rand_libc = 1;
+                break;
             default:
-                fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+                fprintf(stderr, "Uso: %s [-v] [-p] [-w calentamiento] [-r repeticiones] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
                 return EXIT_FAILURE;
         }
     }
 
-    // Verificar argumentos restantes (tamaño y seed)
-    if (optind >= argc) {
-        fprintf(stderr, "Uso: %s [-v] <tamaño del vector> [<seed>]\n", argv[0]);
+    if (barrido.num > 0 && ruta_volcado != NULL) {
+        fprintf(stderr, "--dump no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    if (barrido.num > 0 && medir_contadores) {
+        fprintf(stderr, "-p no se puede combinar con --sweep\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verificar argumentos restantes (tamaño y seed; con --sweep el tamaño es el mayor del barrido)
+    if (barrido.num == 0 && optind >= argc) {
+        fprintf(stderr, "Uso: %s [-v] [-p] [-w calentamiento] [-r repeticiones] [--dump ruta] [--rand-libc] (<tamaño del vector> | --sweep n1,n2,...) [<seed>]\n", argv[0]);
         return EXIT_FAILURE;
     }   
 
     int n = -1;
 
-    n = atoi(argv[optind]);
+    n = barrido.num > 0 ? (int)barrido.maximo : atoi(argv[optind]);
 
     if (n <= 0) {
         fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
         return EXIT_FAILURE;
     }
 
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    // Modo barrido: una sola ejecución para todos los tamaños, sin la demostración con N_SMALL
+    if (barrido.num > 0) {
+        unsigned int seed = (optind < argc) ? (unsigned int)atoi(argv[optind]) : (unsigned int)time(NULL);
+        aleatorio_iniciar(seed, rand_libc);
+        return modo_barrido(&barrido, calentamiento, repeticiones) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     unsigned int seed = (optind + 1 < argc) ? (unsigned int)atoi(argv[optind + 1]) : (unsigned int)time(NULL);
-    srand(seed);
+    aleatorio_iniciar(seed, rand_libc);
 
     Matrix* matriz_small = _create_Matrix(N_SMALL, N_SMALL);
 
@@ -339,12 +476,12 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    for (int i = 0; i < matriz_small->rows; i++) {
-        for (int j = 0; j < matriz_small->cols; j++) {
-            float temp = (float)rand() / RAND_MAX * 10.0f; // Genera números aleatorios entre 0 y 10
-            matriz_small->data[i][j] = (__fp16)temp;
-        }
-    }
+    ALEATORIO_RELLENAR(k, (int64_t)matriz_small->rows * matriz_small->cols, u, 1,
+        int i = k / matriz_small->cols;
+        int j = k % matriz_small->cols;
+        float temp = u[0] * 10.0f; // Genera números aleatorios entre 0 y 10
+        matriz_small->data[i][j] = (__fp16)temp;
+    );
     
     printf("Datos matriz_small inicial: \n");
     _print_matrix(matriz_small);
@@ -364,34 +501,59 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    for (int i = 0; i < matriz->rows; i++) {
-        for (int j = 0; j < matriz->cols; j++) {
-            float temp = (float)rand() / RAND_MAX * 10.0f; // Genera números aleatorios entre 0 y 10
-            matriz->data[i][j] = (__fp16)temp;
+    ALEATORIO_RELLENAR(k, (int64_t)matriz->rows * matriz->cols, u, 1,
+        int i = k / matriz->cols;
+        int j = k % matriz->cols;
+        float temp = u[0] * 10.0f; // Genera números aleatorios entre 0 y 10
+        matriz->data[i][j] = (__fp16)temp;
+    );
+        
+    // Volcado binario de los datos y resultados que -v imprime en texto (ver volcado.h)
+    volcado_t *volcado = NULL;
+    if (ruta_volcado != NULL) {
+        volcado = volcado_abrir(ruta_volcado, "float16", "pca", NULL, n, seed);
+        if (volcado == NULL) {
+            fprintf(stderr, "No se pudo crear el volcado: %s\n", ruta_volcado);
+            return EXIT_FAILURE;
         }
     }
-        
+
     if(verbose){
         printf("Datos ejecucion: \n");
         _print_matrix_exp(matriz);
     }
+    if (volcado != NULL) {
+        _volcar_matrix(volcado, "entrada", matriz);
+    }
 
-    //Para medir el tiempo de ejecución
-    
-    clock_t start, end;
-    double cpu_time_used;
+    // Copia de la matriz de entrada para que cada repetición parta de los mismos datos
+    Matrix* matriz_inicial = NULL;
+    if (calentamiento + repeticiones > 1) {
+        matriz_inicial = _create_Matrix(n, n);
+        if (matriz_inicial == NULL) {
+            printf("Error: No se pudo reservar memoria para la matriz_inicial.\n");
+            return EXIT_FAILURE;
+        }
+        _copy_matrix(matriz, matriz_inicial);
+    }
 
-    start = clock();
-    
-    /* 
-        Código del programa cuyo tiempo quiero medir
-    */
-    do_pca(matriz);
+    //Para medir el tiempo de ejecución (calentamiento + repeticiones, ver cronometro.h)
 
-    end = clock();
-    cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    cronometro_t cronometro;
 
-    printf("Tiempo de ejecucion: %f\n", cpu_time_used);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        // Cada vuelta parte de la misma matriz, que do_pca sobrescribe
+        if (matriz_inicial != NULL && cronometro.vuelta > 0) {
+            _copy_matrix(matriz_inicial, matriz);
+        }
+
+        cronometro_arrancar(&cronometro);
+        do_pca(matriz);
+        cronometro_parar(&cronometro);
+    }
+
+    cronometro_imprimir(&cronometro);
 
     // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
 
@@ -401,8 +563,69 @@ int main(int argc, char *argv[]) {
         printf("Resultados ejecucion: \n");
         _print_matrix_exp(matriz);
     }
+    if (volcado != NULL) {
+        _volcar_matrix(volcado, "resultado", matriz);
+    }
+    if (volcado_cerrar(volcado) != 0) {
+        fprintf(stderr, "Error al escribir el volcado: %s\n", ruta_volcado);
+        return EXIT_FAILURE;
+    }
 
     _free_matrix(matriz);
+    if (matriz_inicial != NULL) {
+        _free_matrix(matriz_inicial);
+    }
 
     return EXIT_SUCCESS;
 }
+
+#else /* BENCH_REGISTRO */
+
+/*
+    Registro de PCA en el programa unificado (Programas/BENCH, ver registro.h): la matriz n x n
+    (por filas, en __fp16) se restaura antes de cada vuelta porque do_pca la sobrescribe (ver
+    REGISTRO_MATRIZ).
+*/
+REGISTRO_TIPO(pca_tipo, __fp16, (__fp16), (float))
+REGISTRO_MATRIZ(pca_tipo)
+
+static void *pca_preparar(int64_t n, const float *entrada, const char *memoria) {
+    (void)memoria;
+    return registro_matriz_crear(n, entrada);
+}
+
+static void pca_ejecutar(void *p) {
+    registro_matriz_t *estado = (registro_matriz_t *)p;
+    do_pca(estado->matriz);
+}
+
+// Mismas cuentas que Metricas/Programas/roofline.py: estandarización, covarianza, ssyev y proyección
+static double pca_flops(int64_t n) {
+    double nd = (double)n;
+    return 13.0 * nd * nd * nd + 5.0 * nd * nd;
+}
+
+static double pca_trafico(int64_t n) {
+    return 2.0 * (double)n * (double)n;
+}
+
+static const registro_kernel_t registro_pca = {
+    .kernel = "pca",
+    .medida = "pca",
+    .tipo = "FP16_ARM",
+    .bytes_elemento = sizeof(__fp16),
+    .implementacion = NULL,
+    .elementos_entrada = registro_elementos_matriz,
+    .elementos_salida = registro_elementos_matriz,
+    .generar = registro_generar_matriz,
+    .preparar = pca_preparar,
+    .restaurar = registro_matriz_restaurar,
+    .ejecutar = pca_ejecutar,
+    .resultado = registro_matriz_resultado,
+    .liberar = registro_matriz_liberar,
+    .flops = pca_flops,
+    .elementos = pca_trafico,
+};
+REGISTRO_KERNEL(registro_pca)
+
+#endif /* BENCH_REGISTRO */
@@ -42,9 +42,9 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
-COMMON_FLAGS="-Wall -g"
+COMMON_FLAGS="-Wall -g -fopenmp"
 
-OPT_FLAGS="-march=tigerlake -mtune=tigerlake -O3 -fomit-frame-pointer $additional_flags"
+OPT_FLAGS="-mtune=tigerlake -O3 -fomit-frame-pointer $additional_flags"
 
 LINK_FLAGS="-lm -llapacke -llapack -lblas"
 
@@ -65,51 +65,16 @@ if grep -q "sse2" /proc/cpuinfo; then
 
     ### COMPILACION DEL PROGRAMA DE CON FLOAT DE 16 BITS QUE EMPLEA EL TIPO DE DATO _Float16
 
+    # Un único ejecutable: las variantes x86-64-v3, x86-64-v4 y AVX512-FP16 del kernel se compilan
+    # con atributos target y se escogen en tiempo de ejecución (ver common/include/despacho.h)
     gcc-14 $COMMON_FLAGS pca_FP16.c -o pca_FP16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
-    if grep -q "avx512fp16" /proc/cpuinfo; then
-        
-        echo "AVX512FP16 support detected. Compiling with -mavx512fp16."
-        COMMON_FLAGS+=" -mavx512fp16"
-
-        # Compilar el programa optimizado con AVX512 (nativo)
-        gcc-14 $COMMON_FLAGS pca_FP16.c -o pca_FP16_native-base $OPT_FLAGS $LINK_FLAGS
-        # Compilar el programa optimizado con AVX512 y precisión de 16 bits
-        gcc-14 $COMMON_FLAGS pca_FP16.c -o pca_FP16_avx512_precision -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
-        # Compilar el programa con máxima optimización
-        gcc-14 $COMMON_FLAGS pca_FP16.c -o pca_FP16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS $LINK_FLAGS
-
-        # Eliminar los flags específicos de esta sección
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512fp16/}" 
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
-
-    else
-        echo "AVX512FP16 not supported on this system. Skipping compilation with -mavx512fp16."
-    fi
-
     ### COMPILACION DEL PROGRAMA CON BFLOAT16 (EMPLEA EL TIPO DE DATO __bf16)
 
+    # Un único ejecutable: las variantes x86-64-v3, x86-64-v4 y AVX512-BF16 del kernel se compilan
+    # con atributos target y se escogen en tiempo de ejecución (ver common/include/despacho.h)
     gcc-14 $COMMON_FLAGS pca_BF16.c -o pca_BF16 -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
 
-    if grep -q "avx512bf16" /proc/cpuinfo; then
-        echo "AVX512BF16 support detected. Compiling with -mavx512bf16."
-        COMMON_FLAGS+=" -mavx512bf16"
-
-        # Compilar el programa optimizado con AVX512 (nativo)
-        gcc-14 $COMMON_FLAGS pca_BF16.c -o pca_BF16_native-base $OPT_FLAGS $LINK_FLAGS
-        # Compilar el programa optimizado con AVX512 y precisión de 16 bits
-        gcc-14 $COMMON_FLAGS pca_BF16.c -o pca_BF16_avx512_precision -fexcess-precision=16 $OPT_FLAGS $LINK_FLAGS
-        # Compilar el programa con máxima optimización
-        gcc-14 $COMMON_FLAGS pca_BF16.c -o pca_BF16_max_performance -fexcess-precision=16 -mfpmath=sse $OPT_FLAGS $LINK_FLAGS
-
-        # Eliminar los flags específicos de esta sección
-        COMMON_FLAGS="${COMMON_FLAGS/-mavx512bf16/}" 
-        COMMON_FLAGS=$(echo $COMMON_FLAGS | tr -s ' ' | xargs)
-
-    else
-        echo "AVX512BF16 not supported on this system. Skipping compilation with -mavx512bf16."
-    fi
-
 else
     echo "SSE2 not supported on this system. Skipping compilation for programs with reduced precision (float) data type."
 fi
@@ -13,8 +13,9 @@
  */
 
 #include "lapacke_utils_reimpl.h"
+#include "../../../common/include/despacho.h"
 
-void hfgemm(char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a, 
+DESPACHO_CUERPO void hfgemm_cuerpo(char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a, 
             int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc) {
 
     // Constantes
@@ -155,4 +156,43 @@ void hfgemm(char transa, char transb, int m, int n, int k, lapack_float alpha, c
             }
         }
     }
-}
\ No newline at end of file
+}
+
+DESPACHO_VARIANTES(hfgemm, (char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a,
+    int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc), (transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc))
+#if defined(USE_BF16)
+DESPACHO_VARIANTE(hfgemm, avx512bf16, "arch=x86-64-v4,avx512bf16", (char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a,
+    int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc), (transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc))
+#elif !defined(USE_FP16)
+DESPACHO_VARIANTE(hfgemm, avx512fp16, "arch=x86-64-v4,avx512fp16", (char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a,
+    int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc), (transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc))
+#endif
+
+// Variante de hfgemm escogida en tiempo de ejecución (ver despacho.h)
+typedef void (*hfgemm_kernel_t)(char, char, int, int, int, lapack_float, const lapack_float *,
+    int, const lapack_float *, int, lapack_float, lapack_float *, int);
+
+static hfgemm_kernel_t hfgemm_kernel = hfgemm_base;
+static const char *hfgemm_kernel_nombre = "base";
+
+// Escoge la variante de mayor nivel de ISA que soporta la CPU (con __fp16 solo existe la base)
+void seleccionar_kernel_hfgemm(void) {
+#if defined(USE_BF16)
+    DESPACHO_PROBAR(hfgemm, avx512bf16, DESPACHO_AVX512BF16)
+#elif !defined(USE_FP16)
+    DESPACHO_PROBAR(hfgemm, avx512fp16, DESPACHO_AVX512FP16)
+#endif
+    DESPACHO_PROBAR(hfgemm, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(hfgemm, x86_64_v3, DESPACHO_X86_64_V3)
+    hfgemm_kernel = hfgemm_base;
+    hfgemm_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+const char *hfgemm_variante(void) {
+    return hfgemm_kernel_nombre;
+}
+
+void hfgemm(char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a, 
+            int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc) {
+    hfgemm_kernel(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
@@ -66,6 +66,10 @@ lapack_float hfdot(int n, lapack_float *sx, int incx, lapack_float *sy, int incy
 void hfgemm(char transa, char transb, int m, int n, int k, lapack_float alpha, const lapack_float *a, 
     int lda, const lapack_float *b, int ldb, lapack_float beta, lapack_float *c, int ldc);
 
+// Variante de hfgemm según la CPU (ver Programas/common/include/despacho.h)
+void seleccionar_kernel_hfgemm(void);
+const char *hfgemm_variante(void);
+
 void hfgemv(char trans, int m, int n, lapack_float alpha, lapack_float *a, int lda,
     lapack_float *x, lapack_int incx, lapack_float beta, lapack_float *y, lapack_int incy);
 
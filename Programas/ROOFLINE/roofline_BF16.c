@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <omp.h>
+#include <stdint.h>
+
+#ifdef __aarch64__
+#include <arm_bf16.h>
+#endif
+
+#include "../common/include/cache_info.h"
+#include "../common/include/memoria.h"
+#include "../common/include/cronometro.h"
+#include "../common/include/despacho.h"
+
+/*
+    Techos del modelo roofline para __bf16: ancho de banda de memoria (STREAM triad) y pico de
+    operaciones FMA. Metricas/Programas/roofline.py ejecuta este programa para obtener los dos
+    techos y sitúa sobre ellos las ejecuciones de los demás benchmarks del mismo tipo.
+
+    - Triad: a[i] = b[i] + escalar * c[i], con tres vectores que por defecto ocupan cada uno
+      cuatro veces la LLC. Se cuentan 3 * n * sizeof(__bf16) bytes por vuelta, como STREAM (sin
+      la lectura de a que provoca el write-allocate).
+    - FMA: ACUMULADORES cadenas independientes acc = acc * a + b que el compilador mantiene en
+      registros vectoriales; 2 operaciones por elemento y vuelta. Es el pico que alcanza el
+      código en C compilado con los mismos flags que los benchmarks, no el teórico de la CPU.
+
+    Como en STREAM, cada techo se calcula con la mejor vuelta (mínimo) de las repeticiones.
+*/
+
+// Cadenas independientes: los mismos registros que 128 floats
+#define ACUMULADORES 256
+// Iteraciones de cada cadena en una vuelta del pico FMA
+#define ITERACIONES_FMA 1000000
+
+// Límites [inicio, fin) del bloque estático del hilo id, ajustados a líneas de caché de 64 bytes
+void bloque_hilo(int64_t n, int hilos, int id, int64_t *inicio, int64_t *fin) {
+    int elementos_linea = 64 / (int)sizeof(__bf16);
+    int64_t lineas = (n + elementos_linea - 1) / elementos_linea;
+    *inicio = lineas * id / hilos * elementos_linea;
+    *fin = lineas * (id + 1) / hilos * elementos_linea;
+    if (*inicio > n) *inicio = n;
+    if (*fin > n) *fin = n;
+}
+
+// STREAM triad sobre los elementos [inicio, fin) de un hilo
+DESPACHO_CUERPO void triad_bloque_cuerpo(int64_t inicio, int64_t fin, __bf16 *a, const __bf16 *b, const __bf16 *c, __bf16 escalar) {
+    for (int64_t i = inicio; i < fin; i++) {
+        a[i] = b[i] + escalar * c[i];
+    }
+}
+
+// Cadenas de FMA de un hilo; deja en suma la de los acumuladores para que no se eliminen
+DESPACHO_CUERPO void fma_hilo_cuerpo(int64_t iteraciones, __bf16 a, __bf16 b, float *suma) {
+    __bf16 acc[ACUMULADORES];
+
+    for (int j = 0; j < ACUMULADORES; j++) {
+        acc[j] = (__bf16)((float)j / ACUMULADORES);
+    }
+    for (int64_t it = 0; it < iteraciones; it++) {
+        for (int j = 0; j < ACUMULADORES; j++) {
+            acc[j] = acc[j] * a + b;
+        }
+    }
+
+    float total = 0.0f;
+    for (int j = 0; j < ACUMULADORES; j++) {
+        total += (float)acc[j];
+    }
+    *suma = total;
+}
+
+DESPACHO_VARIANTES(triad_bloque, (int64_t inicio, int64_t fin, __bf16 *a, const __bf16 *b, const __bf16 *c, __bf16 escalar), (inicio, fin, a, b, c, escalar))
+DESPACHO_VARIANTES(fma_hilo, (int64_t iteraciones, __bf16 a, __bf16 b, float *suma), (iteraciones, a, b, suma))
+DESPACHO_VARIANTE(triad_bloque, avx512bf16, "arch=x86-64-v4,avx512bf16", (int64_t inicio, int64_t fin, __bf16 *a, const __bf16 *b, const __bf16 *c, __bf16 escalar), (inicio, fin, a, b, c, escalar))
+DESPACHO_VARIANTE(fma_hilo, avx512bf16, "arch=x86-64-v4,avx512bf16", (int64_t iteraciones, __bf16 a, __bf16 b, float *suma), (iteraciones, a, b, suma))
+
+// Variantes de los dos techos escogidas en tiempo de ejecución, con el mismo criterio que los
+// kernels de los benchmarks (ver despacho.h)
+typedef void (*triad_bloque_kernel_t)(int64_t, int64_t, __bf16 *, const __bf16 *, const __bf16 *, __bf16);
+typedef void (*fma_hilo_kernel_t)(int64_t, __bf16, __bf16, float *);
+
+static triad_bloque_kernel_t triad_bloque_kernel = triad_bloque_base;
+static const char *triad_bloque_kernel_nombre = "base";
+static fma_hilo_kernel_t fma_hilo_kernel = fma_hilo_base;
+static const char *fma_hilo_kernel_nombre = "base";
+
+// Escogen la variante de mayor nivel de ISA que soporta la CPU
+void seleccionar_kernel_triad_bloque(void) {
+    DESPACHO_PROBAR(triad_bloque, avx512bf16, DESPACHO_AVX512BF16)
+    DESPACHO_PROBAR(triad_bloque, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(triad_bloque, x86_64_v3, DESPACHO_X86_64_V3)
+    triad_bloque_kernel = triad_bloque_base;
+    triad_bloque_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+void seleccionar_kernel_fma_hilo(void) {
+    DESPACHO_PROBAR(fma_hilo, avx512bf16, DESPACHO_AVX512BF16)
+    DESPACHO_PROBAR(fma_hilo, x86_64_v4, DESPACHO_X86_64_V4)
+    DESPACHO_PROBAR(fma_hilo, x86_64_v3, DESPACHO_X86_64_V3)
+    fma_hilo_kernel = fma_hilo_base;
+    fma_hilo_kernel_nombre = despacho_nombre(DESPACHO_BASE);
+}
+
+void triad_bloque(int64_t inicio, int64_t fin, __bf16 *a, const __bf16 *b, const __bf16 *c, __bf16 escalar) {
+    triad_bloque_kernel(inicio, fin, a, b, c, escalar);
+}
+
+float fma_hilo(int64_t iteraciones, __bf16 a, __bf16 b) {
+    float suma;
+    fma_hilo_kernel(iteraciones, a, b, &suma);
+    return suma;
+}
+
+// STREAM triad sobre el bloque de cada hilo (mismo reparto que la inicialización)
+void triad(int64_t n, __bf16 *a, const __bf16 *b, const __bf16 *c, __bf16 escalar, int hilos) {
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        triad_bloque(inicio, fin, a, b, c, escalar);
+    }
+}
+
+float fma_pico(int64_t iteraciones, __bf16 a, __bf16 b, int hilos) {
+    float suma = 0.0f;
+    #pragma omp parallel num_threads(hilos) reduction(+:suma)
+    {
+        suma += fma_hilo(iteraciones, a, b);
+    }
+    return suma;
+}
+
+int main(int argc, char *argv[]) {
+
+    int calentamiento = 1;
+    int repeticiones = 10;
+    int medir_contadores = 0;
+    int hilos = 1;
+    int opt;
+
+    // Manejar opciones (-v, -p, -t <hilos>, -w <calentamiento>, -r <repeticiones>, -H <memoria>)
+    while ((opt = getopt(argc, argv, "vpt:w:r:H:")) != -1) {
+        switch (opt) {
+            case 'v':
+                // Se acepta por compatibilidad con los scripts de ejecución; no hay datos que mostrar
+                break;
+            case 'p':
+                medir_contadores = 1;
+                break;
+            case 't':
+                hilos = atoi(optarg);
+                break;
+            case 'w':
+                calentamiento = atoi(optarg);
+                break;
+            case 'r':
+                repeticiones = atoi(optarg);
+                break;
+            case 'H':
+                if (memoria_seleccionar(optarg) != 0) {
+                    fprintf(stderr, "Modo de memoria desconocido: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v] [-p] [-t hilos] [-w calentamiento (1)] [-r repeticiones (10)] [-H malloc|thp|hugetlb] [<tamaño de los vectores de triad>] [<seed>]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    // Tamaño de triad: el indicado o cuatro veces la LLC por vector (el seed se acepta y no se usa)
+    int64_t n = (optind < argc) ? leer_tamanho(argv[optind]) : 4 * cache_tamanho_llc() / (int64_t)sizeof(__bf16);
+
+    if (n <= 0) {
+        fprintf(stderr, "El tamaño del vector debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cronometro_validar(calentamiento, repeticiones) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (hilos < 1) {
+        fprintf(stderr, "El número de hilos debe ser un número entero positivo.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Variantes de triad y de la FMA para esta CPU (ver despacho.h)
+    seleccionar_kernel_triad_bloque();
+    seleccionar_kernel_fma_hilo();
+    printf("Kernel triad: %s\n", triad_bloque_kernel_nombre);
+    printf("Kernel FMA: %s\n", fma_hilo_kernel_nombre);
+
+    // Contadores hardware alrededor de cada vuelta medida (ver contadores.h)
+    if (medir_contadores) {
+        contadores_abrir();
+    }
+
+    __bf16 *a = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *b = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+    __bf16 *c = (__bf16 *)memoria_reservar(n * sizeof(__bf16));
+
+    if (a == NULL || b == NULL || c == NULL) {
+        printf("Error al asignar memoria\n");
+        return EXIT_FAILURE;
+    }
+    printf("Memoria: %s (pedida: %s)\n", memoria_nombre_efectivo(), memoria_nombre_pedido());
+    printf("Hilos: %d\n", hilos);
+
+    // Inicialización con el mismo reparto que triad (first-touch en el nodo NUMA de cada hilo)
+    #pragma omp parallel num_threads(hilos)
+    {
+        int64_t inicio, fin;
+        bloque_hilo(n, hilos, omp_get_thread_num(), &inicio, &fin);
+        for (int64_t i = inicio; i < fin; i++) {
+            a[i] = (__bf16)0.0f;
+            b[i] = (__bf16)1.0f;
+            c[i] = (__bf16)2.0f;
+        }
+    }
+
+    cronometro_t cronometro;
+    estadisticas_t e;
+
+    // Techo de memoria
+    printf("Triad: %lld elementos por vector\n", (long long)n);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        triad(n, a, b, c, (__bf16)3.0f, hilos);
+        cronometro_parar(&cronometro);
+    }
+    cronometro_imprimir(&cronometro);
+    calcular_estadisticas(cronometro.muestras, cronometro.repeticiones, &e);
+    printf("Techo memoria (triad): %.3f GB/s\n", (3.0 * n * sizeof(__bf16)) / e.min / 1e9);
+
+    // Techo de cómputo (a < 1 y b pequeño: los acumuladores convergen a b / (1 - a) sin desbordar)
+    float suma = 0.0f;
+    printf("FMA: %d acumuladores, %d iteraciones por hilo\n", ACUMULADORES, ITERACIONES_FMA);
+    cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+    while (cronometro_continuar(&cronometro)) {
+        cronometro_arrancar(&cronometro);
+        suma = fma_pico(ITERACIONES_FMA, (__bf16)0.5f, (__bf16)0.25f, hilos);
+        cronometro_parar(&cronometro);
+    }
+    cronometro_imprimir(&cronometro);
+    calcular_estadisticas(cronometro.muestras, cronometro.repeticiones, &e);
+    printf("Techo computo (fma): %.3f GFLOP/s\n", (2.0 * ACUMULADORES * ITERACIONES_FMA * hilos) / e.min / 1e9);
+
+    // Se imprime un valor al final para evitar que las optimizaciones se salten alguna operaciones
+    printf("%f %.10e\n", (float)a[n-1], suma);
+
+    memoria_liberar(a);
+    memoria_liberar(b);
+    memoria_liberar(c);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * Utilidades comunes a los benchmarks: generación de los datos de entrada con un generador
+ * aleatorio basado en contador (Philox4x32-10), vectorizable y paralelo.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+    Los programas generaban sus datos con rand(), en serie y con una o dos llamadas por
+    elemento: con los vectores grandes de AXPY (134M elementos) o las matrices de PCA la
+    inicialización tardaba más que el kernel medido, y los valores dependían de la libc.
+
+    Con Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC'11)
+    el valor k-ésimo de la secuencia es una función pura de (seed, k): cada bloque de 4
+    valores se obtiene cifrando su contador con la seed como clave. Los hilos generan sus
+    trozos de forma independiente, el bucle de cada trozo se vectoriza y el resultado no
+    depende del número de hilos. Los valores se escriben directamente en el tipo de destino
+    desde un buffer pequeño por hilo, sin vectores float intermedios:
+
+        aleatorio_iniciar(seed, rand_libc);
+        ALEATORIO_RELLENAR(i, n, u, 2,
+            x[i] = (_Float16)(u[0] * 10.0f);
+            y[i] = (_Float16)(u[1] * 10.0f);
+        );
+
+    u apunta a los valores en [0, 1) que corresponden al elemento i (2 en el ejemplo, en el
+    mismo orden en que se llamaba a rand()). Cada relleno consume valores consecutivos de la
+    secuencia a partir del último relleno, como hacían las llamadas a rand().
+
+    Con --rand-libc se recupera la secuencia original, (float)rand() / (float)(RAND_MAX) tras
+    srand(seed), con un único hilo y en el mismo orden de llamadas, de modo que los datos
+    coinciden con los de referencia (*_seed1234.csv) generados antes de este cambio.
+*/
+
+/** \brief Código que devuelve getopt_long para --rand-libc (fuera del rango de las opciones cortas) */
+#define OPCION_RAND_LIBC 0x107
+
+/** \brief Elementos de cada trozo de un relleno (múltiplo de 4: un trozo empieza en un bloque de Philox) */
+#define ALEATORIO_TROZO 2048
+
+// Constantes de Philox4x32 (multiplicadores y constantes de Weyl de la clave)
+#define ALEATORIO_PHILOX_M0 0xD2511F53u
+#define ALEATORIO_PHILOX_M1 0xCD9E8D57u
+#define ALEATORIO_PHILOX_W0 0x9E3779B9u
+#define ALEATORIO_PHILOX_W1 0xBB67AE85u
+
+static int aleatorio_libc = 0;          // 1: secuencia de rand() de la libc (compatibilidad)
+static uint32_t aleatorio_semilla = 0;
+static uint64_t aleatorio_posicion = 0; // siguiente valor sin usar de la secuencia
+
+/**
+ * \brief Fija la seed y el generador, y reinicia la secuencia (sustituye a srand).
+ *
+ * \param[in] seed Semilla del programa.
+ * \param[in] rand_libc Distinto de 0 para usar rand() como antes de Philox.
+ */
+static inline void aleatorio_iniciar(unsigned int seed, int rand_libc) {
+    aleatorio_libc = rand_libc != 0;
+    aleatorio_semilla = seed;
+    aleatorio_posicion = 0;
+    srand(seed);
+}
+
+/**
+ * \brief Reserva cuantos valores consecutivos de la secuencia y devuelve el primero.
+ *
+ * Cada reserva empieza en un bloque de Philox (múltiplo de 4), así los trozos de un relleno
+ * siempre generan bloques completos.
+ */
+static inline uint64_t aleatorio_reservar(uint64_t cuantos) {
+    uint64_t inicio = (aleatorio_posicion + 3) & ~(uint64_t)3;
+    aleatorio_posicion = inicio + cuantos;
+    return inicio;
+}
+
+// Bloque de 4 valores de 32 bits para el contador indicado (10 rondas de Philox4x32)
+static inline void aleatorio_philox(uint64_t contador, uint32_t semilla, uint32_t salida[4]) {
+    uint32_t c0 = (uint32_t)contador, c1 = (uint32_t)(contador >> 32), c2 = 0, c3 = 0;
+    uint32_t k0 = semilla, k1 = 0;
+
+    #pragma GCC unroll 10
+    for (int ronda = 0; ronda < 10; ronda++) {
+        uint64_t p0 = (uint64_t)ALEATORIO_PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)ALEATORIO_PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += ALEATORIO_PHILOX_W0;
+        k1 += ALEATORIO_PHILOX_W1;
+    }
+    salida[0] = c0;
+    salida[1] = c1;
+    salida[2] = c2;
+    salida[3] = c3;
+}
+
+// 24 bits altos -> float en [0, 1) (exacto)
+static inline float aleatorio_a_float(uint32_t bits) {
+    return (float)(bits >> 8) * 0x1.0p-24f;
+}
+
+/**
+ * \brief Escribe en valores los cuantos valores de la secuencia que empiezan en inicio.
+ *
+ * inicio debe ser múltiplo de 4 (lo garantizan aleatorio_reservar y ALEATORIO_TROZO). Con
+ * --rand-libc se ignora inicio y se llama a rand() en orden, por lo que quien llama debe
+ * recorrer la secuencia en serie.
+ */
+static inline void aleatorio_generar(uint64_t inicio, int64_t cuantos, float *valores) {
+    if (aleatorio_libc) {
+        for (int64_t k = 0; k < cuantos; k++) {
+            valores[k] = (float)rand() / (float)(RAND_MAX);
+        }
+        return;
+    }
+
+    uint64_t primero = inicio / 4;
+    int64_t completos = cuantos / 4;
+    uint32_t semilla = aleatorio_semilla;
+
+    // Sin dependencias entre bloques: el compilador vectoriza las rondas (vpmuludq)
+    for (int64_t b = 0; b < completos; b++) {
+        uint32_t bits[4];
+        aleatorio_philox(primero + (uint64_t)b, semilla, bits);
+        valores[4 * b + 0] = aleatorio_a_float(bits[0]);
+        valores[4 * b + 1] = aleatorio_a_float(bits[1]);
+        valores[4 * b + 2] = aleatorio_a_float(bits[2]);
+        valores[4 * b + 3] = aleatorio_a_float(bits[3]);
+    }
+    if (4 * completos < cuantos) {
+        uint32_t bits[4];
+        aleatorio_philox(primero + (uint64_t)completos, semilla, bits);
+        for (int64_t k = 4 * completos; k < cuantos; k++) {
+            valores[k] = aleatorio_a_float(bits[k - 4 * completos]);
+        }
+    }
+}
+
+/** \brief Siguiente valor de la secuencia en [0, 1), para valores sueltos fuera de los rellenos */
+static inline float aleatorio_siguiente(void) {
+    float valor;
+    aleatorio_generar(aleatorio_reservar(1), 1, &valor);
+    return valor;
+}
+
+/**
+ * \brief Recorre los elementos [0, n) ejecutando el cuerpo con u apuntando a sus valores.
+ *
+ * \param i Nombre de la variable del elemento (int64_t) que usa el cuerpo.
+ * \param n Número de elementos.
+ * \param u Nombre del puntero a los valores del elemento (const float *).
+ * \param valores Valores de la secuencia por elemento (constante pequeña).
+ * \param ... Cuerpo: asignaciones a partir de u[0] ... u[valores - 1].
+ *
+ * Los trozos de ALEATORIO_TROZO elementos se reparten entre los hilos de OpenMP (en un solo
+ * hilo con --rand-libc, para conservar el orden de rand()).
+ */
+#define ALEATORIO_RELLENAR(i, n, u, valores, ...) do { \
+    int64_t aleatorio_n_ = (n); \
+    uint64_t aleatorio_base_ = aleatorio_reservar((uint64_t)aleatorio_n_ * (valores)); \
+    int64_t aleatorio_trozos_ = (aleatorio_n_ + ALEATORIO_TROZO - 1) / ALEATORIO_TROZO; \
+    _Pragma("omp parallel for schedule(static) if (!aleatorio_libc)") \
+    for (int64_t aleatorio_t_ = 0; aleatorio_t_ < aleatorio_trozos_; aleatorio_t_++) { \
+        float aleatorio_u_[ALEATORIO_TROZO * (valores)]; \
+        int64_t aleatorio_ini_ = aleatorio_t_ * ALEATORIO_TROZO; \
+        int64_t aleatorio_fin_ = aleatorio_ini_ + ALEATORIO_TROZO < aleatorio_n_ ? aleatorio_ini_ + ALEATORIO_TROZO : aleatorio_n_; \
+        aleatorio_generar(aleatorio_base_ + (uint64_t)aleatorio_ini_ * (valores), \
+                          (aleatorio_fin_ - aleatorio_ini_) * (valores), aleatorio_u_); \
+        for (int64_t i = aleatorio_ini_; i < aleatorio_fin_; i++) { \
+            const float *u = aleatorio_u_ + (i - aleatorio_ini_) * (valores); \
+            __VA_ARGS__ \
+        } \
+    } \
+} while (0)
+
+#endif /* ALEATORIO_H */
@@ -0,0 +1,100 @@
+/*
+ * Utilidades comunes a los benchmarks: barrido de tamaños en un único proceso (--sweep).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef BARRIDO_H
+#define BARRIDO_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cronometro.h"
+
+/*
+    Con --sweep n1,n2,... los programas no reciben el tamaño como argumento: reservan e
+    inicializan los datos una sola vez con el mayor tamaño de la lista, se saltan la
+    demostración con N_SMALL y miden el kernel para cada tamaño reutilizando los mismos
+    buffers (los n primeros elementos). Así se evita lanzar un proceso por tamaño, volver a
+    generar los datos aleatorios y repetir la inicialización, que dominan los barridos con n
+    pequeños y las ejecuciones emuladas (QEMU, SDE).
+
+    El resultado es una tabla CSV en la que todas las líneas empiezan por "barrido,":
+
+        barrido,medida,n,mediana,min,p95,media,desviacion
+        barrido,axpy,4096,0.000000812,0.000000790,0.000000901,0.000000820,0.000000030
+
+    Cada medida (kernel o rutina) aparece en el mismo orden para todos los tamaños.
+*/
+
+/** \brief Número máximo de tamaños de un barrido */
+#define BARRIDO_MAX_TAMANHOS 256
+
+/** \brief Código que devuelve getopt_long para --sweep (fuera del rango de las opciones cortas) */
+#define OPCION_BARRIDO 0x100
+
+typedef struct {
+    int num;
+    int64_t maximo;
+    int64_t tamanhos[BARRIDO_MAX_TAMANHOS];
+} barrido_t;
+
+/**
+ * \brief Lee una lista de tamaños separados por comas.
+ *
+ * \param[in] texto Argumento de --sweep, p. ej. "4096,8192,16384".
+ * \param[out] barrido Tamaños leídos y el mayor de ellos.
+ * \return int 0 si todos son enteros positivos, -1 en caso contrario.
+ */
+static inline int barrido_leer(const char *texto, barrido_t *barrido) {
+    const char *p = texto;
+
+    barrido->num = 0;
+    barrido->maximo = 0;
+
+    while (*p != '\0') {
+        char *fin;
+
+        if (barrido->num == BARRIDO_MAX_TAMANHOS) {
+            return -1;
+        }
+
+        errno = 0;
+        long long valor = strtoll(p, &fin, 10);
+        if (errno != 0 || fin == p || valor <= 0 || (*fin != ',' && *fin != '\0')) {
+            return -1;
+        }
+
+        barrido->tamanhos[barrido->num++] = (int64_t)valor;
+        if (valor > barrido->maximo) {
+            barrido->maximo = (int64_t)valor;
+        }
+
+        p = (*fin == ',') ? fin + 1 : fin;
+    }
+    return barrido->num > 0 ? 0 : -1;
+}
+
+/** \brief Imprime la cabecera de la tabla del barrido */
+static inline void barrido_cabecera(void) {
+    printf("barrido,medida,n,mediana,min,p95,media,desviacion\n");
+}
+
+/**
+ * \brief Imprime la fila de una medida para el tamaño n con las muestras del cronómetro.
+ *
+ * La fila no lleva contadores hardware, por lo que los programas rechazan -p junto a --sweep.
+ */
+static inline void barrido_imprimir(cronometro_t *c, const char *medida, int64_t n) {
+    estadisticas_t e;
+
+    calcular_estadisticas(c->muestras, c->repeticiones, &e);
+
+    printf("barrido,%s,%lld,%.9f,%.9f,%.9f,%.9f,%.9f\n", medida, (long long)n,
+           e.mediana, e.min, e.p95, e.media, e.desviacion);
+}
+
+#endif /* BARRIDO_H */
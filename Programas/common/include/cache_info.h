@@ -0,0 +1,133 @@
+/*
+ * Utilidades comunes a los benchmarks: detección de la jerarquía de caché.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef CACHE_INFO_H
+#define CACHE_INFO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** \brief Tamaños por defecto (bytes), los mismos que usa get_cache_info en tiempo_ejecucion.py */
+#define CACHE_L1_DEFECTO (48L * 1024)
+#define CACHE_L2_DEFECTO (1280L * 1024)
+#define CACHE_L3_DEFECTO (12L * 1024 * 1024)
+
+/**
+ * \brief Lee el tamaño de la caché de datos/unificada de nivel dado desde sysfs.
+ *
+ * \param[in] nivel Nivel de caché (1, 2 o 3).
+ * \return long Tamaño en bytes de una instancia de la caché, o 0 si no se encuentra.
+ *
+ * Recorre /sys/devices/system/cpu/cpu0/cache/indexN y descarta las cachés de
+ * instrucciones. Se usa cuando sysconf no conoce el tamaño (habitual en ARM).
+ */
+static inline long cache_tamanho_sysfs(int nivel) {
+    char ruta[128];
+    char tipo[32];
+
+    for (int indice = 0; indice < 16; indice++) {
+        int nivel_leido = 0;
+        long tamanho = 0;
+        char unidad = '\0';
+
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/level", indice);
+        FILE *f = fopen(ruta, "r");
+        if (f == NULL) {
+            break;
+        }
+        if (fscanf(f, "%d", &nivel_leido) != 1) {
+            nivel_leido = 0;
+        }
+        fclose(f);
+        if (nivel_leido != nivel) {
+            continue;
+        }
+
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/type", indice);
+        f = fopen(ruta, "r");
+        if (f == NULL || fscanf(f, "%31s", tipo) != 1) {
+            if (f != NULL) fclose(f);
+            continue;
+        }
+        fclose(f);
+        if (strcmp(tipo, "Instruction") == 0) {
+            continue;
+        }
+
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/size", indice);
+        f = fopen(ruta, "r");
+        if (f == NULL) {
+            continue;
+        }
+        if (fscanf(f, "%ld%c", &tamanho, &unidad) < 1) {
+            tamanho = 0;
+        }
+        fclose(f);
+
+        if (unidad == 'K') tamanho *= 1024L;
+        else if (unidad == 'M') tamanho *= 1024L * 1024;
+        else if (unidad == 'G') tamanho *= 1024L * 1024 * 1024;
+        return tamanho;
+    }
+    return 0;
+}
+
+/**
+ * \brief Obtiene el tamaño en bytes de la caché de datos de nivel 1, 2 o 3.
+ *
+ * \param[in] nivel Nivel de caché (1, 2 o 3).
+ * \return long Tamaño en bytes de una instancia de la caché.
+ *
+ * Consulta primero sysconf y, si no está disponible, sysfs. Si ninguno
+ * responde se devuelven los valores por defecto de tiempo_ejecucion.py.
+ */
+static inline long cache_tamanho(int nivel) {
+    long tamanho = 0;
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    if (nivel == 1) tamanho = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    else if (nivel == 2) tamanho = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    else if (nivel == 3) tamanho = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+
+    if (tamanho <= 0) {
+        tamanho = cache_tamanho_sysfs(nivel);
+    }
+
+    if (tamanho <= 0) {
+        if (nivel == 1) tamanho = CACHE_L1_DEFECTO;
+        else if (nivel == 2) tamanho = CACHE_L2_DEFECTO;
+        else tamanho = CACHE_L3_DEFECTO;
+    }
+    return tamanho;
+}
+
+/**
+ * \brief Tamaño de la caché de último nivel (LLC) en bytes.
+ *
+ * Si la máquina no tiene L3 (sysconf y sysfs devuelven 0) se toma la L2.
+ */
+static inline long cache_tamanho_llc(void) {
+    long tamanho = 0;
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    tamanho = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    if (tamanho <= 0) {
+        tamanho = cache_tamanho_sysfs(3);
+    }
+    if (tamanho <= 0) {
+        tamanho = cache_tamanho_sysfs(2);
+    }
+    if (tamanho <= 0) {
+        tamanho = CACHE_L3_DEFECTO;
+    }
+    return tamanho;
+}
+
+#endif /* CACHE_INFO_H */
@@ -0,0 +1,253 @@
+/*
+ * Utilidades comunes a los benchmarks: contadores hardware (perf_event_open) alrededor de la
+ * región medida (-p).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+/*
+    Con -p los programas abren al arrancar un contador de perf por evento y cronometro.h los
+    activa y desactiva alrededor de cada vuelta medida (las llamadas al sistema quedan fuera
+    del intervalo que mide el reloj). Tras la línea "Tiempo de ejecucion:" se imprime la media
+    por repetición de cada contador:
+
+        Contadores: ciclos 1203311 instrucciones 2406990 fallos_l1d 40012 ... ipc 2.00
+
+    Eventos:
+      - ciclos, instrucciones, fallos_l1d (lecturas) y fallos_llc: eventos genéricos de perf.
+      - Intel: FP_ARITH_INST_RETIRED (0xC7) agrupado en fp_escalar, fp_128, fp_256 y fp_512
+        (simple y doble precisión) y FP_ARITH_INST_RETIRED2 (0xCF) en fp16_escalar y fp16_vector.
+        0xCF solo se abre si la CPU tiene AVX512-FP16: en las anteriores ese código de evento no
+        existe o cuenta otra cosa, y la línea muestra "fp16 n/d". Las conversiones
+        F16C/VCVTPH2PS no cuentan como aritmética, de modo que muchas instrucciones con fp_*
+        bajos señalan código dominado por conversiones.
+      - ARM: VFP_SPEC (0x75, fp_escalar) y ASE_SPEC (0x74, fp_simd), ambos especulativos.
+
+    Cada evento se abre por separado (sin grupo), con inherit para sumar los hilos OpenMP que
+    se creen después, y se escala con tiempo_activo/tiempo_contando si el kernel los multiplexa.
+    Si perf_event_open no está disponible (contenedores, perf_event_paranoid, máquinas virtuales
+    sin PMU) se avisa una vez por stderr y el programa sigue sin contadores; los eventos que
+    no existan en la CPU se omiten sin más.
+*/
+
+#define CONTADORES_MAX 10
+
+typedef struct {
+    const char *nombre;
+    uint32_t tipo;
+    uint64_t config;
+} contador_evento_t;
+
+typedef struct {
+    int activos;
+    int num;
+    int fd[CONTADORES_MAX];
+    const char *nombre[CONTADORES_MAX];
+    uint64_t anterior[CONTADORES_MAX][3];  // última lectura: valor, tiempo activo, tiempo contando
+    double suma[CONTADORES_MAX];
+    int fp16_no_disponible;     // Intel sin AVX512-FP16: no se abre FP_ARITH_INST_RETIRED2
+} contadores_t;
+
+// Un único conjunto de contadores por proceso, compartido por todos los cronómetros
+static contadores_t contadores_proceso;
+
+#ifdef __linux__
+
+static inline int contadores_perf_event_open(struct perf_event_attr *attr) {
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, -1, 0);
+}
+
+/** \brief Abre un evento deshabilitado para este proceso y sus hilos futuros, o devuelve -1 */
+static inline int contadores_abrir_evento(uint32_t tipo, uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = tipo;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return contadores_perf_event_open(&attr);
+}
+
+/** \brief Añade a la lista los eventos de aritmética en coma flotante de la CPU, si los hay */
+static inline int contadores_eventos_fp(contador_evento_t *eventos) {
+    int num = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+
+    // Solo Intel (GenuineIntel) tiene FP_ARITH_INST_RETIRED con esta codificación
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) && ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e) {
+        eventos[num++] = (contador_evento_t){"fp_escalar", PERF_TYPE_RAW, 0xC7 | (0x03 << 8)};
+        eventos[num++] = (contador_evento_t){"fp_128", PERF_TYPE_RAW, 0xC7 | (0x0C << 8)};
+        eventos[num++] = (contador_evento_t){"fp_256", PERF_TYPE_RAW, 0xC7 | (0x30 << 8)};
+        eventos[num++] = (contador_evento_t){"fp_512", PERF_TYPE_RAW, 0xC7 | (0xC0 << 8)};
+        if (__builtin_cpu_supports("avx512fp16")) {
+            eventos[num++] = (contador_evento_t){"fp16_escalar", PERF_TYPE_RAW, 0xCF | (0x01 << 8)};
+            eventos[num++] = (contador_evento_t){"fp16_vector", PERF_TYPE_RAW, 0xCF | (0x1C << 8)};
+        } else {
+            contadores_proceso.fp16_no_disponible = 1;
+        }
+    }
+#elif defined(__aarch64__)
+    eventos[num++] = (contador_evento_t){"fp_escalar", PERF_TYPE_RAW, 0x75};
+    eventos[num++] = (contador_evento_t){"fp_simd", PERF_TYPE_RAW, 0x74};
+#else
+    (void)eventos;
+#endif
+
+    return num;
+}
+
+/**
+ * \brief Abre los contadores del proceso (-p).
+ *
+ * \return int Número de contadores abiertos; 0 si no hay ninguno disponible.
+ */
+static inline int contadores_abrir(void) {
+    contador_evento_t eventos[CONTADORES_MAX] = {
+        {"ciclos", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instrucciones", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"fallos_l1d", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {"fallos_llc", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+    int num_eventos = 4 + contadores_eventos_fp(eventos + 4);
+    int error = 0;
+
+    contadores_t *c = &contadores_proceso;
+    c->num = 0;
+
+    for (int i = 0; i < num_eventos; i++) {
+        int fd = contadores_abrir_evento(eventos[i].tipo, eventos[i].config);
+        if (fd < 0) {
+            if (error == 0) {
+                error = errno;
+            }
+            continue;
+        }
+        c->fd[c->num] = fd;
+        c->nombre[c->num] = eventos[i].nombre;
+        c->num++;
+    }
+
+    if (c->num == 0) {
+        fprintf(stderr, "Contadores hardware no disponibles (%s); se continúa sin ellos.\n", strerror(error));
+    }
+    c->activos = c->num > 0;
+    return c->num;
+}
+
+/** \brief Pone a cero las sumas antes de una nueva medida (lo llama cronometro_iniciar) */
+static inline void contadores_reiniciar(void) {
+    for (int i = 0; i < contadores_proceso.num; i++) {
+        contadores_proceso.suma[i] = 0.0;
+    }
+}
+
+/** \brief Activa los contadores justo antes de la región medida */
+static inline void contadores_arrancar(void) {
+    contadores_t *c = &contadores_proceso;
+    if (!c->activos) {
+        return;
+    }
+    for (int i = 0; i < c->num; i++) {
+        ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/**
+ * \brief Desactiva los contadores y, si la vuelta es medida, suma lo contado en ella.
+ *
+ * Se trabaja con la diferencia respecto a la lectura anterior (también del valor y de los
+ * tiempos activo/contando) para escalar cada vuelta por separado cuando hay multiplexado.
+ */
+static inline void contadores_parar(int acumular) {
+    contadores_t *c = &contadores_proceso;
+    if (!c->activos) {
+        return;
+    }
+    for (int i = 0; i < c->num; i++) {
+        ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < c->num; i++) {
+        uint64_t lectura[3];
+        if (read(c->fd[i], lectura, sizeof(lectura)) != (ssize_t)sizeof(lectura)) {
+            continue;
+        }
+        double valor = (double)(lectura[0] - c->anterior[i][0]);
+        double activo = (double)(lectura[1] - c->anterior[i][1]);
+        double contando = (double)(lectura[2] - c->anterior[i][2]);
+        memcpy(c->anterior[i], lectura, sizeof(lectura));
+
+        if (acumular) {
+            c->suma[i] += (contando > 0.0 && contando < activo) ? valor * (activo / contando) : valor;
+        }
+    }
+}
+
+/** \brief Imprime la media por repetición de cada contador abierto */
+static inline void contadores_imprimir(int repeticiones) {
+    contadores_t *c = &contadores_proceso;
+    double ciclos = -1.0, instrucciones = -1.0;
+
+    if (!c->activos) {
+        return;
+    }
+
+    printf("Contadores:");
+    for (int i = 0; i < c->num; i++) {
+        double media = c->suma[i] / repeticiones;
+        printf(" %s %.0f", c->nombre[i], media);
+        if (strcmp(c->nombre[i], "ciclos") == 0) {
+            ciclos = media;
+        } else if (strcmp(c->nombre[i], "instrucciones") == 0) {
+            instrucciones = media;
+        }
+    }
+    if (c->fp16_no_disponible) {
+        printf(" fp16 n/d");
+    }
+    if (instrucciones >= 0.0 && ciclos > 0.0) {
+        printf(" ipc %.2f", instrucciones / ciclos);
+    }
+    printf("\n");
+}
+
+#else /* !__linux__ */
+
+static inline int contadores_abrir(void) {
+    fprintf(stderr, "Contadores hardware no disponibles en este sistema; se continúa sin ellos.\n");
+    return 0;
+}
+static inline void contadores_reiniciar(void) {}
+static inline void contadores_arrancar(void) {}
+static inline void contadores_parar(int acumular) { (void)acumular; }
+static inline void contadores_imprimir(int repeticiones) { (void)repeticiones; }
+
+#endif /* __linux__ */
+
+#endif /* CONTADORES_H */
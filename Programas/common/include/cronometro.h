@@ -0,0 +1,174 @@
+/*
+ * Utilidades comunes a los benchmarks: medición repetida de tiempos dentro del proceso.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "contadores.h"
+
+/*
+    Cada medida se toma con clock_gettime(CLOCK_MONOTONIC_RAW), un reloj de pared que no
+    ajusta NTP y que en Linux se lee desde el vDSO sin llamada al sistema (resolución de
+    nanosegundos, coste de unos 20 ns). Sustituye a clock(), que mide tiempo de CPU con
+    resolución de 1 µs. No se usa rdtsc directamente porque su frecuencia habría que calibrarla
+    y no existe en ARM; el vDSO ya lo emplea internamente cuando el TSC es fiable.
+
+    Uso desde los programas (-w <calentamiento> -r <repeticiones>):
+
+        cronometro_t cronometro;
+        cronometro_iniciar(&cronometro, calentamiento, repeticiones);
+        while (cronometro_continuar(&cronometro)) {
+            // restaurar los datos de entrada (fuera de la medida)
+            cronometro_arrancar(&cronometro);
+            kernel(...);
+            cronometro_parar(&cronometro);
+        }
+        double tiempo = cronometro_imprimir(&cronometro);
+
+    Las primeras calentamiento vueltas no se guardan. Con una repetición y sin calentamiento
+    el comportamiento es el de antes: una única llamada medida.
+
+    Si el programa abrió los contadores hardware (-p, ver contadores.h), arrancar y parar
+    también los activan y desactivan, fuera del intervalo que mide el reloj.
+*/
+
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+/** \brief Número máximo de repeticiones medidas (las muestras se guardan en el propio cronómetro) */
+#define CRONOMETRO_MAX_REPETICIONES 10000
+
+typedef struct {
+    double min;
+    double mediana;
+    double p95;
+    double media;
+    double desviacion;
+} estadisticas_t;
+
+typedef struct {
+    int calentamiento;
+    int repeticiones;
+    int vuelta;
+    struct timespec inicio;
+    double muestras[CRONOMETRO_MAX_REPETICIONES];
+} cronometro_t;
+
+/**
+ * \brief Comprueba los parámetros de -w y -r.
+ *
+ * \return int 0 si son válidos; en caso contrario escribe el error en stderr y devuelve -1.
+ */
+static inline int cronometro_validar(int calentamiento, int repeticiones) {
+    if (calentamiento < 0) {
+        fprintf(stderr, "El número de iteraciones de calentamiento no puede ser negativo.\n");
+        return -1;
+    }
+    if (repeticiones < 1 || repeticiones > CRONOMETRO_MAX_REPETICIONES) {
+        fprintf(stderr, "El número de repeticiones debe estar entre 1 y %d.\n", CRONOMETRO_MAX_REPETICIONES);
+        return -1;
+    }
+    return 0;
+}
+
+static inline void cronometro_iniciar(cronometro_t *c, int calentamiento, int repeticiones) {
+    c->calentamiento = calentamiento;
+    c->repeticiones = repeticiones;
+    c->vuelta = 0;
+    contadores_reiniciar();
+}
+
+/** \brief Devuelve 1 mientras queden vueltas de calentamiento o de medida */
+static inline int cronometro_continuar(const cronometro_t *c) {
+    return c->vuelta < c->calentamiento + c->repeticiones;
+}
+
+static inline void cronometro_arrancar(cronometro_t *c) {
+    contadores_arrancar();
+    clock_gettime(CLOCK_MONOTONIC_RAW, &c->inicio);
+}
+
+/**
+ * \brief Abre la vuelta actual solo con el reloj; los contadores los activa antes quien llama
+ * (p. ej. antes de una barrera, para que sus llamadas al sistema no retrasen el inicio).
+ */
+static inline void cronometro_arrancar_reloj(cronometro_t *c) {
+    clock_gettime(CLOCK_MONOTONIC_RAW, &c->inicio);
+}
+
+/** \brief Cierra la vuelta actual y guarda su duración si ya terminó el calentamiento */
+static inline void cronometro_parar(cronometro_t *c) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &fin);
+
+    int indice = c->vuelta - c->calentamiento;
+    if (indice >= 0) {
+        c->muestras[indice] = (double)(fin.tv_sec - c->inicio.tv_sec) + (double)(fin.tv_nsec - c->inicio.tv_nsec) * 1e-9;
+    }
+    contadores_parar(indice >= 0);
+    c->vuelta++;
+}
+
+static inline int cronometro_comparar(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * \brief Calcula mínimo, mediana, percentil 95, media y desviación típica de n muestras.
+ *
+ * Ordena las muestras en el sitio. El percentil 95 es el del rango más cercano.
+ */
+static inline void calcular_estadisticas(double *muestras, int n, estadisticas_t *e) {
+    double suma = 0.0;
+    double suma_cuadrados = 0.0;
+
+    qsort(muestras, (size_t)n, sizeof(double), cronometro_comparar);
+
+    for (int i = 0; i < n; i++) {
+        suma += muestras[i];
+    }
+    e->media = suma / n;
+    for (int i = 0; i < n; i++) {
+        suma_cuadrados += (muestras[i] - e->media) * (muestras[i] - e->media);
+    }
+
+    e->min = muestras[0];
+    e->mediana = (n % 2 == 1) ? muestras[n / 2] : 0.5 * (muestras[n / 2 - 1] + muestras[n / 2]);
+    e->p95 = muestras[(95 * n + 99) / 100 - 1];
+    e->desviacion = n > 1 ? sqrt(suma_cuadrados / (n - 1)) : 0.0;
+}
+
+/**
+ * \brief Imprime el resultado de la medida y devuelve la mediana.
+ *
+ * La línea "Tiempo de ejecucion:" lleva la mediana (la única muestra si no hay repeticiones)
+ * con resolución de nanosegundos, que es la que leen los scripts de Metricas. Si hay varias
+ * repeticiones se añade una línea "Estadisticas:" con el resto de valores, y con -p una línea
+ * "Contadores:".
+ */
+static inline double cronometro_imprimir(cronometro_t *c) {
+    estadisticas_t e;
+
+    calcular_estadisticas(c->muestras, c->repeticiones, &e);
+
+    printf("Tiempo de ejecucion: %.9f\n", e.mediana);
+    if (c->repeticiones > 1) {
+        printf("Estadisticas: min %.9f mediana %.9f p95 %.9f media %.9f desviacion %.9f (repeticiones %d, calentamiento %d)\n",
+               e.min, e.mediana, e.p95, e.media, e.desviacion, c->repeticiones, c->calentamiento);
+    }
+    contadores_imprimir(c->repeticiones);
+    return e.mediana;
+}
+
+#endif /* CRONOMETRO_H */
@@ -0,0 +1,298 @@
+/*
+ * Utilidades comunes a los benchmarks: DCT-II/DCT-III 2D separable por bloques de 8x8 y
+ * 16x16 (como JPEG), con pasadas vectoriales por filas y transposiciones con unpack/shuffle.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef DCT_2D_H
+#define DCT_2D_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+/*
+    Cada bloque X de B x B píxeles (B = 8 o 16) se transforma con la DCT-II ortonormal
+    Y = C X C^T y se reconstruye con la DCT-III X = C^T Y C, con C[k][i] = alpha_k
+    cos(pi (2i + 1) k / 2B). Las dos son el mismo kernel con otra matriz M (C o C^T): una
+    pasada multiplica por M por la izquierda, fila_k = sum_i M[k][i] fila_i (B FMAs con M[k][i]
+    difundido), y va seguida de una transposición, así que dos pasadas dan
+    (M (M X)^T)^T = M X M^T.
+
+    El bloque se carga una vez, una fila por registro, y no vuelve a la imagen hasta terminar.
+    Una pasada necesita a la vez las B filas y los B acumuladores, así que solo los bloques de
+    8x8 caben en el banco de registros: 8 + 8 ymm con AVX2 (justo los 16, con algún desborde
+    por los coeficientes difundidos) y, con AVX-512, dos bloques vecinos por registro (uno en
+    cada mitad de 256 bits) en 8 + 8 de los 32 zmm. Los de 16x16 no caben: son 16 + 16 zmm con
+    AVX-512 y 32 + 32 ymm con AVX2, y el compilador desborda parte del bloque a la pila, que
+    queda en L1. Las transposiciones son las clásicas con unpack/shuffle y cruces de carriles
+    de 128 bits. Son 4B FLOP por píxel y pasada de la imagen, con solo una lectura y una
+    escritura del píxel en la imagen: un kernel denso en cómputo.
+
+    Los programas guardan la imagen en su tipo (float, _Float16, __bf16, __fp16) y operan en
+    float: al cargar se ensancha y al guardar se redondea una sola vez por coeficiente, como la
+    suma directa de Programas/DCT. Las matrices se calculan en double y se guardan en float.
+
+    La imagen tiene alto y ancho múltiplos de B (los programas rellenan repitiendo el borde,
+    como los codificadores JPEG) y se recorre por franjas de B filas: los hilos se reparten las
+    franjas y cada una se procesa de izquierda a derecha, de modo que sus B filas (B * ancho
+    elementos) siguen en L1/L2 mientras se leen los bloques y las líneas de caché se aprovechan
+    enteras entre bloques vecinos.
+*/
+
+/** \brief Mayor lado de bloque (los bloques son de 8x8 o de 16x16) */
+#define DCT_2D_BLOQUE_MAX 16
+
+/** \brief Lado de bloque por defecto (el de JPEG) */
+#define DCT_2D_BLOQUE 8
+
+/** \brief Indica si el lado de bloque está soportado */
+static inline int dct_2d_bloque_valido(int bloque) {
+    return bloque == 8 || bloque == 16;
+}
+
+/**
+ * \brief Matrices de la DCT-II (directa = C) y de la DCT-III (inversa = C^T) de lado bloque.
+ *
+ * \param[in] bloque Lado del bloque (8 o 16).
+ * \param[out] directa, inversa bloque * bloque valores por filas.
+ */
+static inline void dct_2d_matrices(int bloque, float *directa, float *inversa) {
+    for (int k = 0; k < bloque; k++) {
+        double alpha = sqrt((k == 0 ? 1.0 : 2.0) / bloque);
+        for (int i = 0; i < bloque; i++) {
+            float c = (float)(alpha * cos(M_PI * (2 * i + 1) * k / (2.0 * bloque)));
+            directa[k * bloque + i] = c;
+            inversa[i * bloque + k] = c;
+        }
+    }
+}
+
+/**
+ * \brief Transforma un bloque en float con la matriz indicada (versión escalar, de referencia).
+ *
+ * Mismas pasadas y transposiciones que los kernels vectoriales: x = M x M^T en el sitio.
+ */
+static inline void dct_2d_bloque_escalar(const float *matriz, float *x, int bloque) {
+    float t[DCT_2D_BLOQUE_MAX * DCT_2D_BLOQUE_MAX];
+
+    for (int pasada = 0; pasada < 2; pasada++) {
+        for (int k = 0; k < bloque; k++) {
+            float fila[DCT_2D_BLOQUE_MAX] = {0.0f};
+            for (int i = 0; i < bloque; i++) {
+                float m = matriz[k * bloque + i];
+                for (int j = 0; j < bloque; j++) {
+                    fila[j] += m * x[i * bloque + j];
+                }
+            }
+            for (int j = 0; j < bloque; j++) {
+                t[j * bloque + k] = fila[j];
+            }
+        }
+        memcpy(x, t, (size_t)bloque * bloque * sizeof(float));
+    }
+}
+
+#ifdef __x86_64__
+
+// Transpone en registros un bloque de 8x8 float (una fila por registro)
+__attribute__((target("avx2,fma"), always_inline))
+static inline void dct_2d_transponer_8x8_avx2(__m256 f[8]) {
+    __m256 t[8], u[8];
+
+    for (int i = 0; i < 4; i++) {
+        t[2 * i] = _mm256_unpacklo_ps(f[2 * i], f[2 * i + 1]);
+        t[2 * i + 1] = _mm256_unpackhi_ps(f[2 * i], f[2 * i + 1]);
+    }
+    for (int i = 0; i < 2; i++) {
+        u[4 * i + 0] = _mm256_shuffle_ps(t[4 * i], t[4 * i + 2], 0x44);
+        u[4 * i + 1] = _mm256_shuffle_ps(t[4 * i], t[4 * i + 2], 0xEE);
+        u[4 * i + 2] = _mm256_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0x44);
+        u[4 * i + 3] = _mm256_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0xEE);
+    }
+    // Las filas 0-3 de cada columna están en u[0..3] y las 4-7 en u[4..7], por mitades de 128 bits
+    for (int i = 0; i < 4; i++) {
+        f[i] = _mm256_permute2f128_ps(u[i], u[4 + i], 0x20);
+        f[4 + i] = _mm256_permute2f128_ps(u[i], u[4 + i], 0x31);
+    }
+}
+
+// Pasada sobre las filas del bloque: f_k = sum_i m[k][i] f_i
+__attribute__((target("avx2,fma"), always_inline))
+static inline void dct_2d_pasada_8_avx2(const float *m, __m256 f[8]) {
+    __m256 r[8];
+
+    for (int k = 0; k < 8; k++) {
+        r[k] = _mm256_mul_ps(_mm256_set1_ps(m[8 * k]), f[0]);
+        for (int i = 1; i < 8; i++) {
+            r[k] = _mm256_fmadd_ps(_mm256_set1_ps(m[8 * k + i]), f[i], r[k]);
+        }
+    }
+    for (int k = 0; k < 8; k++) {
+        f[k] = r[k];
+    }
+}
+
+/** \brief Bloque de 8x8 en registros AVX2: f = M f M^T */
+__attribute__((target("avx2,fma"), always_inline))
+static inline void dct_2d_8x8_avx2(const float *m, __m256 f[8]) {
+    dct_2d_pasada_8_avx2(m, f);
+    dct_2d_transponer_8x8_avx2(f);
+    dct_2d_pasada_8_avx2(m, f);
+    dct_2d_transponer_8x8_avx2(f);
+}
+
+/**
+ * \brief Bloque de 16x16 con AVX2: f[2i] y f[2i + 1] son las mitades de la fila i.
+ *
+ * Cada pasada trabaja sobre las dos mitades con los mismos coeficientes; la transposición de
+ * 16x16 es la de los cuatro cuadrantes de 8x8, intercambiando los dos de fuera de la diagonal.
+ * Las 32 mitades y sus 32 acumuladores no caben en los 16 ymm: el bloque se desborda a la pila.
+ */
+__attribute__((target("avx2,fma"), always_inline))
+static inline void dct_2d_16x16_avx2(const float *m, __m256 f[32]) {
+    for (int pasada = 0; pasada < 2; pasada++) {
+        __m256 r[32];
+
+        for (int k = 0; k < 16; k++) {
+            __m256 c = _mm256_set1_ps(m[16 * k]);
+            r[2 * k] = _mm256_mul_ps(c, f[0]);
+            r[2 * k + 1] = _mm256_mul_ps(c, f[1]);
+            for (int i = 1; i < 16; i++) {
+                c = _mm256_set1_ps(m[16 * k + i]);
+                r[2 * k] = _mm256_fmadd_ps(c, f[2 * i], r[2 * k]);
+                r[2 * k + 1] = _mm256_fmadd_ps(c, f[2 * i + 1], r[2 * k + 1]);
+            }
+        }
+
+        for (int cuadrante = 0; cuadrante < 4; cuadrante++) {
+            int fila = 8 * (cuadrante / 2), mitad = cuadrante % 2;
+            __m256 q[8];
+            for (int i = 0; i < 8; i++) {
+                q[i] = r[2 * (fila + i) + mitad];
+            }
+            dct_2d_transponer_8x8_avx2(q);
+            // El cuadrante (fila, mitad) pasa a (mitad, fila)
+            for (int i = 0; i < 8; i++) {
+                f[2 * (8 * mitad + i) + fila / 8] = q[i];
+            }
+        }
+    }
+}
+
+// Transpone en registros dos bloques de 8x8 float, uno en cada mitad de 256 bits de las filas
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_transponer_8x8_x2_avx512(__m512 f[8]) {
+    // Carriles de 128 bits: (u[i].0, u[4+i].0, u[i].2, u[4+i].2) y (u[i].1, u[4+i].1, u[i].3, u[4+i].3)
+    const __m512i bajos = _mm512_setr_epi32(0, 1, 2, 3, 16, 17, 18, 19, 8, 9, 10, 11, 24, 25, 26, 27);
+    const __m512i altos = _mm512_setr_epi32(4, 5, 6, 7, 20, 21, 22, 23, 12, 13, 14, 15, 28, 29, 30, 31);
+    __m512 t[8], u[8];
+
+    for (int i = 0; i < 4; i++) {
+        t[2 * i] = _mm512_unpacklo_ps(f[2 * i], f[2 * i + 1]);
+        t[2 * i + 1] = _mm512_unpackhi_ps(f[2 * i], f[2 * i + 1]);
+    }
+    for (int i = 0; i < 2; i++) {
+        u[4 * i + 0] = _mm512_shuffle_ps(t[4 * i], t[4 * i + 2], 0x44);
+        u[4 * i + 1] = _mm512_shuffle_ps(t[4 * i], t[4 * i + 2], 0xEE);
+        u[4 * i + 2] = _mm512_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0x44);
+        u[4 * i + 3] = _mm512_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0xEE);
+    }
+    for (int i = 0; i < 4; i++) {
+        f[i] = _mm512_permutex2var_ps(u[i], bajos, u[4 + i]);
+        f[4 + i] = _mm512_permutex2var_ps(u[i], altos, u[4 + i]);
+    }
+}
+
+// Pasada sobre las filas de dos bloques de 8x8 vecinos (mismos coeficientes en las dos mitades)
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_pasada_8_avx512(const float *m, __m512 f[8]) {
+    __m512 r[8];
+
+    for (int k = 0; k < 8; k++) {
+        r[k] = _mm512_mul_ps(_mm512_set1_ps(m[8 * k]), f[0]);
+        for (int i = 1; i < 8; i++) {
+            r[k] = _mm512_fmadd_ps(_mm512_set1_ps(m[8 * k + i]), f[i], r[k]);
+        }
+    }
+    for (int k = 0; k < 8; k++) {
+        f[k] = r[k];
+    }
+}
+
+/** \brief Dos bloques de 8x8 vecinos en registros AVX-512 (fila i de cada uno en f[i]) */
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_8x8_x2_avx512(const float *m, __m512 f[8]) {
+    dct_2d_pasada_8_avx512(m, f);
+    dct_2d_transponer_8x8_x2_avx512(f);
+    dct_2d_pasada_8_avx512(m, f);
+    dct_2d_transponer_8x8_x2_avx512(f);
+}
+
+// Transpone un bloque de 16x16 float (una fila por registro) con unpack/shuffle y vshuff32x4
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_transponer_16x16_avx512(__m512 f[16]) {
+    __m512 t[16], u[16];
+
+    for (int i = 0; i < 8; i++) {
+        t[2 * i] = _mm512_unpacklo_ps(f[2 * i], f[2 * i + 1]);
+        t[2 * i + 1] = _mm512_unpackhi_ps(f[2 * i], f[2 * i + 1]);
+    }
+    // u[4j + c] tiene, en su carril de 128 bits l, las filas 4j..4j+3 de la columna 4l + c
+    for (int j = 0; j < 4; j++) {
+        u[4 * j + 0] = _mm512_shuffle_ps(t[4 * j], t[4 * j + 2], 0x44);
+        u[4 * j + 1] = _mm512_shuffle_ps(t[4 * j], t[4 * j + 2], 0xEE);
+        u[4 * j + 2] = _mm512_shuffle_ps(t[4 * j + 1], t[4 * j + 3], 0x44);
+        u[4 * j + 3] = _mm512_shuffle_ps(t[4 * j + 1], t[4 * j + 3], 0xEE);
+    }
+    // Dos rondas de vshuff32x4 juntan los carriles l de u[c], u[4 + c], u[8 + c] y u[12 + c]
+    for (int c = 0; c < 4; c++) {
+        __m512 pares0 = _mm512_shuffle_f32x4(u[c], u[4 + c], 0x88);
+        __m512 impares0 = _mm512_shuffle_f32x4(u[c], u[4 + c], 0xDD);
+        __m512 pares1 = _mm512_shuffle_f32x4(u[8 + c], u[12 + c], 0x88);
+        __m512 impares1 = _mm512_shuffle_f32x4(u[8 + c], u[12 + c], 0xDD);
+        f[c] = _mm512_shuffle_f32x4(pares0, pares1, 0x88);
+        f[8 + c] = _mm512_shuffle_f32x4(pares0, pares1, 0xDD);
+        f[4 + c] = _mm512_shuffle_f32x4(impares0, impares1, 0x88);
+        f[12 + c] = _mm512_shuffle_f32x4(impares0, impares1, 0xDD);
+    }
+}
+
+// Pasada sobre las filas de un bloque de 16x16
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_pasada_16_avx512(const float *m, __m512 f[16]) {
+    __m512 r[16];
+
+    for (int k = 0; k < 16; k++) {
+        r[k] = _mm512_mul_ps(_mm512_set1_ps(m[16 * k]), f[0]);
+        for (int i = 1; i < 16; i++) {
+            r[k] = _mm512_fmadd_ps(_mm512_set1_ps(m[16 * k + i]), f[i], r[k]);
+        }
+    }
+    for (int k = 0; k < 16; k++) {
+        f[k] = r[k];
+    }
+}
+
+/**
+ * \brief Bloque de 16x16 con AVX-512: f = M f M^T.
+ *
+ * Las 16 filas y los 16 acumuladores de cada pasada llenan los 32 zmm antes de contar los
+ * coeficientes difundidos, así que parte del bloque se desborda a la pila.
+ */
+__attribute__((target("avx512f"), always_inline))
+static inline void dct_2d_16x16_avx512(const float *m, __m512 f[16]) {
+    dct_2d_pasada_16_avx512(m, f);
+    dct_2d_transponer_16x16_avx512(f);
+    dct_2d_pasada_16_avx512(m, f);
+    dct_2d_transponer_16x16_avx512(f);
+}
+
+#endif /* __x86_64__ */
+
+#endif /* DCT_2D_H */
@@ -0,0 +1,146 @@
+/*
+ * Utilidades comunes a los benchmarks: selección en tiempo de ejecución de la variante de un
+ * kernel según las extensiones de la CPU (despacho por ISA).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef DESPACHO_H
+#define DESPACHO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Los kernels principales (axpy, dct, convolve1d_generic, calculate_covariance, hfgemm) se
+    escriben una sola vez como cuerpo DESPACHO_CUERPO y se instancian con DESPACHO_VARIANTES en
+    una función por nivel de ISA, cada una con su atributo target. El programa escoge al
+    arrancar la mejor que soporta la CPU con despacho_soporta e imprime cuál usa, de modo que
+    un único ejecutable (compilado sin -march) se puede llevar de una máquina a otra:
+
+        DESPACHO_CUERPO void dct_cuerpo(_Float16 *input, _Float16 *output, int64_t n_size) { ... }
+        DESPACHO_VARIANTES(dct, (_Float16 *input, _Float16 *output, int64_t n_size), (input, output, n_size))
+        DESPACHO_VARIANTE(dct, avx512fp16, "arch=x86-64-v4,avx512fp16", (...), (...))
+
+    define dct_base, dct_x86_64_v3, dct_x86_64_v4 y dct_avx512fp16. Al incluirse el cuerpo en
+    cada variante, el compilador lo vectoriza con las instrucciones del nivel (AVX2+FMA+F16C en
+    x86-64-v3, AVX-512 en x86-64-v4 y aritmética nativa en FP16/BF16 con AVX512-FP16/-BF16).
+    target_clones no sirve para los dos últimos: GCC no sabe despachar esas extensiones.
+
+    El nivel máximo se puede limitar con la variable de entorno DESPACHO_ISA (base, x86-64-v3,
+    x86-64-v4, avx512fp16 o avx512bf16) para comparar las variantes en una misma máquina.
+
+    Fuera de x86-64 solo existe la variante base (compilada con los flags del script).
+*/
+
+typedef enum {
+    DESPACHO_BASE = 0,
+    DESPACHO_X86_64_V3,
+    DESPACHO_X86_64_V4,
+    DESPACHO_AVX512FP16,
+    DESPACHO_AVX512BF16,
+    DESPACHO_NUM
+} despacho_isa_t;
+
+static const char *const despacho_nombres[DESPACHO_NUM] = {
+    "base", "x86-64-v3", "x86-64-v4", "avx512fp16", "avx512bf16"
+};
+
+// Orden de los niveles para DESPACHO_ISA (AVX512-FP16 y AVX512-BF16 están al mismo nivel)
+static const int despacho_rango[DESPACHO_NUM] = {0, 1, 2, 3, 3};
+
+/** \brief Nombre de un nivel de ISA, como se imprime y como se acepta en DESPACHO_ISA */
+static inline const char *despacho_nombre(despacho_isa_t isa) {
+    return despacho_nombres[isa];
+}
+
+/** \brief Rango máximo permitido por DESPACHO_ISA (sin límite si no está definida) */
+static inline int despacho_limite(void) {
+    static int limite = -1;
+    const char *pedido;
+
+    if (limite >= 0) {
+        return limite;
+    }
+    limite = despacho_rango[DESPACHO_NUM - 1];
+    pedido = getenv("DESPACHO_ISA");
+    if (pedido == NULL || pedido[0] == '\0') {
+        return limite;
+    }
+    for (int i = 0; i < DESPACHO_NUM; i++) {
+        if (strcmp(pedido, despacho_nombres[i]) == 0) {
+            limite = despacho_rango[i];
+            return limite;
+        }
+    }
+    fprintf(stderr, "DESPACHO_ISA desconocido: %s; se ignora.\n", pedido);
+    return limite;
+}
+
+/** \brief Indica si la CPU soporta el nivel (y DESPACHO_ISA lo permite) */
+static inline int despacho_soporta(despacho_isa_t isa) {
+    if (despacho_rango[isa] > despacho_limite()) {
+        return 0;
+    }
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    switch (isa) {
+        case DESPACHO_BASE:
+            return 1;
+        case DESPACHO_X86_64_V3:
+            return __builtin_cpu_supports("x86-64-v3");
+        case DESPACHO_X86_64_V4:
+            return __builtin_cpu_supports("x86-64-v4");
+        case DESPACHO_AVX512FP16:
+            return __builtin_cpu_supports("x86-64-v4") && __builtin_cpu_supports("avx512fp16");
+        case DESPACHO_AVX512BF16:
+            return __builtin_cpu_supports("x86-64-v4") && __builtin_cpu_supports("avx512bf16");
+        default:
+            return 0;
+    }
+#else
+    return isa == DESPACHO_BASE;
+#endif
+}
+
+/** \brief Cuerpo de un kernel: se incluye entero en cada variante */
+#define DESPACHO_CUERPO static inline __attribute__((always_inline))
+
+#ifdef __x86_64__
+
+/** \brief Variante nombre_sufijo de un kernel void, compilada con el target indicado */
+#define DESPACHO_VARIANTE(nombre, sufijo, objetivo, parametros, argumentos) \
+    __attribute__((target(objetivo))) void nombre##_##sufijo parametros { nombre##_cuerpo argumentos; }
+
+#else
+
+#define DESPACHO_VARIANTE(nombre, sufijo, objetivo, parametros, argumentos)
+
+#endif /* __x86_64__ */
+
+/** \brief Variantes base, x86_64_v3 y x86_64_v4 de un kernel void */
+#define DESPACHO_VARIANTES(nombre, parametros, argumentos) \
+    void nombre##_base parametros { nombre##_cuerpo argumentos; } \
+    DESPACHO_VARIANTE(nombre, x86_64_v3, "arch=x86-64-v3", parametros, argumentos) \
+    DESPACHO_VARIANTE(nombre, x86_64_v4, "arch=x86-64-v4", parametros, argumentos)
+
+/**
+ * \brief Dentro de la función de selección: usa la variante si la CPU soporta su nivel.
+ *
+ * Espera las variables nombre_kernel (puntero a la función) y nombre_kernel_nombre, y termina
+ * la función de selección en cuanto encuentra una variante válida, por lo que se prueban de
+ * mayor a menor nivel.
+ */
+#ifdef __x86_64__
+#define DESPACHO_PROBAR(nombre, sufijo, isa) \
+    if (despacho_soporta(isa)) { \
+        nombre##_kernel = nombre##_##sufijo; \
+        nombre##_kernel_nombre = despacho_nombre(isa); \
+        return; \
+    }
+#else
+#define DESPACHO_PROBAR(nombre, sufijo, isa)
+#endif
+
+#endif /* DESPACHO_H */
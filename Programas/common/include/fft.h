@@ -0,0 +1,896 @@
+/*
+ * Utilidades comunes a los benchmarks: FFT compleja de radix mixto (Stockham) con Bluestein,
+ * DCT-II y DCT-III rápidas por el método de Makhoul y caché de las tablas de cosenos y twiddles.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "despacho.h"
+
+/*
+    dct() en Programas/DCT es la suma directa, O(n^2): el barrido se tuvo que limitar a
+    n = 1742848 (Bibliografia/Problemas-encontrados.md, punto 5). Con --method fft los programas
+    calculan la misma DCT-II ortonormal en O(n log n) (Makhoul, "A fast cosine transform in one
+    and two dimensions", IEEE TASSP 1980):
+
+        v[i] = x[2i], v[n-1-i] = x[2i+1]            (reordenación)
+        V = FFT(v)                                   (FFT real de longitud n)
+        X[k] = alpha_k Re(exp(-i pi k / 2n) V[k])
+
+    Con n par, la FFT real se hace como una compleja de n/2 (z[j] = v[2j] + i v[2j+1]) y se
+    separa el espectro; con n impar, como una compleja de n con parte imaginaria nula.
+
+    La inversa (DCT-III ortonormal, fft_idct) deshace los mismos pasos con el mismo plan y las
+    mismas tablas: V[k] = exp(i pi k / 2n) (X[k] - i X[n-k]) con X[n] = 0, v = IFFT(V) y se
+    deshace la reordenación. La IFFT es conj(FFT(conj(.))), así que usa la FFT directa del plan;
+    con n par se junta el espectro en el de z (Z[k] = E[k] + i O[k], con E y O las mitades par e
+    impar de V) y se hace la compleja de n/2.
+
+    La FFT compleja es un Stockham de radix mixto (4, 2, 3 y cualquier primo hasta FFT_RADIX_MAX):
+    no necesita reordenar por inversión de bits y el bucle interno de cada etapa recorre
+    posiciones contiguas con los mismos twiddles, así que se vectoriza. Los tamaños con un
+    factor primo mayor (los del barrido pueden tenerlo) se resuelven con Bluestein, como una
+    convolución circular de longitud potencia de 2.
+
+    Antes de incluir este fichero el programa define FFT_TIPO, el tipo en el que se almacenan
+    los datos y se hacen las operaciones (float, _Float16, __fp16 o __bf16), igual que la suma
+    directa de cada programa opera en su tipo. El plan se crea una vez por tamaño, fuera de la
+    medida, y no es reentrante (incluye los buffers de trabajo).
+
+    Los datos se escalan por sqrt(2/n) al entrar en la FFT, no al final: así los valores
+    intermedios se mantienen del orden de la salida y no desbordan FP16 (65504) con n grandes.
+
+    Tablas: los twiddles, el chirp y el filtro de Bluestein, las rotaciones de Makhoul y los
+    cosenos de la suma directa se calculan en double y se guardan en FFT_TIPO, de modo que con
+    FP16/BF16 ocupan la mitad que con float. Las de cada tamaño se calculan una sola vez y quedan
+    en una caché del proceso compartida por los planes: crear de nuevo el plan de un tamaño ya
+    visto (otra llamada, otro punto del barrido, otra instancia del bench) no hace ninguna
+    operación trigonométrica. Las tablas que no usa ningún plan se conservan mientras la caché no
+    pase de FFT_CACHE_MAX_BYTES; por encima se descartan las usadas hace más tiempo. La caché
+    tampoco es reentrante: los planes se crean y se liberan fuera de las medidas (en el bench,
+    bajo su mutex).
+
+    La suma directa usa la tabla cos(pi j / 2n): el ángulo pi k (2i + 1) / 2n es el índice
+    j = k (2i + 1) mod 4n, que avanza 2k por elemento. Como cos(pi (4n - j) / 2n) = cos(pi j / 2n),
+    basta con guardar j <= 2n (2n + 1 valores), y el seno es el coseno de n - j (dct_seno).
+
+    Suma directa por carriles (DCT_CARRILES valores de k a la vez): la recurrencia de rotaciones
+    de cada k es serie, pero las de k distintas son independientes, así que cada carril de un
+    vector lleva su propio cos/sin y todos avanzan juntos con operaciones vectoriales, sin
+    gathers. Para que el error de la recurrencia no crezca con n, cada DCT_TRAMO elementos se
+    vuelven a tomar cos y sin de la tabla. La suma de cada tramo y la total se acumulan en float
+    y solo la salida se redondea al tipo: una suma en FP16 se satura con n de unos miles, y así
+    la suma directa sigue sirviendo de referencia O(n^2) con n grandes en FP16/BF16. Los bloques
+    de k se reparten entre los hilos.
+*/
+
+#ifndef FFT_TIPO
+#define FFT_TIPO float
+#endif
+
+typedef FFT_TIPO fft_real_t;
+
+/** \brief Mayor radix de una etapa; los tamaños con un factor primo mayor usan Bluestein */
+#define FFT_RADIX_MAX 64
+
+/** \brief Máximo de etapas (factores) de una FFT */
+#define FFT_MAX_FACTORES 64
+
+/** \brief Valores de k que la suma directa evalúa a la vez, uno por carril (estado en float) */
+#define DCT_CARRILES 32
+
+/**
+ * \brief Elementos entre dos lecturas de cos/sin de la tabla en la suma directa por carriles.
+ *
+ * La rotación de cada carril sale de la tabla, redondeada a FFT_TIPO, y su error crece con el
+ * tramo: con tablas de 16 bits el tramo es más corto (error de ~1e-3 en FP16 frente a ~4e-3 con 64).
+ */
+#define DCT_TRAMO (sizeof(fft_real_t) == sizeof(float) ? 64 : 16)
+
+/** \brief Tamaño de la caché de tablas a partir del cual se descartan las que no usa ningún plan */
+#define FFT_CACHE_MAX_BYTES ((size_t)256 << 20)
+
+/** \brief Código que devuelve getopt_long para --method (fuera del rango de las opciones cortas) */
+#define OPCION_METODO 0x10A
+
+/** \brief Código que devuelve getopt_long para --roundtrip (DCT, cuantización y DCT inversa) */
+#define OPCION_IDA_VUELTA 0x10D
+
+typedef enum {
+    DCT_DIRECTA = 0,
+    DCT_FFT,
+    DCT_NUM_METODOS
+} dct_metodo_t;
+
+static const char *const dct_metodo_nombres[DCT_NUM_METODOS] = {"direct", "fft"};
+
+/**
+ * \brief Interpreta el argumento de --method.
+ *
+ * \return int 0 si es un método conocido (direct o fft), -1 en caso contrario.
+ */
+static inline int dct_metodo_leer(const char *texto, dct_metodo_t *metodo) {
+    for (int i = 0; i < DCT_NUM_METODOS; i++) {
+        if (strcmp(texto, dct_metodo_nombres[i]) == 0) {
+            *metodo = (dct_metodo_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+typedef enum {
+    FFT_TABLA_TWIDDLES = 0,             // exp(-2 pi i j / n), j < n
+    FFT_TABLA_BLUESTEIN,                // chirp exp(-pi i j^2 / n), j < n, y filtro (m valores)
+    FFT_TABLA_MAKHOUL,                  // cos/sin(pi k / 2n), k < n, y exp(-2 pi i k / n), k <= n/2
+    FFT_TABLA_DIRECTA,                  // cos(pi j / 2n), j <= 2n
+    FFT_NUM_TABLAS
+} fft_clase_tabla_t;
+
+static const char *const fft_tabla_nombres[FFT_NUM_TABLAS] = {"twiddles", "bluestein", "makhoul", "directa"};
+
+// Tablas de una clase y un tamaño, de solo lectura y compartidas por todos los planes que las usan
+typedef struct fft_tabla {
+    fft_clase_tabla_t clase;
+    int64_t n;
+    fft_real_t *v[4];
+    size_t bytes;
+    int usos;                           // planes que la usan (0: se puede descartar)
+    struct fft_tabla *siguiente;        // la caché empieza por la usada más recientemente
+} fft_tabla_t;
+
+static fft_tabla_t *fft_cache = NULL;
+static size_t fft_cache_bytes = 0;
+static int64_t fft_cache_calculadas = 0;   // tablas calculadas desde el inicio (fallos de la caché)
+
+typedef struct fft_plan {
+    int64_t n;
+    int num_factores;                   // 0 con Bluestein
+    int factores[FFT_MAX_FACTORES];
+    fft_tabla_t *tablas;
+    const fft_real_t *tw_re, *tw_im;    // exp(-2 pi i j / n), j < n
+    // Bluestein: convolución de longitud m (potencia de 2 >= 2n - 1) con el plan sub
+    int64_t m;
+    struct fft_plan *sub;
+    const fft_real_t *chirp_re, *chirp_im;      // exp(-pi i j^2 / n), j < n
+    const fft_real_t *filtro_re, *filtro_im;    // FFT del chirp conjugado, dividida entre m
+    // Buffers de trabajo (Stockham alterna entre a y b); la entrada se escribe en a
+    fft_real_t *a_re, *a_im, *b_re, *b_im;
+} fft_plan_t;
+
+typedef struct {
+    int64_t n;
+    fft_plan_t *fft;                    // longitud n/2 con n par y n con n impar
+    fft_tabla_t *tablas;
+    const fft_real_t *coseno, *seno;    // cos(pi k / 2n) y sin(pi k / 2n), k < n
+    const fft_real_t *mitad_re, *mitad_im;  // exp(-2 pi i k / n), k <= n/2 (n par)
+} fft_dct_plan_t;
+
+static inline void *fft_reservar(size_t bytes) {
+    void *p = NULL;
+    if (posix_memalign(&p, 64, bytes > 0 ? bytes : 1) != 0) {
+        return NULL;
+    }
+    return p;
+}
+
+// Longitud de la convolución de Bluestein: potencia de 2 >= 2n - 1
+static inline int64_t fft_bluestein_m(int64_t n) {
+    int64_t m = 1;
+    while (m < 2 * n - 1) {
+        m *= 2;
+    }
+    return m;
+}
+
+/**
+ * \brief Descompone n en las radix de las etapas: primero los primos de mayor a menor y al
+ * final los 4, para que las radix genéricas (las más caras) trabajen con bucles internos largos.
+ *
+ * \return int Número de factores, o -1 si n tiene un factor primo mayor que FFT_RADIX_MAX.
+ */
+static inline int fft_factorizar(int64_t n, int *factores) {
+    int num = 0, cuatros = 0;
+
+    while (n % 4 == 0) {
+        cuatros++;
+        n /= 4;
+    }
+    for (int p = FFT_RADIX_MAX; p >= 2; p--) {
+        int primo = 1;
+        for (int d = 2; d * d <= p; d++) {
+            primo = primo && (p % d != 0);
+        }
+        while (primo && n % p == 0) {
+            factores[num++] = p;
+            n /= p;
+        }
+    }
+    while (cuatros-- > 0) {
+        factores[num++] = 4;
+    }
+    return n == 1 ? num : -1;
+}
+
+// FFT en double de longitud potencia de 2 (in situ, radix 2), solo para calcular el filtro de Bluestein
+static inline void fft_doble(double *re, double *im, int64_t m) {
+    for (int64_t i = 1, j = 0; i < m; i++) {
+        int64_t bit = m >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for (int64_t longitud = 2; longitud <= m; longitud <<= 1) {
+        double angulo = -2.0 * M_PI / (double)longitud;
+        for (int64_t inicio = 0; inicio < m; inicio += longitud) {
+            for (int64_t j = 0; j < longitud / 2; j++) {
+                double wr = cos(angulo * j), wi = sin(angulo * j);
+                int64_t u = inicio + j, v = inicio + j + longitud / 2;
+                double tr = re[v] * wr - im[v] * wi;
+                double ti = re[v] * wi + im[v] * wr;
+                re[v] = re[u] - tr;
+                im[v] = im[u] - ti;
+                re[u] += tr;
+                im[u] += ti;
+            }
+        }
+    }
+}
+
+static inline void fft_tabla_destruir(fft_tabla_t *tabla) {
+    for (int i = 0; i < 4; i++) {
+        free(tabla->v[i]);
+    }
+    free(tabla);
+}
+
+/**
+ * \brief Calcula en double las tablas de una clase y un tamaño y las guarda en fft_real_t.
+ *
+ * \return fft_tabla_t* Tablas (con usos = 0), o NULL si falla la reserva de memoria.
+ */
+static inline fft_tabla_t *fft_tabla_calcular(fft_clase_tabla_t clase, int64_t n) {
+    int64_t longitudes[4] = {0, 0, 0, 0};
+    int64_t m = 0;
+
+    switch (clase) {
+        case FFT_TABLA_TWIDDLES:
+            longitudes[0] = longitudes[1] = n;
+            break;
+        case FFT_TABLA_BLUESTEIN:
+            m = fft_bluestein_m(n);
+            longitudes[0] = longitudes[1] = n;
+            longitudes[2] = longitudes[3] = m;
+            break;
+        case FFT_TABLA_MAKHOUL:
+            longitudes[0] = longitudes[1] = n;
+            longitudes[2] = longitudes[3] = (n % 2 == 0) ? n / 2 + 1 : 0;
+            break;
+        default:
+            longitudes[0] = 2 * n + 1;
+            break;
+    }
+
+    fft_tabla_t *tabla = (fft_tabla_t *)calloc(1, sizeof(fft_tabla_t));
+    if (tabla == NULL) {
+        return NULL;
+    }
+    tabla->clase = clase;
+    tabla->n = n;
+    for (int i = 0; i < 4; i++) {
+        if (longitudes[i] == 0) {
+            continue;
+        }
+        tabla->v[i] = (fft_real_t *)fft_reservar(longitudes[i] * sizeof(fft_real_t));
+        if (tabla->v[i] == NULL) {
+            fft_tabla_destruir(tabla);
+            return NULL;
+        }
+        tabla->bytes += longitudes[i] * sizeof(fft_real_t);
+    }
+
+    if (clase == FFT_TABLA_TWIDDLES) {
+        for (int64_t j = 0; j < n; j++) {
+            double angulo = -2.0 * M_PI * (double)j / (double)n;
+            tabla->v[0][j] = (fft_real_t)cos(angulo);
+            tabla->v[1][j] = (fft_real_t)sin(angulo);
+        }
+    } else if (clase == FFT_TABLA_BLUESTEIN) {
+        // X[k] = c[k] sum_j (x[j] c[j]) conj(c[k - j]), con c[j] = exp(-pi i j^2 / n)
+        double *h_re = (double *)calloc(m, sizeof(double));
+        double *h_im = (double *)calloc(m, sizeof(double));
+        if (h_re == NULL || h_im == NULL) {
+            free(h_re);
+            free(h_im);
+            fft_tabla_destruir(tabla);
+            return NULL;
+        }
+        for (int64_t j = 0; j < n; j++) {
+            // j^2 módulo 2n para no perder precisión en el ángulo con j grandes
+            double angulo = -M_PI * (double)((j * j) % (2 * n)) / (double)n;
+            tabla->v[0][j] = (fft_real_t)cos(angulo);
+            tabla->v[1][j] = (fft_real_t)sin(angulo);
+            h_re[j] = cos(angulo);
+            h_im[j] = -sin(angulo);
+            if (j > 0) {
+                h_re[m - j] = h_re[j];
+                h_im[m - j] = h_im[j];
+            }
+        }
+        fft_doble(h_re, h_im, m);
+        for (int64_t k = 0; k < m; k++) {
+            tabla->v[2][k] = (fft_real_t)(h_re[k] / (double)m);
+            tabla->v[3][k] = (fft_real_t)(h_im[k] / (double)m);
+        }
+        free(h_re);
+        free(h_im);
+    } else if (clase == FFT_TABLA_MAKHOUL) {
+        for (int64_t k = 0; k < n; k++) {
+            double angulo = M_PI * (double)k / (2.0 * (double)n);
+            tabla->v[0][k] = (fft_real_t)cos(angulo);
+            tabla->v[1][k] = (fft_real_t)sin(angulo);
+        }
+        for (int64_t k = 0; k < longitudes[2]; k++) {
+            double angulo = -2.0 * M_PI * (double)k / (double)n;
+            tabla->v[2][k] = (fft_real_t)cos(angulo);
+            tabla->v[3][k] = (fft_real_t)sin(angulo);
+        }
+    } else {
+        for (int64_t j = 0; j <= 2 * n; j++) {
+            tabla->v[0][j] = (fft_real_t)cos(M_PI * (double)j / (2.0 * (double)n));
+        }
+    }
+    return tabla;
+}
+
+// Descarta las tablas sin planes, de la usada hace más tiempo a la más reciente, hasta que la caché quepa en FFT_CACHE_MAX_BYTES
+static inline void fft_cache_recortar(void) {
+    while (fft_cache_bytes > FFT_CACHE_MAX_BYTES) {
+        fft_tabla_t **enlace = NULL;
+        for (fft_tabla_t **p = &fft_cache; *p != NULL; p = &(*p)->siguiente) {
+            if ((*p)->usos == 0) {
+                enlace = p;
+            }
+        }
+        if (enlace == NULL) {
+            return;
+        }
+        fft_tabla_t *tabla = *enlace;
+        *enlace = tabla->siguiente;
+        fft_cache_bytes -= tabla->bytes;
+        fft_tabla_destruir(tabla);
+    }
+}
+
+/**
+ * \brief Devuelve las tablas de una clase y un tamaño desde la caché, calculándolas si no están.
+ *
+ * Cada llamada cuenta como un uso que se devuelve con fft_tabla_soltar.
+ *
+ * \return fft_tabla_t* Tablas, o NULL si falla la reserva de memoria.
+ */
+static inline fft_tabla_t *fft_tabla_obtener(fft_clase_tabla_t clase, int64_t n) {
+    fft_tabla_t *tabla = NULL;
+
+    for (fft_tabla_t **p = &fft_cache; *p != NULL; p = &(*p)->siguiente) {
+        if ((*p)->clase == clase && (*p)->n == n) {
+            tabla = *p;
+            *p = tabla->siguiente;
+            break;
+        }
+    }
+    if (tabla == NULL) {
+        tabla = fft_tabla_calcular(clase, n);
+        if (tabla == NULL) {
+            return NULL;
+        }
+        fft_cache_bytes += tabla->bytes;
+        fft_cache_calculadas++;
+    }
+
+    // Al principio de la lista: la más reciente
+    tabla->siguiente = fft_cache;
+    fft_cache = tabla;
+    tabla->usos++;
+    fft_cache_recortar();
+    return tabla;
+}
+
+static inline void fft_tabla_soltar(fft_tabla_t *tabla) {
+    if (tabla == NULL) {
+        return;
+    }
+    tabla->usos--;
+    fft_cache_recortar();
+}
+
+// Libera las tablas que no usa ningún plan (al final del programa)
+static inline void fft_cache_vaciar(void) {
+    fft_tabla_t **p = &fft_cache;
+    while (*p != NULL) {
+        fft_tabla_t *tabla = *p;
+        if (tabla->usos == 0) {
+            *p = tabla->siguiente;
+            fft_cache_bytes -= tabla->bytes;
+            fft_tabla_destruir(tabla);
+        } else {
+            p = &tabla->siguiente;
+        }
+    }
+}
+
+/** \brief Imprime el tamaño de la caché de tablas y cuántas se han calculado */
+static inline void fft_cache_imprimir(void) {
+    int tablas = 0;
+    for (fft_tabla_t *t = fft_cache; t != NULL; t = t->siguiente) {
+        tablas++;
+    }
+    printf("Cache de tablas: %d tablas, %zu bytes (%zu por valor), %lld calculadas\n", tablas,
+           fft_cache_bytes, sizeof(fft_real_t), (long long)fft_cache_calculadas);
+}
+
+static inline void fft_plan_liberar(fft_plan_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    fft_plan_liberar(plan->sub);
+    fft_tabla_soltar(plan->tablas);
+    free(plan->a_re);
+    free(plan->a_im);
+    free(plan->b_re);
+    free(plan->b_im);
+    free(plan);
+}
+
+/**
+ * \brief Crea el plan de una FFT compleja de longitud n: factores, twiddles y buffers.
+ *
+ * \return fft_plan_t* Plan, o NULL si falla la reserva de memoria.
+ */
+static inline fft_plan_t *fft_plan_crear(int64_t n) {
+    fft_plan_t *plan = (fft_plan_t *)calloc(1, sizeof(fft_plan_t));
+    if (plan == NULL) {
+        return NULL;
+    }
+    plan->n = n;
+    plan->a_re = (fft_real_t *)fft_reservar(n * sizeof(fft_real_t));
+    plan->a_im = (fft_real_t *)fft_reservar(n * sizeof(fft_real_t));
+    plan->b_re = (fft_real_t *)fft_reservar(n * sizeof(fft_real_t));
+    plan->b_im = (fft_real_t *)fft_reservar(n * sizeof(fft_real_t));
+    if (plan->a_re == NULL || plan->a_im == NULL || plan->b_re == NULL || plan->b_im == NULL) {
+        fft_plan_liberar(plan);
+        return NULL;
+    }
+
+    plan->num_factores = fft_factorizar(n, plan->factores);
+    if (plan->num_factores >= 0) {
+        plan->tablas = fft_tabla_obtener(FFT_TABLA_TWIDDLES, n);
+        if (plan->tablas == NULL) {
+            fft_plan_liberar(plan);
+            return NULL;
+        }
+        plan->tw_re = plan->tablas->v[0];
+        plan->tw_im = plan->tablas->v[1];
+        return plan;
+    }
+
+    // Bluestein: convolución circular de longitud m con la FFT de m (ver fft_tabla_calcular)
+    plan->num_factores = 0;
+    plan->m = fft_bluestein_m(n);
+    plan->sub = fft_plan_crear(plan->m);
+    plan->tablas = fft_tabla_obtener(FFT_TABLA_BLUESTEIN, n);
+    if (plan->sub == NULL || plan->tablas == NULL) {
+        fft_plan_liberar(plan);
+        return NULL;
+    }
+    plan->chirp_re = plan->tablas->v[0];
+    plan->chirp_im = plan->tablas->v[1];
+    plan->filtro_re = plan->tablas->v[2];
+    plan->filtro_im = plan->tablas->v[3];
+    return plan;
+}
+
+// Bytes de las tablas que usa el plan (incluido el de Bluestein)
+static inline size_t fft_plan_bytes_tablas(const fft_plan_t *plan) {
+    return plan == NULL ? 0 : plan->tablas->bytes + fft_plan_bytes_tablas(plan->sub);
+}
+
+/*
+    Etapa de radix p del Stockham: tras ella se tienen las DFT de longitud L*p de las r = n/(L*p)
+    subsecuencias x[c + r i]. La entrada guarda el elemento k de la DFT de la subsecuencia c en
+    k * (r p) + c y la salida en k * r + c, con c contiguo:
+
+        Y'[c][k + L s] = sum_q W_p^(q s) W_(L p)^(q k) Y[c + r q][k]
+*/
+DESPACHO_CUERPO void fft_etapa(const fft_plan_t *plan, int p, int64_t L, fft_real_t *restrict xr, fft_real_t *restrict xi,
+                               fft_real_t *restrict yr, fft_real_t *restrict yi) {
+    const int64_t n = plan->n;
+    const int64_t r = n / (L * p);
+    const int64_t salto = L * r;  // distancia entre las salidas s y s + 1
+    fft_real_t raiz_re[FFT_RADIX_MAX], raiz_im[FFT_RADIX_MAX];
+
+    // Raíces W_p^j para la radix genérica
+    for (int j = 0; j < p; j++) {
+        raiz_re[j] = plan->tw_re[j * (n / p)];
+        raiz_im[j] = plan->tw_im[j * (n / p)];
+    }
+
+    for (int64_t k = 0; k < L; k++) {
+        fft_real_t wr[FFT_RADIX_MAX], wi[FFT_RADIX_MAX];
+        for (int q = 0; q < p; q++) {
+            wr[q] = plan->tw_re[q * k * r];
+            wi[q] = plan->tw_im[q * k * r];
+        }
+        fft_real_t *restrict er = xr + k * r * p;
+        fft_real_t *restrict ei = xi + k * r * p;
+        fft_real_t *restrict sr = yr + k * r;
+        fft_real_t *restrict si = yi + k * r;
+
+        if (p == 2) {
+            for (int64_t c = 0; c < r; c++) {
+                fft_real_t t1r = er[r + c] * wr[1] - ei[r + c] * wi[1];
+                fft_real_t t1i = er[r + c] * wi[1] + ei[r + c] * wr[1];
+                sr[c] = er[c] + t1r;
+                si[c] = ei[c] + t1i;
+                sr[salto + c] = er[c] - t1r;
+                si[salto + c] = ei[c] - t1i;
+            }
+        } else if (p == 3) {
+            const fft_real_t medio = (fft_real_t)0.5f;
+            const fft_real_t s3 = (fft_real_t)0.86602540378f;  // sin(2 pi / 3)
+            for (int64_t c = 0; c < r; c++) {
+                fft_real_t t1r = er[r + c] * wr[1] - ei[r + c] * wi[1];
+                fft_real_t t1i = er[r + c] * wi[1] + ei[r + c] * wr[1];
+                fft_real_t t2r = er[2 * r + c] * wr[2] - ei[2 * r + c] * wi[2];
+                fft_real_t t2i = er[2 * r + c] * wi[2] + ei[2 * r + c] * wr[2];
+                fft_real_t sumr = t1r + t2r, sumi = t1i + t2i;
+                fft_real_t difr = t1r - t2r, difi = t1i - t2i;
+                fft_real_t mr = er[c] - medio * sumr, mi = ei[c] - medio * sumi;
+                sr[c] = er[c] + sumr;
+                si[c] = ei[c] + sumi;
+                sr[salto + c] = mr + s3 * difi;
+                si[salto + c] = mi - s3 * difr;
+                sr[2 * salto + c] = mr - s3 * difi;
+                si[2 * salto + c] = mi + s3 * difr;
+            }
+        } else if (p == 4) {
+            for (int64_t c = 0; c < r; c++) {
+                fft_real_t t1r = er[r + c] * wr[1] - ei[r + c] * wi[1];
+                fft_real_t t1i = er[r + c] * wi[1] + ei[r + c] * wr[1];
+                fft_real_t t2r = er[2 * r + c] * wr[2] - ei[2 * r + c] * wi[2];
+                fft_real_t t2i = er[2 * r + c] * wi[2] + ei[2 * r + c] * wr[2];
+                fft_real_t t3r = er[3 * r + c] * wr[3] - ei[3 * r + c] * wi[3];
+                fft_real_t t3i = er[3 * r + c] * wi[3] + ei[3 * r + c] * wr[3];
+                fft_real_t a0r = er[c] + t2r, a0i = ei[c] + t2i;
+                fft_real_t a1r = er[c] - t2r, a1i = ei[c] - t2i;
+                fft_real_t a2r = t1r + t3r, a2i = t1i + t3i;
+                fft_real_t a3r = t1r - t3r, a3i = t1i - t3i;
+                sr[c] = a0r + a2r;
+                si[c] = a0i + a2i;
+                sr[salto + c] = a1r + a3i;      // a1 - i a3
+                si[salto + c] = a1i - a3r;
+                sr[2 * salto + c] = a0r - a2r;
+                si[2 * salto + c] = a0i - a2i;
+                sr[3 * salto + c] = a1r - a3i;  // a1 + i a3
+                si[3 * salto + c] = a1i + a3r;
+            }
+        } else {
+            // Radix prima genérica: DFT directa de p puntos, O(p^2). Los twiddles se aplican sobre
+            // la propia entrada (solo esta k la lee) y cada par (s, q) es un bucle vectorizable en c
+            for (int q = 1; q < p; q++) {
+                for (int64_t c = 0; c < r; c++) {
+                    fft_real_t tr = er[q * r + c] * wr[q] - ei[q * r + c] * wi[q];
+                    fft_real_t ti = er[q * r + c] * wi[q] + ei[q * r + c] * wr[q];
+                    er[q * r + c] = tr;
+                    ei[q * r + c] = ti;
+                }
+            }
+            for (int s = 0; s < p; s++) {
+                fft_real_t *restrict ur = sr + s * salto;
+                fft_real_t *restrict ui = si + s * salto;
+                for (int64_t c = 0; c < r; c++) {
+                    ur[c] = er[c];
+                    ui[c] = ei[c];
+                }
+                for (int q = 1, j = s; q < p; q++, j = (j + s) % p) {
+                    fft_real_t rr = raiz_re[j], ri = raiz_im[j];
+                    for (int64_t c = 0; c < r; c++) {
+                        ur[c] += er[q * r + c] * rr - ei[q * r + c] * ri;
+                        ui[c] += er[q * r + c] * ri + ei[q * r + c] * rr;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// FFT de radix mixto de los datos de plan->a; deja en re/im el buffer con el resultado
+DESPACHO_CUERPO void fft_stockham(const fft_plan_t *plan, fft_real_t **re, fft_real_t **im) {
+    fft_real_t *xr = plan->a_re, *xi = plan->a_im;
+    fft_real_t *yr = plan->b_re, *yi = plan->b_im;
+    int64_t L = 1;
+
+    for (int t = 0; t < plan->num_factores; t++) {
+        fft_etapa(plan, plan->factores[t], L, xr, xi, yr, yi);
+        L *= plan->factores[t];
+        fft_real_t *tmp = xr; xr = yr; yr = tmp;
+        tmp = xi; xi = yi; yi = tmp;
+    }
+    *re = xr;
+    *im = xi;
+}
+
+/**
+ * \brief FFT compleja directa de los n datos de plan->a_re/a_im.
+ *
+ * \param[out] re, im Buffers del plan con el resultado (a o b).
+ */
+DESPACHO_CUERPO void fft_ejecutar(const fft_plan_t *plan, fft_real_t **re, fft_real_t **im) {
+    if (plan->sub == NULL) {
+        fft_stockham(plan, re, im);
+        return;
+    }
+
+    const fft_plan_t *sub = plan->sub;
+    const int64_t n = plan->n, m = plan->m;
+    fft_real_t *ur, *ui;
+
+    for (int64_t j = 0; j < n; j++) {
+        fft_real_t cr = plan->chirp_re[j], ci = plan->chirp_im[j];
+        sub->a_re[j] = plan->a_re[j] * cr - plan->a_im[j] * ci;
+        sub->a_im[j] = plan->a_re[j] * ci + plan->a_im[j] * cr;
+    }
+    for (int64_t j = n; j < m; j++) {
+        sub->a_re[j] = (fft_real_t)0.0f;
+        sub->a_im[j] = (fft_real_t)0.0f;
+    }
+    fft_stockham(sub, &ur, &ui);
+
+    // Producto por el filtro y conjugado: la FFT inversa es conj(FFT(conj(.))) / m (1/m va en el filtro)
+    for (int64_t k = 0; k < m; k++) {
+        fft_real_t fr = plan->filtro_re[k], fi = plan->filtro_im[k];
+        fft_real_t pr = ur[k] * fr - ui[k] * fi;
+        fft_real_t pi = ur[k] * fi + ui[k] * fr;
+        sub->a_re[k] = pr;
+        sub->a_im[k] = -pi;
+    }
+    fft_stockham(sub, &ur, &ui);
+
+    for (int64_t k = 0; k < n; k++) {
+        fft_real_t cr = plan->chirp_re[k], ci = plan->chirp_im[k];
+        plan->b_re[k] = ur[k] * cr + ui[k] * ci;    // c[k] * conj(u[k])
+        plan->b_im[k] = ur[k] * ci - ui[k] * cr;
+    }
+    *re = plan->b_re;
+    *im = plan->b_im;
+}
+
+static inline void fft_dct_plan_liberar(fft_dct_plan_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    fft_plan_liberar(plan->fft);
+    fft_tabla_soltar(plan->tablas);
+    free(plan);
+}
+
+/**
+ * \brief Crea el plan de la DCT-II rápida de longitud n (FFT, rotaciones y twiddles de la separación).
+ *
+ * \return fft_dct_plan_t* Plan, o NULL si falla la reserva de memoria.
+ */
+static inline fft_dct_plan_t *fft_dct_plan_crear(int64_t n) {
+    fft_dct_plan_t *plan = (fft_dct_plan_t *)calloc(1, sizeof(fft_dct_plan_t));
+    if (plan == NULL) {
+        return NULL;
+    }
+    plan->n = n;
+    plan->fft = fft_plan_crear(n % 2 == 0 ? n / 2 : n);
+    plan->tablas = fft_tabla_obtener(FFT_TABLA_MAKHOUL, n);
+    if (plan->fft == NULL || plan->tablas == NULL) {
+        fft_dct_plan_liberar(plan);
+        return NULL;
+    }
+    plan->coseno = plan->tablas->v[0];
+    plan->seno = plan->tablas->v[1];
+    plan->mitad_re = plan->tablas->v[2];
+    plan->mitad_im = plan->tablas->v[3];
+    return plan;
+}
+
+// Elemento i de la reordenación de Makhoul: pares en orden y después impares en orden inverso
+static inline int64_t fft_dct_indice(int64_t i, int64_t n) {
+    return i < (n + 1) / 2 ? 2 * i : 2 * (n - 1 - i) + 1;
+}
+
+/**
+ * \brief DCT-II ortonormal de input en output (mismo resultado que la suma directa de dct()).
+ */
+DESPACHO_CUERPO void fft_dct(const fft_dct_plan_t *plan, const fft_real_t *input, fft_real_t *output) {
+    const int64_t n = plan->n;
+    const fft_plan_t *fft = plan->fft;
+    const float escala = sqrtf(2.0f / (float)n);
+    fft_real_t *vr, *vi;
+
+    if (n % 2 != 0) {
+        for (int64_t i = 0; i < n; i++) {
+            fft->a_re[i] = (fft_real_t)((float)input[fft_dct_indice(i, n)] * escala);
+            fft->a_im[i] = (fft_real_t)0.0f;
+        }
+        fft_ejecutar(fft, &vr, &vi);
+        for (int64_t k = 0; k < n; k++) {
+            output[k] = plan->coseno[k] * vr[k] + plan->seno[k] * vi[k];
+        }
+    } else {
+        const int64_t h = n / 2;
+        const fft_real_t medio = (fft_real_t)0.5f;
+
+        for (int64_t j = 0; j < h; j++) {
+            fft->a_re[j] = (fft_real_t)((float)input[fft_dct_indice(2 * j, n)] * escala);
+            fft->a_im[j] = (fft_real_t)((float)input[fft_dct_indice(2 * j + 1, n)] * escala);
+        }
+        fft_ejecutar(fft, &vr, &vi);
+
+        // V[k] = (Z[k] + conj Z[h-k]) / 2 - i W_n^k (Z[k] - conj Z[h-k]) / 2, y V[n-k] = conj V[k]
+        for (int64_t k = 0; k <= h; k++) {
+            int64_t a = (k == h) ? 0 : k;
+            int64_t b = (k == 0) ? 0 : h - k;
+            fft_real_t zr = vr[a], zi = vi[a];
+            fft_real_t cr = vr[b], ci = -vi[b];
+            fft_real_t par_r = (zr + cr) * medio, par_i = (zi + ci) * medio;
+            fft_real_t impar_r = (zi - ci) * medio, impar_i = (cr - zr) * medio;
+            fft_real_t wr = plan->mitad_re[k], wi = plan->mitad_im[k];
+            fft_real_t v_re = par_r + wr * impar_r - wi * impar_i;
+            fft_real_t v_im = par_i + wr * impar_i + wi * impar_r;
+
+            output[k] = plan->coseno[k] * v_re + plan->seno[k] * v_im;
+            if (k > 0 && k < h) {
+                output[n - k] = plan->coseno[n - k] * v_re - plan->seno[n - k] * v_im;
+            }
+        }
+    }
+
+    // alpha_0 = sqrt(1/n) = sqrt(2/n) / sqrt(2)
+    output[0] = (fft_real_t)((float)output[0] * 0.70710678f);
+}
+
+// V[k] = exp(i pi k / 2n) (X[k] - i X[n-k]) de la inversa, con X[0] por sqrt(2) (alpha_0) y X[n] = 0
+DESPACHO_CUERPO void fft_idct_espectro(const fft_dct_plan_t *plan, const fft_real_t *input, int64_t k,
+                                       fft_real_t *re, fft_real_t *im) {
+    fft_real_t xk = (k == 0) ? (fft_real_t)((float)input[0] * 1.41421356f) : input[k];
+    fft_real_t xn = (k == 0) ? (fft_real_t)0.0f : input[plan->n - k];
+    *re = plan->coseno[k] * xk + plan->seno[k] * xn;
+    *im = plan->seno[k] * xk - plan->coseno[k] * xn;
+}
+
+/**
+ * \brief DCT-III ortonormal de input en output: la inversa de fft_dct con el mismo plan.
+ */
+DESPACHO_CUERPO void fft_idct(const fft_dct_plan_t *plan, const fft_real_t *input, fft_real_t *output) {
+    const int64_t n = plan->n;
+    const fft_plan_t *fft = plan->fft;
+    fft_real_t *vr, *vi;
+
+    if (n % 2 != 0) {
+        // v = IFFT(V) / sqrt(2n): la escala se aplica a la entrada, como en fft_dct
+        const float escala = sqrtf(0.5f / (float)n);
+        for (int64_t k = 0; k < n; k++) {
+            fft_real_t v_re, v_im;
+            fft_idct_espectro(plan, input, k, &v_re, &v_im);
+            fft->a_re[k] = (fft_real_t)((float)v_re * escala);
+            fft->a_im[k] = (fft_real_t)(-(float)v_im * escala);
+        }
+        fft_ejecutar(fft, &vr, &vi);
+        for (int64_t i = 0; i < n; i++) {
+            output[fft_dct_indice(i, n)] = vr[i];
+        }
+    } else {
+        // Z[k] = E[k] + i O[k], E[k] = (V[k] + V[k+h]) / 2, O[k] = conj(W_n^k) (V[k] - V[k+h]) / 2;
+        // z = IFFT(Z) sqrt(2/n) da v[2j] = Re z[j] y v[2j+1] = Im z[j]
+        const int64_t h = n / 2;
+        const float escala = 0.5f * sqrtf(2.0f / (float)n);
+
+        for (int64_t k = 0; k < h; k++) {
+            fft_real_t ar, ai, br, bi;
+            fft_idct_espectro(plan, input, k, &ar, &ai);
+            fft_idct_espectro(plan, input, k + h, &br, &bi);
+            fft_real_t er = ar + br, ei = ai + bi;
+            fft_real_t dr = ar - br, di = ai - bi;
+            fft_real_t wr = plan->mitad_re[k], wi = plan->mitad_im[k];
+            fft_real_t or_ = dr * wr + di * wi, oi = di * wr - dr * wi;
+
+            // Entrada conjugada para que la FFT directa calcule la inversa
+            fft->a_re[k] = (fft_real_t)((float)(er - oi) * escala);
+            fft->a_im[k] = (fft_real_t)(-(float)(ei + or_) * escala);
+        }
+        fft_ejecutar(fft, &vr, &vi);
+        for (int64_t j = 0; j < h; j++) {
+            output[fft_dct_indice(2 * j, n)] = vr[j];
+            output[fft_dct_indice(2 * j + 1, n)] = -vi[j];
+        }
+    }
+}
+
+/*
+    Plan de la DCT de los programas para cualquier método: la suma directa usa la tabla de
+    cosenos (FFT_TABLA_DIRECTA) y la rápida su plan de FFT. Las tablas vienen de la caché.
+*/
+typedef struct {
+    int64_t n;
+    dct_metodo_t metodo;
+    fft_tabla_t *directa;
+    const fft_real_t *coseno;           // suma directa: cos(pi j / 2n), j <= 2n
+    fft_dct_plan_t *fft;                // --method fft
+} dct_plan_t;
+
+static inline void dct_plan_liberar(dct_plan_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    fft_tabla_soltar(plan->directa);
+    fft_dct_plan_liberar(plan->fft);
+    free(plan);
+}
+
+/**
+ * \brief Crea el plan de la DCT de longitud n con el método indicado.
+ *
+ * \return dct_plan_t* Plan, o NULL si falla la reserva de memoria.
+ */
+static inline dct_plan_t *dct_plan_crear(int64_t n, dct_metodo_t metodo) {
+    dct_plan_t *plan = (dct_plan_t *)calloc(1, sizeof(dct_plan_t));
+    if (plan == NULL) {
+        return NULL;
+    }
+    plan->n = n;
+    plan->metodo = metodo;
+    if (metodo == DCT_FFT) {
+        plan->fft = fft_dct_plan_crear(n);
+    } else if ((plan->directa = fft_tabla_obtener(FFT_TABLA_DIRECTA, n)) != NULL) {
+        plan->coseno = plan->directa->v[0];
+    }
+    if (plan->fft == NULL && plan->coseno == NULL) {
+        dct_plan_liberar(plan);
+        return NULL;
+    }
+    return plan;
+}
+
+/** \brief Bytes de las tablas que usa el plan (las comparte con los demás planes del mismo tamaño) */
+static inline size_t dct_plan_bytes_tablas(const dct_plan_t *plan) {
+    if (plan->fft != NULL) {
+        return plan->fft->tablas->bytes + fft_plan_bytes_tablas(plan->fft->fft);
+    }
+    return plan->directa->bytes;
+}
+
+/** \brief cos(pi j / 2n) para 0 <= j < 4n a partir de la tabla de la suma directa */
+static inline float dct_coseno(const fft_real_t *coseno, int64_t j, int64_t n) {
+    return (float)coseno[j <= 2 * n ? j : 4 * n - j];
+}
+
+/** \brief sin(pi j / 2n) = cos(pi (n - j) / 2n) para 0 <= j < 4n */
+static inline float dct_seno(const fft_real_t *coseno, int64_t j, int64_t n) {
+    return dct_coseno(coseno, j <= n ? n - j : 5 * n - j, n);
+}
+
+/** \brief Imprime el tamaño de las tablas del plan */
+static inline void dct_plan_imprimir_tablas(const dct_plan_t *plan) {
+    printf("Tablas DCT: %zu bytes (%zu por valor)\n", dct_plan_bytes_tablas(plan), sizeof(fft_real_t));
+}
+
+#endif /* FFT_H */
@@ -0,0 +1,310 @@
+/*
+ * Utilidades comunes a los benchmarks: formatos de coma flotante de 8 bits (OCP FP8).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef FP8_H
+#define FP8_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+/*
+    Formatos OCP 8-bit Floating Point (OFP8):
+      - E4M3: 1 bit de signo, 4 de exponente (sesgo 7) y 3 de mantisa. Sin infinitos, máximo
+        finito 448 y un único NaN por signo (S.1111.111). Las conversiones saturan a ±448.
+      - E5M2: 1 bit de signo, 5 de exponente (sesgo 15) y 2 de mantisa. Sigue IEEE 754
+        (infinitos y NaN), equivale a los 8 bits altos de un binary16.
+    No hay tipo nativo en C, por lo que ambos se almacenan como uint8_t.
+*/
+typedef uint8_t fp8_e4m3_t;
+typedef uint8_t fp8_e5m2_t;
+
+/** \brief Código E4M3 de máximo valor finito (448) sin signo */
+#define FP8_E4M3_MAX_CODIGO 0x7E
+/** \brief Código E4M3 de NaN sin signo */
+#define FP8_E4M3_NAN        0x7F
+/** \brief Código E5M2 de infinito sin signo */
+#define FP8_E5M2_INF        0x7C
+/** \brief Código E5M2 de NaN silencioso sin signo */
+#define FP8_E5M2_NAN        0x7E
+
+/** \brief Tablas de decodificación de los 256 códigos a float (se rellenan con fp8_inicializar_tablas) */
+static float tabla_fp8_e4m3[256];
+static float tabla_fp8_e5m2[256];
+
+/**
+ * \brief Redondea al par más cercano el valor absoluto de un float a un formato de 8 bits.
+ *
+ * \param[in] abs Bits del float sin el signo.
+ * \param[in] bits_mantisa Bits de mantisa del formato destino.
+ * \param[in] sesgo Sesgo del exponente del formato destino.
+ * \return uint32_t Código sin signo redondeado (exponente y mantisa), sin saturar.
+ *
+ * Cubre normales y subnormales del formato destino. Los subnormales de float se
+ * redondean a 0 y los exponentes fuera de rango devuelven 0xFF para que quien
+ * llama sature o convierta a infinito.
+ */
+static inline uint32_t fp8_redondear_magnitud(uint32_t abs, int bits_mantisa, int sesgo) {
+    if ((abs >> 23) == 0) {
+        return 0;
+    }
+
+    int exponente = (int)(abs >> 23) - 127 + sesgo;
+    if (exponente > 30) {
+        return 0xFF;
+    }
+
+    uint32_t significando = (abs & 0x7FFFFFu) | 0x800000u;
+    int desplazamiento = 23 - bits_mantisa;
+    if (exponente < 1) {
+        // Subnormal en el formato destino: se desplaza también el bit implícito
+        desplazamiento += 1 - exponente;
+        if (desplazamiento > 25) {
+            return 0;
+        }
+    }
+
+    uint32_t codigo = significando >> desplazamiento;
+    uint32_t resto = significando & ((1u << desplazamiento) - 1);
+    uint32_t mitad = 1u << (desplazamiento - 1);
+
+    if (exponente >= 1) {
+        codigo = ((uint32_t)exponente << bits_mantisa) | (codigo & ((1u << bits_mantisa) - 1));
+    }
+    // El acarreo del redondeo pasa al exponente de forma natural
+    if (resto > mitad || (resto == mitad && (codigo & 1u))) {
+        codigo++;
+    }
+    return codigo;
+}
+
+/** \brief Convierte un float a E4M3 con redondeo al par más cercano y saturación a ±448 */
+static inline fp8_e4m3_t float_a_fp8_e4m3(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uint8_t signo = (uint8_t)((bits >> 24) & 0x80u);
+    uint32_t abs = bits & 0x7FFFFFFFu;
+
+    if (abs > 0x7F800000u) {
+        return signo | FP8_E4M3_NAN;
+    }
+    uint32_t codigo = fp8_redondear_magnitud(abs, 3, 7);
+    if (codigo > FP8_E4M3_MAX_CODIGO) {
+        codigo = FP8_E4M3_MAX_CODIGO;
+    }
+    return signo | (uint8_t)codigo;
+}
+
+/** \brief Convierte un float a E5M2 con redondeo al par más cercano (desborda a infinito) */
+static inline fp8_e5m2_t float_a_fp8_e5m2(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uint8_t signo = (uint8_t)((bits >> 24) & 0x80u);
+    uint32_t abs = bits & 0x7FFFFFFFu;
+
+    if (abs > 0x7F800000u) {
+        return signo | FP8_E5M2_NAN;
+    }
+    uint32_t codigo = fp8_redondear_magnitud(abs, 2, 15);
+    if (codigo > FP8_E5M2_INF) {
+        codigo = FP8_E5M2_INF;
+    }
+    return signo | (uint8_t)codigo;
+}
+
+/** \brief Decodifica un código E4M3 a float (sin tabla) */
+static inline float fp8_e4m3_decodificar(fp8_e4m3_t c) {
+    uint32_t signo = (uint32_t)(c & 0x80u) << 24;
+    uint32_t exponente = (c >> 3) & 0xFu;
+    uint32_t mantisa = c & 0x7u;
+    uint32_t bits;
+    float f;
+
+    if ((c & 0x7Fu) == FP8_E4M3_NAN) {
+        bits = signo | 0x7FC00000u;
+    } else if (exponente == 0) {
+        f = (float)mantisa * 0x1p-9f;
+        return signo ? -f : f;
+    } else {
+        bits = signo | ((exponente - 7 + 127) << 23) | (mantisa << 20);
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/** \brief Decodifica un código E5M2 a float (sin tabla) */
+static inline float fp8_e5m2_decodificar(fp8_e5m2_t c) {
+    uint32_t signo = (uint32_t)(c & 0x80u) << 24;
+    uint32_t exponente = (c >> 2) & 0x1Fu;
+    uint32_t mantisa = c & 0x3u;
+    uint32_t bits;
+    float f;
+
+    if (exponente == 0x1F) {
+        bits = signo | 0x7F800000u | (mantisa << 21);
+    } else if (exponente == 0) {
+        f = (float)mantisa * 0x1p-16f;
+        return signo ? -f : f;
+    } else {
+        bits = signo | ((exponente - 15 + 127) << 23) | (mantisa << 21);
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/** \brief Rellena las tablas de decodificación; debe llamarse antes de usar los kernels */
+static inline void fp8_inicializar_tablas(void) {
+    for (int c = 0; c < 256; c++) {
+        tabla_fp8_e4m3[c] = fp8_e4m3_decodificar((uint8_t)c);
+        tabla_fp8_e5m2[c] = fp8_e5m2_decodificar((uint8_t)c);
+    }
+}
+
+/** \brief Decodificación por tabla, empleada en los bucles escalares */
+static inline float fp8_e4m3_a_float(fp8_e4m3_t c) {
+    return tabla_fp8_e4m3[c];
+}
+
+static inline float fp8_e5m2_a_float(fp8_e5m2_t c) {
+    return tabla_fp8_e5m2[c];
+}
+
+#ifdef __x86_64__
+
+/*
+    Conversiones vectoriales de 8 elementos con AVX2 y F16C. Ambos formatos se llevan a binary16
+    con desplazamientos enteros y vcvtph2ps los ensancha a float:
+      - E5M2 son los 8 bits altos de un binary16, basta con desplazar 8 bits.
+      - E4M3 colocado en los bits de exponente y mantisa de un binary16 vale x * 2^-8 (también
+        para subnormales), por lo que se corrige multiplicando por 2^8.
+    El estrechamiento convierte a binary16 con redondeo a impar (truncamiento más bit pegajoso
+    si la conversión fue inexacta) y después redondea al par a 8 bits con aritmética entera;
+    binary16 tiene al menos dos bits más de precisión, así que el doble redondeo es exacto.
+*/
+
+// Decodifica 8 códigos E5M2 (64 bits bajos de c) a float
+__attribute__((target("avx2,f16c")))
+static inline __m256 fp8_e5m2_a_float_avx2(__m128i c) {
+    return _mm256_cvtph_ps(_mm_slli_epi16(_mm_cvtepu8_epi16(c), 8));
+}
+
+// Decodifica 8 códigos E4M3 (64 bits bajos de c) a float
+__attribute__((target("avx2,f16c")))
+static inline __m256 fp8_e4m3_a_float_avx2(__m128i c) {
+    __m128i c16 = _mm_cvtepu8_epi16(c);
+    __m128i magnitud = _mm_and_si128(c16, _mm_set1_epi16(0x7F));
+    __m128i h = _mm_or_si128(_mm_slli_epi16(magnitud, 7), _mm_slli_epi16(_mm_and_si128(c16, _mm_set1_epi16(0x80)), 8));
+    // S.1111.111 es NaN en E4M3: se sustituye por un NaN de binary16
+    __m128i es_nan = _mm_cmpeq_epi16(magnitud, _mm_set1_epi16(FP8_E4M3_NAN));
+    h = _mm_blendv_epi8(h, _mm_set1_epi16(0x7E00), es_nan);
+    return _mm256_mul_ps(_mm256_cvtph_ps(h), _mm256_set1_ps(0x1p8f));
+}
+
+// Convierte 8 floats a binary16 con redondeo a impar
+__attribute__((target("avx2,f16c")))
+static inline __m128i fp8_float_a_half_impar_avx2(__m256 v) {
+    __m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256 inexacto = _mm256_cmp_ps(_mm256_cvtph_ps(h), v, _CMP_NEQ_UQ);
+    __m256i inexacto32 = _mm256_castps_si256(inexacto);
+    __m128i inexacto16 = _mm_packs_epi32(_mm256_castsi256_si128(inexacto32), _mm256_extracti128_si256(inexacto32, 1));
+    return _mm_or_si128(h, _mm_and_si128(inexacto16, _mm_set1_epi16(1)));
+}
+
+// Codifica 8 floats a E5M2; el resultado queda en los 64 bits bajos
+__attribute__((target("avx2,f16c")))
+static inline __m128i float_a_fp8_e5m2_avx2(__m256 v) {
+    __m128i h = fp8_float_a_half_impar_avx2(v);
+    __m128i abs = _mm_and_si128(h, _mm_set1_epi16(0x7FFF));
+    __m128i lsb = _mm_and_si128(_mm_srli_epi16(abs, 8), _mm_set1_epi16(1));
+    __m128i codigo = _mm_srli_epi16(_mm_add_epi16(abs, _mm_add_epi16(lsb, _mm_set1_epi16(0x7F))), 8);
+
+    // Los NaN conservan parte de su carga en binary16: se normalizan al mismo código que la versión escalar
+    __m256i nan32 = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+    __m128i es_nan = _mm_packs_epi32(_mm256_castsi256_si128(nan32), _mm256_extracti128_si256(nan32, 1));
+    codigo = _mm_blendv_epi8(codigo, _mm_set1_epi16(FP8_E5M2_NAN), es_nan);
+
+    codigo = _mm_or_si128(codigo, _mm_srli_epi16(_mm_and_si128(h, _mm_set1_epi16((short)0x8000)), 8));
+    return _mm_packus_epi16(codigo, codigo);
+}
+
+// Codifica 8 floats a E4M3 con saturación a ±448; el resultado queda en los 64 bits bajos
+__attribute__((target("avx2,f16c")))
+static inline __m128i float_a_fp8_e4m3_avx2(__m256 v) {
+    __m128i h = fp8_float_a_half_impar_avx2(_mm256_mul_ps(v, _mm256_set1_ps(0x1p-8f)));
+    __m128i abs = _mm_and_si128(h, _mm_set1_epi16(0x7FFF));
+    __m128i lsb = _mm_and_si128(_mm_srli_epi16(abs, 7), _mm_set1_epi16(1));
+    __m128i codigo = _mm_srli_epi16(_mm_add_epi16(abs, _mm_add_epi16(lsb, _mm_set1_epi16(0x3F))), 7);
+    codigo = _mm_min_epu16(codigo, _mm_set1_epi16(FP8_E4M3_MAX_CODIGO));
+
+    __m256i nan32 = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+    __m128i es_nan = _mm_packs_epi32(_mm256_castsi256_si128(nan32), _mm256_extracti128_si256(nan32, 1));
+    codigo = _mm_blendv_epi8(codigo, _mm_set1_epi16(FP8_E4M3_NAN), es_nan);
+
+    codigo = _mm_or_si128(codigo, _mm_srli_epi16(_mm_and_si128(h, _mm_set1_epi16((short)0x8000)), 8));
+    return _mm_packus_epi16(codigo, codigo);
+}
+
+/*
+    Mismas conversiones con AVX-512 (16 elementos): las máscaras de comparación sustituyen a los
+    empaquetados de máscaras de AVX2 y vpmovwb estrecha directamente de 16 a 8 bits.
+*/
+
+// Decodifica 16 códigos E5M2 a float
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m512 fp8_e5m2_a_float_avx512(__m128i c) {
+    return _mm512_cvtph_ps(_mm256_slli_epi16(_mm256_cvtepu8_epi16(c), 8));
+}
+
+// Decodifica 16 códigos E4M3 a float
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m512 fp8_e4m3_a_float_avx512(__m128i c) {
+    __m256i c16 = _mm256_cvtepu8_epi16(c);
+    __m256i magnitud = _mm256_and_si256(c16, _mm256_set1_epi16(0x7F));
+    __m256i h = _mm256_or_si256(_mm256_slli_epi16(magnitud, 7), _mm256_slli_epi16(_mm256_and_si256(c16, _mm256_set1_epi16(0x80)), 8));
+    __mmask16 es_nan = _mm256_cmpeq_epi16_mask(magnitud, _mm256_set1_epi16(FP8_E4M3_NAN));
+    h = _mm256_mask_mov_epi16(h, es_nan, _mm256_set1_epi16(0x7E00));
+    return _mm512_mul_ps(_mm512_cvtph_ps(h), _mm512_set1_ps(0x1p8f));
+}
+
+// Convierte 16 floats a binary16 con redondeo a impar
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m256i fp8_float_a_half_impar_avx512(__m512 v) {
+    __m256i h = _mm512_cvtps_ph(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __mmask16 inexacto = _mm512_cmp_ps_mask(_mm512_cvtph_ps(h), v, _CMP_NEQ_UQ);
+    return _mm256_mask_mov_epi16(h, inexacto, _mm256_or_si256(h, _mm256_set1_epi16(1)));
+}
+
+// Codifica 16 floats a E5M2
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m128i float_a_fp8_e5m2_avx512(__m512 v) {
+    __m256i h = fp8_float_a_half_impar_avx512(v);
+    __m256i abs = _mm256_and_si256(h, _mm256_set1_epi16(0x7FFF));
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi16(abs, 8), _mm256_set1_epi16(1));
+    __m256i codigo = _mm256_srli_epi16(_mm256_add_epi16(abs, _mm256_add_epi16(lsb, _mm256_set1_epi16(0x7F))), 8);
+    codigo = _mm256_mask_mov_epi16(codigo, _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), _mm256_set1_epi16(FP8_E5M2_NAN));
+    codigo = _mm256_or_si256(codigo, _mm256_srli_epi16(_mm256_and_si256(h, _mm256_set1_epi16((short)0x8000)), 8));
+    return _mm256_cvtepi16_epi8(codigo);
+}
+
+// Codifica 16 floats a E4M3 con saturación a ±448
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m128i float_a_fp8_e4m3_avx512(__m512 v) {
+    __m256i h = fp8_float_a_half_impar_avx512(_mm512_mul_ps(v, _mm512_set1_ps(0x1p-8f)));
+    __m256i abs = _mm256_and_si256(h, _mm256_set1_epi16(0x7FFF));
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi16(abs, 7), _mm256_set1_epi16(1));
+    __m256i codigo = _mm256_srli_epi16(_mm256_add_epi16(abs, _mm256_add_epi16(lsb, _mm256_set1_epi16(0x3F))), 7);
+    codigo = _mm256_min_epu16(codigo, _mm256_set1_epi16(FP8_E4M3_MAX_CODIGO));
+    codigo = _mm256_mask_mov_epi16(codigo, _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), _mm256_set1_epi16(FP8_E4M3_NAN));
+    codigo = _mm256_or_si256(codigo, _mm256_srli_epi16(_mm256_and_si256(h, _mm256_set1_epi16((short)0x8000)), 8));
+    return _mm256_cvtepi16_epi8(codigo);
+}
+
+#endif /* __x86_64__ */
+
+#endif /* FP8_H */
@@ -0,0 +1,129 @@
+/*
+ * Utilidades comunes a los benchmarks: lectura y escritura de imágenes en escala de grises
+ * (PGM binario) para medir la calidad con Metricas/Programas/SSIM.py y PSNR.py.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef IMAGEN_H
+#define IMAGEN_H
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+    Los programas que trabajan sobre imágenes (Programas/DCT_2D) leen la entrada de un PGM con
+    --image <ruta> y escriben la original y la reconstruida con --pgm <prefijo>. El formato es
+    el PGM binario de 8 bits (P5, maxval <= 255), que PIL abre directamente, de modo que la
+    calidad se mide con el modo imagen de los scripts de Metricas:
+
+        python3 PSNR.py --image -s prefijo_original.pgm -c prefijo_reconstruida_FP16.pgm
+        python3 SSIM.py --image -s prefijo_original.pgm -c prefijo_reconstruida_FP16.pgm
+
+    Las imágenes en color se convierten antes a gris (p. ej. convert foto.jpg -colorspace Gray foto.pgm).
+*/
+
+/** \brief Código que devuelve getopt_long para --image (fuera del rango de las opciones cortas) */
+#define OPCION_IMAGEN 0x10B
+
+/** \brief Código que devuelve getopt_long para --pgm */
+#define OPCION_PGM 0x10C
+
+// Salta espacios y comentarios (#...) de la cabecera y lee el siguiente entero positivo
+static inline int64_t imagen_leer_campo(FILE *f) {
+    int c = fgetc(f);
+    int64_t valor = 0;
+
+    while (c != EOF && (isspace(c) || c == '#')) {
+        if (c == '#') {
+            while (c != EOF && c != '\n') {
+                c = fgetc(f);
+            }
+        }
+        c = fgetc(f);
+    }
+    if (c == EOF || !isdigit(c)) {
+        return -1;
+    }
+    while (c != EOF && isdigit(c)) {
+        valor = valor * 10 + (c - '0');
+        if (valor > INT32_MAX) {
+            return -1;
+        }
+        c = fgetc(f);
+    }
+    // El separador tras maxval es un único espacio en blanco: lo consume el último fgetc
+    return valor;
+}
+
+/**
+ * \brief Lee un PGM binario de 8 bits.
+ *
+ * \param[in] ruta Fichero P5 con maxval <= 255.
+ * \param[out] alto Filas de la imagen.
+ * \param[out] ancho Columnas de la imagen.
+ * \return uint8_t* Píxeles por filas (liberar con free), o NULL si no se puede leer.
+ */
+static inline uint8_t *imagen_leer_pgm(const char *ruta, int64_t *alto, int64_t *ancho) {
+    FILE *f = fopen(ruta, "rb");
+    uint8_t *pixeles = NULL;
+
+    if (f == NULL) {
+        return NULL;
+    }
+    if (fgetc(f) != 'P' || fgetc(f) != '5') {
+        fclose(f);
+        return NULL;
+    }
+
+    *ancho = imagen_leer_campo(f);
+    *alto = imagen_leer_campo(f);
+    int64_t maximo = imagen_leer_campo(f);
+    if (*ancho <= 0 || *alto <= 0 || maximo <= 0 || maximo > 255) {
+        fclose(f);
+        return NULL;
+    }
+
+    size_t total = (size_t)(*alto) * (size_t)(*ancho);
+    pixeles = (uint8_t *)malloc(total);
+    if (pixeles != NULL && fread(pixeles, 1, total, f) != total) {
+        free(pixeles);
+        pixeles = NULL;
+    }
+    fclose(f);
+    return pixeles;
+}
+
+/**
+ * \brief Escribe un PGM binario de 8 bits.
+ *
+ * \return int 0 si se escribe entero, -1 en caso contrario.
+ */
+static inline int imagen_escribir_pgm(const char *ruta, const uint8_t *pixeles, int64_t alto, int64_t ancho) {
+    FILE *f = fopen(ruta, "wb");
+    size_t total = (size_t)alto * (size_t)ancho;
+    int error;
+
+    if (f == NULL) {
+        return -1;
+    }
+    error = fprintf(f, "P5\n%lld %lld\n255\n", (long long)ancho, (long long)alto) < 0;
+    error |= fwrite(pixeles, 1, total, f) != total;
+    error |= fclose(f) != 0;
+    return error ? -1 : 0;
+}
+
+/** \brief Valor de un píxel: redondeo al entero más cercano y saturación a [0, 255] */
+static inline uint8_t imagen_saturar(float valor) {
+    if (!(valor > 0.0f)) {
+        return 0;
+    }
+    if (valor >= 255.0f) {
+        return 255;
+    }
+    return (uint8_t)(valor + 0.5f);
+}
+
+#endif /* IMAGEN_H */
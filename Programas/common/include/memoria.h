@@ -0,0 +1,219 @@
+/*
+ * Utilidades comunes a los benchmarks: tamaños de 64 bits y reserva de memoria alineada
+ * con páginas grandes.
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/*
+    Modos de reserva de los vectores de los benchmarks (opción -H):
+      - malloc:  posix_memalign alineado a MEMORIA_ALINEAMIENTO bytes, páginas de 4 KiB.
+      - thp:     alineado a la página grande y marcado con madvise(MADV_HUGEPAGE), de modo que
+                 el kernel lo respalda con transparent huge pages si están disponibles.
+      - hugetlb: mmap con MAP_HUGETLB sobre el pool de páginas grandes reservado en
+                 /proc/sys/vm/nr_hugepages. Si el pool no alcanza se recurre a thp.
+    Si madvise falla (THP desactivadas) la memoria se queda con páginas normales. El modo
+    efectivo de la peor reserva se guarda para informar de él junto a los resultados.
+*/
+typedef enum {
+    MEMORIA_MALLOC,
+    MEMORIA_THP,
+    MEMORIA_HUGETLB
+} memoria_modo_t;
+
+/** \brief Alineamiento mínimo de los vectores (una línea de caché / un registro AVX-512) */
+#define MEMORIA_ALINEAMIENTO 64
+
+/** \brief Tamaño de página grande por defecto si /proc/meminfo no lo indica */
+#define MEMORIA_PAGINA_GRANDE_DEFECTO (2L * 1024 * 1024)
+
+/** \brief Número máximo de reservas hugetlb vivas a la vez */
+#define MEMORIA_MAX_MAPEOS 32
+
+static const char *const memoria_nombres[] = {"malloc", "thp", "hugetlb"};
+
+static memoria_modo_t memoria_modo_pedido = MEMORIA_MALLOC;
+static memoria_modo_t memoria_modo_efectivo = MEMORIA_HUGETLB;
+
+// Reservas hechas con mmap, que deben liberarse con munmap y su tamaño
+static struct {
+    void *puntero;
+    size_t bytes;
+} memoria_mapeos[MEMORIA_MAX_MAPEOS];
+
+/**
+ * \brief Interpreta el tamaño de un vector como entero de 64 bits.
+ *
+ * \param[in] texto Argumento de la línea de comandos.
+ * \return int64_t Tamaño leído, o -1 si no es un entero positivo representable.
+ *
+ * Sustituye a atoi, que limita los vectores a 2^31 - 1 elementos y no detecta errores.
+ */
+static inline int64_t leer_tamanho(const char *texto) {
+    char *fin;
+
+    errno = 0;
+    long long valor = strtoll(texto, &fin, 10);
+    if (errno != 0 || fin == texto || *fin != '\0' || valor <= 0) {
+        return -1;
+    }
+    return (int64_t)valor;
+}
+
+/**
+ * \brief Selecciona el modo de reserva a partir de su nombre.
+ *
+ * \param[in] pedido "malloc", "thp" o "hugetlb".
+ * \return int 0 si el modo existe, -1 en caso contrario.
+ */
+static inline int memoria_seleccionar(const char *pedido) {
+    for (int modo = MEMORIA_MALLOC; modo <= MEMORIA_HUGETLB; modo++) {
+        if (strcmp(pedido, memoria_nombres[modo]) == 0) {
+            memoria_modo_pedido = (memoria_modo_t)modo;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/** \brief Nombre del modo pedido con -H */
+static inline const char *memoria_nombre_pedido(void) {
+    return memoria_nombres[memoria_modo_pedido];
+}
+
+/** \brief Nombre del peor modo obtenido en las reservas hechas hasta el momento */
+static inline const char *memoria_nombre_efectivo(void) {
+    memoria_modo_t modo = memoria_modo_efectivo;
+    if (modo > memoria_modo_pedido) {
+        modo = memoria_modo_pedido;
+    }
+    return memoria_nombres[modo];
+}
+
+/** \brief Tamaño de la página grande por defecto leído de /proc/meminfo */
+static inline long memoria_tamanho_pagina_grande(void) {
+    char linea[128];
+    long tamanho = 0;
+
+    FILE *f = fopen("/proc/meminfo", "r");
+    if (f != NULL) {
+        while (fgets(linea, sizeof(linea), f) != NULL) {
+            if (sscanf(linea, "Hugepagesize: %ld kB", &tamanho) == 1) {
+                tamanho *= 1024L;
+                break;
+            }
+        }
+        fclose(f);
+    }
+    return tamanho > 0 ? tamanho : MEMORIA_PAGINA_GRANDE_DEFECTO;
+}
+
+// Anota el modo obtenido por una reserva para memoria_nombre_efectivo
+static inline void memoria_anotar(memoria_modo_t obtenido) {
+    if (obtenido < memoria_modo_efectivo) {
+        memoria_modo_efectivo = obtenido;
+    }
+}
+
+// Reserva con páginas hugetlb explícitas; NULL si el pool no tiene páginas suficientes
+static inline void *memoria_reservar_hugetlb(size_t bytes, long pagina) {
+#ifdef MAP_HUGETLB
+    int libre = -1;
+    for (int i = 0; i < MEMORIA_MAX_MAPEOS; i++) {
+        if (memoria_mapeos[i].puntero == NULL) {
+            libre = i;
+            break;
+        }
+    }
+    if (libre < 0) {
+        return NULL;
+    }
+
+    size_t redondeado = (bytes + (size_t)pagina - 1) / (size_t)pagina * (size_t)pagina;
+    void *p = mmap(NULL, redondeado, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+    memoria_mapeos[libre].puntero = p;
+    memoria_mapeos[libre].bytes = redondeado;
+    return p;
+#else
+    (void)bytes;
+    (void)pagina;
+    return NULL;
+#endif
+}
+
+/**
+ * \brief Reserva un vector de bytes bytes según el modo seleccionado con memoria_seleccionar.
+ *
+ * \param[in] bytes Tamaño del vector en bytes.
+ * \return void* Puntero alineado al menos a MEMORIA_ALINEAMIENTO bytes, o NULL si falla.
+ *
+ * La memoria no se toca: la primera escritura decide en qué nodo NUMA y con qué tamaño de
+ * página se ubica, igual que con malloc. Debe liberarse con memoria_liberar.
+ */
+static inline void *memoria_reservar(size_t bytes) {
+    void *p = NULL;
+
+    if (bytes == 0) {
+        bytes = 1;
+    }
+
+    if (memoria_modo_pedido == MEMORIA_MALLOC) {
+        if (posix_memalign(&p, MEMORIA_ALINEAMIENTO, bytes) != 0) {
+            return NULL;
+        }
+        memoria_anotar(MEMORIA_MALLOC);
+        return p;
+    }
+
+    long pagina = memoria_tamanho_pagina_grande();
+
+    if (memoria_modo_pedido == MEMORIA_HUGETLB) {
+        p = memoria_reservar_hugetlb(bytes, pagina);
+        if (p != NULL) {
+            memoria_anotar(MEMORIA_HUGETLB);
+            return p;
+        }
+    }
+
+    // THP: alineado a la página grande para que el kernel pueda usarlas desde el inicio
+    if (posix_memalign(&p, (size_t)pagina, bytes) != 0) {
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    memoria_anotar(madvise(p, bytes, MADV_HUGEPAGE) == 0 ? MEMORIA_THP : MEMORIA_MALLOC);
+#else
+    memoria_anotar(MEMORIA_MALLOC);
+#endif
+    return p;
+}
+
+/** \brief Libera un vector obtenido con memoria_reservar (admite NULL) */
+static inline void memoria_liberar(void *p) {
+    if (p == NULL) {
+        return;
+    }
+    for (int i = 0; i < MEMORIA_MAX_MAPEOS; i++) {
+        if (memoria_mapeos[i].puntero == p) {
+            munmap(p, memoria_mapeos[i].bytes);
+            memoria_mapeos[i].puntero = NULL;
+            return;
+        }
+    }
+    free(p);
+}
+
+#endif /* MEMORIA_H */
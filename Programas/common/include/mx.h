@@ -0,0 +1,233 @@
+/*
+ * Utilidades comunes a los benchmarks: formatos con escalado por bloques (OCP Microscaling, MX).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef MX_H
+#define MX_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fp8.h"
+
+/*
+    Formatos OCP MX v1.0: cada bloque de MX_BLOQUE elementos comparte una escala E8M0 (un
+    exponente de 8 bits con sesgo 127, valor 2^(e-127), 0xFF es NaN) y cada elemento guarda
+    solo su parte privada:
+      - MXFP8 (E4M3): elementos FP8 E4M3, emax = 8 (448 = 1.75 * 2^8).
+      - MXINT8: enteros de 8 bits en complemento a 2 con escala implícita 2^-6, emax = 0.
+    Escala y elementos se guardan juntos en un bloque de 33 bytes (8.25 bits por elemento),
+    de modo que un vector de n elementos es un array de ceil(n / MX_BLOQUE) bloques y los
+    elementos de relleno del último bloque valen 0.
+*/
+#define MX_BLOQUE 32
+
+/** \brief Código E8M0 reservado para NaN */
+#define MX_ESCALA_NAN 0xFF
+
+/** \brief Exponente del mayor valor normal de los elementos de cada formato */
+#define MXFP8_E4M3_EMAX 8
+#define MXINT8_EMAX     0
+
+/** \brief Magnitud máxima de un elemento MXINT8 (se satura de forma simétrica) */
+#define MXINT8_MAX 127
+
+typedef struct {
+    uint8_t escala;
+    fp8_e4m3_t elementos[MX_BLOQUE];
+} mxfp8_e4m3_t;
+
+typedef struct {
+    uint8_t escala;
+    int8_t elementos[MX_BLOQUE];
+} mxint8_t;
+
+/** \brief Número de bloques necesarios para n elementos */
+static inline int64_t mx_num_bloques(int64_t n) {
+    return (n + MX_BLOQUE - 1) / MX_BLOQUE;
+}
+
+/** \brief Valor 2^(e-127) de una escala E8M0 */
+static inline float mx_escala_a_float(uint8_t e) {
+    uint32_t bits;
+    float f;
+
+    if (e == MX_ESCALA_NAN) {
+        bits = 0x7FC00000u;
+    } else if (e == 0) {
+        return 0x1p-127f;
+    } else {
+        bits = (uint32_t)e << 23;
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/** \brief Inverso 2^(127-e) de una escala E8M0, empleado para cuantizar los elementos */
+static inline float mx_escala_inversa(uint8_t e) {
+    uint32_t bits;
+    float f;
+
+    if (e == MX_ESCALA_NAN) {
+        bits = 0x7FC00000u;
+    } else if (e == 254) {
+        return 0x1p-127f;
+    } else {
+        bits = (uint32_t)(254 - e) << 23;
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * \brief Calcula la escala E8M0 compartida de un bloque.
+ *
+ * \param[in] max_abs Mayor valor absoluto del bloque.
+ * \param[in] emax Exponente del mayor valor normal del formato de los elementos.
+ * \return uint8_t Código E8M0 con exponente floor(log2(max_abs)) - emax.
+ *
+ * Sigue la regla de la especificación OCP MX: el mayor elemento del bloque queda en la
+ * binada más alta del formato y los valores que la superan tras redondear se saturan.
+ */
+static inline uint8_t mx_calcular_escala(float max_abs, int emax) {
+    uint32_t bits;
+    memcpy(&bits, &max_abs, sizeof(bits));
+    int exponente = (int)((bits >> 23) & 0xFFu);
+
+    if (exponente == 0xFF) {
+        return MX_ESCALA_NAN;
+    }
+    int codigo = exponente - emax;
+    if (codigo < 0) codigo = 0;
+    if (codigo > 254) codigo = 254;
+    return (uint8_t)codigo;
+}
+
+/** \brief Redondeo al entero par más cercano para |v| < 2^22 sin depender de libm */
+static inline float mx_redondear_entero(float v) {
+    const float magico = 0x1.8p23f;
+    return (v + magico) - magico;
+}
+
+/** \brief Mayor valor absoluto de los MX_BLOQUE floats de v */
+static inline float mx_maximo_abs(const float *v) {
+    float max_abs = 0.0f;
+    for (int k = 0; k < MX_BLOQUE; k++) {
+        float abs = v[k] < 0.0f ? -v[k] : v[k];
+        if (abs > max_abs) {
+            max_abs = abs;
+        }
+    }
+    return max_abs;
+}
+
+/** \brief Cuantiza MX_BLOQUE floats a un bloque MXFP8 (E4M3) */
+static inline void mxfp8_e4m3_codificar_bloque(const float *v, mxfp8_e4m3_t *bloque) {
+    uint8_t escala = mx_calcular_escala(mx_maximo_abs(v), MXFP8_E4M3_EMAX);
+    float inversa = mx_escala_inversa(escala);
+
+    bloque->escala = escala;
+    for (int k = 0; k < MX_BLOQUE; k++) {
+        bloque->elementos[k] = float_a_fp8_e4m3(v[k] * inversa);
+    }
+}
+
+/** \brief Decodifica un bloque MXFP8 (E4M3) a MX_BLOQUE floats */
+static inline void mxfp8_e4m3_decodificar_bloque(const mxfp8_e4m3_t *bloque, float *v) {
+    float escala = mx_escala_a_float(bloque->escala);
+    for (int k = 0; k < MX_BLOQUE; k++) {
+        v[k] = fp8_e4m3_a_float(bloque->elementos[k]) * escala;
+    }
+}
+
+/** \brief Cuantiza MX_BLOQUE floats a un bloque MXINT8 */
+static inline void mxint8_codificar_bloque(const float *v, mxint8_t *bloque) {
+    uint8_t escala = mx_calcular_escala(mx_maximo_abs(v), MXINT8_EMAX);
+    float inversa = mx_escala_inversa(escala) * 0x1p6f;
+
+    bloque->escala = escala;
+    for (int k = 0; k < MX_BLOQUE; k++) {
+        float q = mx_redondear_entero(v[k] * inversa);
+        if (q > MXINT8_MAX) q = MXINT8_MAX;
+        if (q < -MXINT8_MAX) q = -MXINT8_MAX;
+        bloque->elementos[k] = (int8_t)q;
+    }
+}
+
+/** \brief Decodifica un bloque MXINT8 a MX_BLOQUE floats */
+static inline void mxint8_decodificar_bloque(const mxint8_t *bloque, float *v) {
+    float escala = mx_escala_a_float(bloque->escala) * 0x1p-6f;
+    for (int k = 0; k < MX_BLOQUE; k++) {
+        v[k] = (float)bloque->elementos[k] * escala;
+    }
+}
+
+/** \brief Valor del elemento i de un vector MXFP8 (E4M3) */
+static inline float mxfp8_e4m3_a_float(const mxfp8_e4m3_t *v, int64_t i) {
+    const mxfp8_e4m3_t *bloque = &v[i / MX_BLOQUE];
+    return fp8_e4m3_a_float(bloque->elementos[i % MX_BLOQUE]) * mx_escala_a_float(bloque->escala);
+}
+
+/** \brief Valor del elemento i de un vector MXINT8 */
+static inline float mxint8_a_float(const mxint8_t *v, int64_t i) {
+    const mxint8_t *bloque = &v[i / MX_BLOQUE];
+    return (float)bloque->elementos[i % MX_BLOQUE] * (mx_escala_a_float(bloque->escala) * 0x1p-6f);
+}
+
+#ifdef __x86_64__
+
+// Máximo horizontal de los 8 floats de un registro AVX
+__attribute__((target("avx2")))
+static inline float mx_maximo_avx2(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+// Valor absoluto de 8 floats (borra el bit de signo)
+__attribute__((target("avx2")))
+static inline __m256 mx_abs_avx2(__m256 v) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+}
+
+/*
+    Conversiones vectoriales de los elementos MXINT8: se ensanchan con vpmovsxbd y vcvtdq2ps y
+    se estrechan con vcvtps2dq (redondeo al par, como mx_redondear_entero) y saturación simétrica.
+    La escala que reciben ya incluye el factor implícito 2^-6 (o 2^6 al cuantizar).
+*/
+
+// Decodifica 8 elementos MXINT8 (64 bits bajos de c) a float
+__attribute__((target("avx2")))
+static inline __m256 mxint8_a_float_avx2(__m128i c, __m256 escala) {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(c)), escala);
+}
+
+// Cuantiza 8 floats a elementos MXINT8; el resultado queda en los 64 bits bajos
+__attribute__((target("avx2")))
+static inline __m128i float_a_mxint8_avx2(__m256 v, __m256 inversa) {
+    __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(v, inversa));
+    q = _mm256_min_epi32(_mm256_max_epi32(q, _mm256_set1_epi32(-MXINT8_MAX)), _mm256_set1_epi32(MXINT8_MAX));
+    __m128i q16 = _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1));
+    return _mm_packs_epi16(q16, q16);
+}
+
+// Decodifica 16 elementos MXINT8 a float
+__attribute__((target("avx512f")))
+static inline __m512 mxint8_a_float_avx512(__m128i c, __m512 escala) {
+    return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(c)), escala);
+}
+
+// Cuantiza 16 floats a elementos MXINT8
+__attribute__((target("avx512f")))
+static inline __m128i float_a_mxint8_avx512(__m512 v, __m512 inversa) {
+    __m512i q = _mm512_cvtps_epi32(_mm512_mul_ps(v, inversa));
+    q = _mm512_min_epi32(_mm512_max_epi32(q, _mm512_set1_epi32(-MXINT8_MAX)), _mm512_set1_epi32(MXINT8_MAX));
+    return _mm512_cvtepi32_epi8(q);
+}
+
+#endif /* __x86_64__ */
+
+#endif /* MX_H */
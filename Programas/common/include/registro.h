@@ -0,0 +1,308 @@
+/*
+ * Utilidades comunes a los benchmarks: registro de kernels para el programa unificado
+ * (Programas/BENCH).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <stdint.h>
+
+/*
+    Cada programa, compilado con -DBENCH_REGISTRO, sustituye su main() por un bloque que
+    registra sus kernels con REGISTRO_KERNEL. Programas/BENCH/bench.c enlaza todos esos objetos
+    (cada uno con sus propios flags de compilación) y ejecuta en un único proceso las
+    variantes pedidas con --kernel y --type:
+
+        ./bench --kernel dwt_1d --type fp32,bf16 --n 1048576 --seed 7
+
+    El driver genera los datos una vez por medida en float (con la función generar del
+    programa, que usa la misma secuencia que el main original, ver aleatorio.h), cada variante
+    los convierte a su tipo en preparar, y el resultado de cada variante se compara con el de
+    FP32, de modo que todas las variantes parten de la misma entrada.
+
+    Ciclo de una variante:
+        estado = preparar(n, entrada, memoria);
+        por cada vuelta del cronómetro: restaurar(estado) (si no es la primera) y ejecutar(estado);
+        resultado(estado, salida); liberar(estado);
+
+    Solo ejecutar queda dentro del intervalo medido. flops y elementos dan el trabajo de una
+    llamada con las mismas cuentas que Metricas/Programas/roofline.py (elementos es el tráfico
+    mínimo; los bytes son elementos * bytes_elemento).
+*/
+
+/** \brief Número máximo de kernels registrados en un mismo ejecutable */
+#define REGISTRO_MAX 256
+
+typedef struct {
+    const char *kernel;     // familia, como en el volcado: axpy, blas1, dct, dwt_1d, pca, pca_reimpl
+    const char *medida;     // rutina medida dentro de la familia (p. ej. legall53 o cdf97)
+    const char *tipo;       // sufijo del programa: FP32, FP16, BF16, FP16_ARM, FP8_E4M3, ...
+    double bytes_elemento;  // bytes por elemento almacenado (con las escalas en MX)
+    const char *const *implementacion;  // nombre del kernel elegido con cpuid, o NULL
+
+    int64_t (*elementos_entrada)(int64_t n);    // valores float que genera generar
+    int64_t (*elementos_salida)(int64_t n);     // valores float que devuelve resultado
+    void (*generar)(int64_t n, unsigned int seed, int rand_libc, float *entrada);
+    void *(*preparar)(int64_t n, const float *entrada, const char *memoria);  // NULL si falla
+    void (*restaurar)(void *estado);    // NULL si ejecutar no modifica sus datos de entrada
+    void (*ejecutar)(void *estado);
+    void (*resultado)(void *estado, float *salida);
+    void (*liberar)(void *estado);
+
+    double (*flops)(int64_t n);
+    double (*elementos)(int64_t n);
+} registro_kernel_t;
+
+/** \brief Añade un kernel a la tabla del programa unificado (definida en Programas/BENCH/bench.c) */
+__attribute__((visibility("default"))) void registro_anhadir(const registro_kernel_t *kernel);
+
+/**
+ * \brief Registra un kernel al cargar el ejecutable.
+ *
+ * Los objetos de los programas se compilan con -fvisibility=hidden y sus símbolos se hacen
+ * locales con objcopy --localize-hidden, así que varias variantes pueden definir las mismas
+ * funciones (axpy, dct, ...) sin conflictos al enlazar; solo registro_anhadir queda global.
+ */
+#define REGISTRO_KERNEL(variable) \
+    __attribute__((constructor)) static void registro_##variable(void) { \
+        registro_anhadir(&variable); \
+    }
+
+#ifdef BENCH_REGISTRO
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "memoria.h"
+#include "aleatorio.h"
+
+/*
+    Ayudas para los bloques de registro de los programas. Casi todos los kernels trabajan sobre
+    vectores de n elementos del tipo del programa: el estado común (registro_vectores_t) los
+    reserva con el modo de memoria pedido, convierte a ellos la entrada del driver, guarda copia
+    de los que ejecutar sobrescribe y devuelve en float el vector de salida. Cada programa
+    aporta solo la conversión de su tipo (REGISTRO_TIPO), la forma de sus vectores
+    (registro_forma_t), la selección del kernel en preparar y ejecutar:
+
+        REGISTRO_TIPO(axpy_tipo, _Float16, (_Float16), (float))
+        static const registro_forma_t axpy_forma = {.entradas = 2, .vectores = 2, .salida = 1, .restaurar = 1u << 1};
+
+        static void *axpy_preparar(int64_t n, const float *entrada, const char *memoria) {
+            seleccionar_kernel_axpy("auto");
+            return registro_vectores_crear(n, entrada, memoria, &axpy_tipo, &axpy_forma);
+        }
+
+    Los programas de PCA trabajan sobre su estructura Matrix y usan REGISTRO_MATRIZ.
+*/
+
+/** \brief Número máximo de vectores del estado de un kernel */
+#define REGISTRO_VECTORES_MAX 3
+
+/** \brief Salida de las reducciones (dot, nrm2): un único valor, en registro_vectores_t.escalar */
+#define REGISTRO_ESCALAR (-1)
+
+typedef struct {
+    size_t (*bytes)(int64_t n);     // bytes de un vector de n elementos
+    void (*desde_float)(void *destino, const float *origen, int64_t n);
+    void (*a_float)(float *destino, const void *origen, int64_t n);
+} registro_tipo_t;
+
+/**
+ * \brief Define variable (registro_tipo_t) para vectores de T que se convierten elemento a elemento.
+ *
+ * \param desde_float Conversión de un float a T: un cast, p. ej. (_Float16), o una función.
+ * \param a_float Conversión de un T a float.
+ */
+#define REGISTRO_TIPO(variable, T, desde_float, a_float) \
+    static size_t variable##_bytes(int64_t n) { \
+        return (size_t)n * sizeof(T); \
+    } \
+    static void variable##_desde_float(void *destino, const float *origen, int64_t n) { \
+        for (int64_t i = 0; i < n; i++) { \
+            ((T *)destino)[i] = desde_float(origen[i]); \
+        } \
+    } \
+    static void variable##_a_float(float *destino, const void *origen, int64_t n) { \
+        for (int64_t i = 0; i < n; i++) { \
+            destino[i] = a_float(((const T *)origen)[i]); \
+        } \
+    } \
+    static const registro_tipo_t variable = {variable##_bytes, variable##_desde_float, variable##_a_float};
+
+typedef struct {
+    int entradas;           // vectores que llegan del driver (n valores float por vector, seguidos)
+    int vectores;           // vectores reservados: los de entrada y, tras ellos, los de salida
+    int salida;             // vector que devuelve resultado, o REGISTRO_ESCALAR
+    unsigned restaurar;     // vectores que ejecutar sobrescribe (bit k: vector k)
+} registro_forma_t;
+
+typedef struct {
+    int64_t n;
+    const registro_tipo_t *tipo;
+    const registro_forma_t *forma;
+    void *v[REGISTRO_VECTORES_MAX];         // vectores del kernel en el tipo del programa
+    void *inicial[REGISTRO_VECTORES_MAX];   // copia de los que se restauran, o NULL
+    void *datos;            // datos propios del kernel (plan de la DCT, filtros de la DWT)
+    float escalar;          // resultado de las reducciones
+} registro_vectores_t;
+
+/** \brief Libera los vectores y el estado (no datos, que libera el programa antes) */
+static inline void registro_vectores_liberar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    for (int k = 0; k < REGISTRO_VECTORES_MAX; k++) {
+        memoria_liberar(estado->v[k]);
+        memoria_liberar(estado->inicial[k]);
+    }
+    free(estado);
+}
+
+/**
+ * \brief Reserva los vectores de una variante y les copia la entrada del driver convertida al tipo.
+ *
+ * \return registro_vectores_t* Estado para ejecutar, o NULL si falla la reserva.
+ */
+static inline registro_vectores_t *registro_vectores_crear(int64_t n, const float *entrada, const char *memoria,
+                                                           const registro_tipo_t *tipo, const registro_forma_t *forma) {
+    registro_vectores_t *estado = (registro_vectores_t *)calloc(1, sizeof(registro_vectores_t));
+    size_t bytes = tipo->bytes(n);
+
+    if (estado == NULL) {
+        return NULL;
+    }
+    memoria_seleccionar(memoria);
+    estado->n = n;
+    estado->tipo = tipo;
+    estado->forma = forma;
+
+    for (int k = 0; k < forma->vectores; k++) {
+        if ((estado->v[k] = memoria_reservar(bytes)) == NULL) {
+            registro_vectores_liberar(estado);
+            return NULL;
+        }
+        if (k < forma->entradas) {
+            tipo->desde_float(estado->v[k], entrada + k * n, n);
+        }
+        if (forma->restaurar & (1u << k)) {
+            if ((estado->inicial[k] = memoria_reservar(bytes)) == NULL) {
+                registro_vectores_liberar(estado);
+                return NULL;
+            }
+            memcpy(estado->inicial[k], estado->v[k], bytes);
+        }
+    }
+    return estado;
+}
+
+/** \brief Devuelve a su valor inicial los vectores que ejecutar sobrescribe */
+static inline void registro_vectores_restaurar(void *p) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    for (int k = 0; k < estado->forma->vectores; k++) {
+        if (estado->inicial[k] != NULL) {
+            memcpy(estado->v[k], estado->inicial[k], estado->tipo->bytes(estado->n));
+        }
+    }
+}
+
+/** \brief Copia en float el vector de salida (o el resultado de la reducción) */
+static inline void registro_vectores_resultado(void *p, float *salida) {
+    registro_vectores_t *estado = (registro_vectores_t *)p;
+    if (estado->forma->salida == REGISTRO_ESCALAR) {
+        salida[0] = estado->escalar;
+    } else {
+        estado->tipo->a_float(salida, estado->v[estado->forma->salida], estado->n);
+    }
+}
+
+/*
+    Generadores de la entrada: los mismos valores que los main (u * 10 con la secuencia de
+    aleatorio.h), con los vectores intercalados elemento a elemento como en AXPY y BLAS1.
+*/
+static inline void registro_generar_uno(int64_t n, unsigned int seed, int rand_libc, float *entrada) {
+    aleatorio_iniciar(seed, rand_libc);
+    ALEATORIO_RELLENAR(i, n, u, 1,
+        entrada[i] = u[0] * 10.0f;
+    );
+}
+
+static inline void registro_generar_dos(int64_t n, unsigned int seed, int rand_libc, float *entrada) {
+    aleatorio_iniciar(seed, rand_libc);
+    ALEATORIO_RELLENAR(i, n, u, 2,
+        entrada[i] = u[0] * 10.0f;
+        entrada[n + i] = u[1] * 10.0f;
+    );
+}
+
+// Matriz n x n por filas
+static inline void registro_generar_matriz(int64_t n, unsigned int seed, int rand_libc, float *entrada) {
+    registro_generar_uno(n * n, seed, rand_libc, entrada);
+}
+
+// Valores float que intercambian el driver y la variante (elementos_entrada y elementos_salida)
+static inline int64_t registro_elementos_uno(int64_t n) {
+    (void)n;
+    return 1;
+}
+
+static inline int64_t registro_elementos_n(int64_t n) {
+    return n;
+}
+
+static inline int64_t registro_elementos_dos_n(int64_t n) {
+    return 2 * n;
+}
+
+static inline int64_t registro_elementos_matriz(int64_t n) {
+    return n * n;
+}
+
+/**
+ * \brief Estado y callbacks de un kernel sobre la matriz n x n del programa (PCA, PCA_REIMPL).
+ *
+ * El programa define Matrix (con data[fila][columna]), _create_Matrix, _copy_matrix y
+ * _free_matrix, y el tipo (registro_tipo_t) con que se convierte cada fila. Las matrices se
+ * reservan con malloc como en el main, así que el modo de memoria no se aplica. Se guarda una
+ * copia de la matriz para restaurarla antes de cada vuelta.
+ */
+#define REGISTRO_MATRIZ(tipo) \
+    typedef struct { \
+        int n; \
+        Matrix *matriz; \
+        Matrix *matriz_inicial; \
+    } registro_matriz_t; \
+    static registro_matriz_t *registro_matriz_crear(int64_t n, const float *entrada) { \
+        registro_matriz_t *estado = (registro_matriz_t *)malloc(sizeof(registro_matriz_t)); \
+        if (estado == NULL) { \
+            return NULL; \
+        } \
+        estado->n = (int)n; \
+        estado->matriz = _create_Matrix(estado->n, estado->n); \
+        estado->matriz_inicial = _create_Matrix(estado->n, estado->n); \
+        for (int i = 0; i < estado->n; i++) { \
+            (tipo).desde_float(estado->matriz->data[i], entrada + (int64_t)i * n, n); \
+        } \
+        _copy_matrix(estado->matriz, estado->matriz_inicial); \
+        return estado; \
+    } \
+    static void registro_matriz_restaurar(void *p) { \
+        registro_matriz_t *estado = (registro_matriz_t *)p; \
+        _copy_matrix(estado->matriz_inicial, estado->matriz); \
+    } \
+    static void registro_matriz_resultado(void *p, float *salida) { \
+        registro_matriz_t *estado = (registro_matriz_t *)p; \
+        for (int i = 0; i < estado->n; i++) { \
+            (tipo).a_float(salida + (int64_t)i * estado->n, estado->matriz->data[i], estado->n); \
+        } \
+    } \
+    static void registro_matriz_liberar(void *p) { \
+        registro_matriz_t *estado = (registro_matriz_t *)p; \
+        _free_matrix(estado->matriz); \
+        _free_matrix(estado->matriz_inicial); \
+        free(estado); \
+    }
+
+#endif /* BENCH_REGISTRO */
+
+#endif /* REGISTRO_H */
@@ -0,0 +1,194 @@
+/*
+ * Utilidades comunes a los benchmarks: volcado binario de los datos de entrada y de los
+ * resultados (--dump).
+ *
+ * Licencia MIT (ver ../../../LICENSE)
+ */
+
+#ifndef VOLCADO_H
+#define VOLCADO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Alternativa binaria a la salida de texto de -v: con --dump <ruta> cada bloque "Datos
+    ejecucion" y "Resultados ejecucion" se escribe como una sección del fichero, en el mismo
+    orden, de modo que Metricas/Programas/volcado.py lo puede abrir con mmap sin analizar texto.
+
+    Formato (little-endian, todas las partes alineadas a VOLCADO_ALINEAMIENTO bytes):
+      - Cabecera de 128 bytes:
+          char     magia[8]        "BRPFVOL1"
+          uint32_t version         VOLCADO_VERSION
+          uint32_t num_secciones
+          uint64_t n               tamaño pedido al programa
+          uint32_t seed
+          uint32_t reservado
+          char     tipo[32]        formato de almacenamiento (float32, float16, bfloat16, ...)
+          char     kernel[32]      programa (axpy, blas1, dwt_1d, dct, pca, pca_reimpl)
+          char     implementacion[32]  variante elegida con -k, vacía si el programa no tiene
+      - Por cada sección, una cabecera de 64 bytes:
+          char     nombre[40]      "entrada" o "resultado"
+          uint64_t filas
+          uint64_t columnas
+          uint64_t reservado
+        seguida de filas * columnas valores float32 por filas y de relleno hasta el alineamiento.
+
+    Los valores se guardan en float32 sea cual sea el tipo de almacenamiento: la conversión es
+    exacta para FP16, BF16, FP8 y MX, y así los datos se pueden mapear directamente con numpy.
+*/
+
+#define VOLCADO_VERSION 1
+#define VOLCADO_ALINEAMIENTO 64
+#define VOLCADO_CABECERA 128
+#define VOLCADO_CABECERA_SECCION 64
+
+/** \brief Valores que se acumulan antes de cada fwrite */
+#define VOLCADO_BUFFER 4096
+
+/** \brief Código que devuelve getopt_long para --dump (fuera del rango de las opciones cortas) */
+#define OPCION_VOLCADO 0x101
+
+typedef struct {
+    FILE *f;
+    uint32_t num_secciones;
+    int64_t pendientes;     // valores que faltan por escribir en la sección abierta
+    int64_t escritos;       // valores escritos en la sección abierta
+    int error;
+    int ocupados;
+    float buffer[VOLCADO_BUFFER];
+} volcado_t;
+
+// Escribe bytes en el fichero y anota el error si falla
+static inline void volcado_escribir(volcado_t *v, const void *datos, size_t bytes) {
+    if (bytes > 0 && fwrite(datos, 1, bytes, v->f) != bytes) {
+        v->error = 1;
+    }
+}
+
+// Rellena con ceros hasta el siguiente múltiplo del alineamiento
+static inline void volcado_rellenar(volcado_t *v, size_t escritos) {
+    static const char ceros[VOLCADO_ALINEAMIENTO] = {0};
+    size_t resto = escritos % VOLCADO_ALINEAMIENTO;
+    if (resto != 0) {
+        volcado_escribir(v, ceros, VOLCADO_ALINEAMIENTO - resto);
+    }
+}
+
+// Copia texto en un campo de longitud fija terminado en cero
+static inline void volcado_campo(char *campo, size_t longitud, const char *texto) {
+    memset(campo, 0, longitud);
+    if (texto != NULL) {
+        strncpy(campo, texto, longitud - 1);
+    }
+}
+
+/**
+ * \brief Crea el fichero de volcado y escribe su cabecera.
+ *
+ * \return volcado_t* Volcado abierto, o NULL si no se puede crear el fichero.
+ */
+static inline volcado_t *volcado_abrir(const char *ruta, const char *tipo, const char *kernel, const char *implementacion, int64_t n, unsigned int seed) {
+    unsigned char cabecera[VOLCADO_CABECERA] = {0};
+    uint32_t version = VOLCADO_VERSION;
+    uint64_t n_cabecera = (uint64_t)n;
+    uint32_t seed_cabecera = seed;
+
+    volcado_t *v = (volcado_t *)calloc(1, sizeof(volcado_t));
+    if (v == NULL) {
+        return NULL;
+    }
+    v->f = fopen(ruta, "wb");
+    if (v->f == NULL) {
+        free(v);
+        return NULL;
+    }
+
+    // num_secciones se completa al cerrar
+    memcpy(cabecera, "BRPFVOL1", 8);
+    memcpy(cabecera + 8, &version, 4);
+    memcpy(cabecera + 16, &n_cabecera, 8);
+    memcpy(cabecera + 24, &seed_cabecera, 4);
+    volcado_campo((char *)cabecera + 32, 32, tipo);
+    volcado_campo((char *)cabecera + 64, 32, kernel);
+    volcado_campo((char *)cabecera + 96, 32, implementacion);
+    volcado_escribir(v, cabecera, sizeof(cabecera));
+    return v;
+}
+
+// Escribe los valores acumulados en el buffer
+static inline void volcado_vaciar(volcado_t *v) {
+    volcado_escribir(v, v->buffer, (size_t)v->ocupados * sizeof(float));
+    v->ocupados = 0;
+}
+
+// Cierra la sección abierta: vacía el buffer y rellena hasta el alineamiento
+static inline void volcado_terminar_seccion(volcado_t *v) {
+    volcado_vaciar(v);
+    if (v->pendientes != 0) {
+        v->error = 1;
+    }
+    volcado_rellenar(v, (size_t)v->escritos * sizeof(float));
+    v->pendientes = 0;
+    v->escritos = 0;
+}
+
+/**
+ * \brief Abre una nueva sección de filas x columnas valores, que se escriben con volcado_valor.
+ */
+static inline void volcado_seccion(volcado_t *v, const char *nombre, int64_t filas, int64_t columnas) {
+    unsigned char cabecera[VOLCADO_CABECERA_SECCION] = {0};
+    uint64_t dimensiones[2] = {(uint64_t)filas, (uint64_t)columnas};
+
+    if (v->num_secciones > 0) {
+        volcado_terminar_seccion(v);
+    }
+
+    volcado_campo((char *)cabecera, 40, nombre);
+    memcpy(cabecera + 40, dimensiones, sizeof(dimensiones));
+    volcado_escribir(v, cabecera, sizeof(cabecera));
+
+    v->num_secciones++;
+    v->pendientes = filas * columnas;
+}
+
+/** \brief Añade el siguiente valor de la sección abierta */
+static inline void volcado_valor(volcado_t *v, float valor) {
+    v->buffer[v->ocupados++] = valor;
+    v->pendientes--;
+    v->escritos++;
+    if (v->ocupados == VOLCADO_BUFFER) {
+        volcado_vaciar(v);
+    }
+}
+
+/**
+ * \brief Cierra la última sección, completa la cabecera y libera el volcado (admite NULL).
+ *
+ * \return int 0 si todo se escribió correctamente, -1 en caso contrario.
+ */
+static inline int volcado_cerrar(volcado_t *v) {
+    int resultado;
+
+    if (v == NULL) {
+        return 0;
+    }
+    if (v->num_secciones > 0) {
+        volcado_terminar_seccion(v);
+    }
+    if (fseek(v->f, 12, SEEK_SET) != 0) {
+        v->error = 1;
+    }
+    volcado_escribir(v, &v->num_secciones, sizeof(v->num_secciones));
+    if (fclose(v->f) != 0) {
+        v->error = 1;
+    }
+
+    resultado = v->error ? -1 : 0;
+    free(v);
+    return resultado;
+}
+
+#endif /* VOLCADO_H */
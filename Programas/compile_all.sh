@@ -72,7 +72,7 @@ case "$VENDOR" in
 esac
 
 # Directorios a procesar (se puede expandir fácilmente)
-DIRECTORIOS=("AXPY" "DCT" "DWT_1D" "PCA" "PCA_REIMPL")
+DIRECTORIOS=("AXPY" "BLAS1" "DCT" "DCT_2D" "DWT_1D" "PCA" "PCA_REIMPL" "ROOFLINE" "BENCH")
 
 # Dependiendo de la combinación de arquitectura y proveedor, realizar diferentes acciones
 case "$ARCH" in